@@ -125,6 +125,38 @@ struct Calibration
   Points       points{};            ///< %Calibration point results.
 };
 
+/** @brief  Adaptive calibration point duration.
+
+  Each calibration point ends once gaze has stayed within `dmax_px`
+  dispersion for `stable_ms`, but no sooner than `min_ms` and no later than
+  `max_ms` after the point became active.  A `stable_ms` of `0` disables
+  adaptive timing; each point then lasts `TargetDuration::active_ms`.
+*/
+struct AdaptiveDuration
+{
+  unsigned min_ms;      ///< Minimum active duration in milliseconds.
+  unsigned max_ms;      ///< Maximum active duration in milliseconds.
+  unsigned stable_ms;   ///< Duration in milliseconds of a stable fixation.
+  float    dmax_px;     ///< Maximum dispersion in pixels of a fixation.
+};
+
+/// Active durations of the points of the last calibration.
+struct CalibrationTiming
+{
+  std::vector<unsigned> dwell_ms;   ///< Active duration of each point.
+  unsigned  fixed_ms;   ///< Duration of each point with fixed timing.
+  int       saved_ms;   ///< Total time saved versus fixed timing.
+};
+
+/// Calibration store access times.
+struct StoreTiming
+{
+  unsigned loads;         ///< Number of stored calibrations read.
+  double   load_ms;       ///< Total milliseconds reading and deserializing.
+  unsigned validations;   ///< Number of stored calibrations validated.
+  double   validate_ms;   ///< Total milliseconds checking and parsing.
+};
+
 /// @}
 //---------------------------------------------------------------------------
 
@@ -165,6 +197,33 @@ csv(Calibration const& c);
 
 //---------------------------------------------------------------------------
 
+/// @relates  eye::CalibrationTiming
+/// @{
+
+/** @brief    Insert into output stream.
+
+  ```
+  dwell_ms : 620 540 1000 710
+  fixed_ms : 1000
+  saved_ms : 1130
+  ```
+*/
+std::ostream&
+operator<<(std::ostream& os, CalibrationTiming const& t);
+
+///@}
+
+/// @relates  eye::StoreTiming
+/// @{
+
+/// @brief    Insert into output stream.
+std::ostream&
+operator<<(std::ostream& os, StoreTiming const& t);
+
+///@}
+
+//---------------------------------------------------------------------------
+
 /// @relates  eye::Calibration::Point
 /// @{
 
@@ -172,6 +231,33 @@ csv(Calibration const& c);
 void
 centroid(unsigned& x, unsigned& y, Calibration::Points const& pts);
 
+/** @brief    Return `true` if calibration point @a p should be sampled again.
+
+  Points in state `no_data` or `resample`, and points whose binocular
+  accuracy is rated `recalibrate` or `uncalibrated`, need recalibration.
+*/
+bool
+needs_recalibration(Calibration::Point const& p);
+
+///@}
+
+/// @relates  eye::Calibration
+/// @{
+
+/** @brief    Return targets to recalibrate the points of @a c that need it.
+  @param  [in]  c           Results of the previous calibration.
+  @param  [in]  min_points  Minimum number of targets, padded with good
+                            points.  By default, no good point is added.
+
+  The eye tracker server replaces its calibration with each calibration
+  run, so new samples cannot be merged with previous results.  Instead,
+  this returns the points that need recalibration, followed by the least
+  accurate good points until at least @a min_points are included.
+  Returns an empty container if no point needs recalibration.
+*/
+Targets
+recalibration_targets(Calibration const& c, std::size_t min_points = 0);
+
 ///@}
 
 //---------------------------------------------------------------------------
@@ -31,14 +31,25 @@ SOFTWARE.
 
 #include <eyelib/screen.hpp>  // eye::PointXY
 
+#include <eyelib/gaze/quantile_sketch.hpp>
+#include <eyelib/gaze/rolling_stats.hpp>
+#include <eyelib/gaze/window_stats.hpp>
 #include <eyelib/gaze/metrics.hpp>
+#include <eyelib/gaze/ring.hpp>
 #include <eyelib/gaze/point_cluster.hpp>
 
 // Fixation detection algorithms
 #include <eyelib/gaze/dispersion_threshold.hpp>
+#include <eyelib/gaze/timed_dispersion_threshold.hpp>
 #include <eyelib/gaze/velocity_threshold.hpp>
+#include <eyelib/gaze/event_classifier.hpp>
 
 #include <eyelib/gaze/fixation.hpp>
+#include <eyelib/gaze/areas_of_interest.hpp>
+#include <eyelib/gaze/heatmap.hpp>
+#include <eyelib/gaze/visual_angle.hpp>
+#include <eyelib/gaze/validation.hpp>
+#include <eyelib/gaze/fixation_sweep.hpp>
 
 //#include <utl/json.hpp>     // nlohmann::json
 
@@ -0,0 +1,156 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Fixation metrics of areas of interest.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_AREAS_OF_INTEREST_HPP
+#define EYELIB_AREAS_OF_INTEREST_HPP
+
+#include <eyelib/screen.hpp>  // eye::PointXY
+
+#include <cstddef>    // std::size_t
+#include <vector>     // std::vector
+
+namespace eye {
+
+/// @addtogroup eyelib_gaze
+/// @{
+
+/** @brief  Fixation metrics of circular, rectangular and polygonal areas
+            of interest (AOI), indexed by a uniform grid over the screen.
+
+  Each area has the count, sum duration and interval of fixations that
+  `Fixation` computes for a circle, updated by `gaze()` for all areas at
+  once.  The screen is divided into square cells, and each cell lists the
+  areas whose bounding box overlaps it, so that a gaze sample is tested
+  against the areas of its cell only, and the areas fixated by the last
+  sample.  Points outside the screen are looked up in the nearest cell.
+
+  The grid is built on the first `gaze()` after areas are added.
+
+  Example:
+  ```
+  eye::AreasOfInterest aoi(scr.w_px, scr.h_px);
+  for (auto const& t : targets) { aoi.circle(t.x_px, t.y_px, 56); }
+  …                             // aoi.gaze(g.time_ms, g.avg_px, fix)
+  std::cout << aoi.count(0) << '\n';
+  ```
+*/
+class AreasOfInterest
+{
+public:
+
+  using Id = std::size_t;   ///< Area identifier, in order of addition.
+
+  /**
+  @brief  Construct an empty set of areas.
+  @param  [in]  w_px    Screen width in pixels.
+  @param  [in]  h_px    Screen height in pixels.
+  @param  [in]  cell_px Grid cell size in pixels.
+  */
+  AreasOfInterest(int w_px, int h_px, int cell_px = 64);
+
+  //-----------------------------------------------------------
+  /// @name Areas
+  /// @{
+
+  /// Add a circle of center (@a x, @a y) and radius @a r.
+  Id circle(float x, float y, float r);
+
+  /// Add a rectangle of top left corner (@a x, @a y), width @a w and
+  /// height @a h.
+  Id rectangle(float x, float y, float w, float h);
+
+  /// Add a polygon of @a vertices, of at least three points.
+  Id polygon(std::vector<PointXY<float>> const& vertices);
+
+  /// Returns `true` if point @a pt is within area @a id.
+  bool contains(Id id, PointXY<float> pt) const;
+
+  std::size_t size() const;   ///< Number of areas.
+  void clear();               ///< Remove all areas.
+
+  /// @}
+  //-----------------------------------------------------------
+  /// @name Fixation metrics
+  /// @{
+
+  /// Update all areas with gaze point @a pt, and fixation flag @a fixation.
+  void gaze(unsigned time, PointXY<float> pt, bool fixation);
+
+  std::size_t count(Id id) const;     ///< Count of fixations.
+  std::size_t duration(Id id) const;  ///< Sum duration of fixations.
+  std::size_t interval(Id id) const;  ///< Time between the last fixations.
+  bool is_fixated(Id id) const;       ///< Returns true if area is fixated.
+
+  /// Areas fixated at the last sample, in order of Id.
+  std::vector<Id> const& fixated() const;
+
+  int x(Id id) const;   ///< X coordinate of area center, or of polygon box.
+  int y(Id id) const;   ///< Y coordinate of area center, or of polygon box.
+
+  /// @}
+
+private:
+
+  enum class Shape : unsigned char { circle, rectangle, polygon };
+
+  Id   add(Shape s, float x0, float y0, float x1, float y1);
+  void index();
+  int  cell(float v, int cells) const;
+
+  // Grid
+  int             w_cells_;
+  int             h_cells_;
+  float           cell_px_;
+  std::vector<std::size_t>  cell_start_{};  // First area of each cell
+  std::vector<Id>           cell_ids_{};    // Areas of all cells
+  bool            indexed_{false};
+
+  // Areas
+  std::vector<Shape>  shape_{};
+  std::vector<float>  x0_{}, y0_{}, x1_{}, y1_{};   // Bounding box
+  std::vector<float>  cx_{}, cy_{}, r_sq_{};        // Circle
+  std::vector<std::size_t>    vertex_{};            // First polygon vertex
+  std::vector<PointXY<float>> vertices_{};          // Polygon vertices
+
+  // Fixation metrics, as computed by Fixation
+  std::vector<std::size_t>    count_{};
+  std::vector<std::size_t>    duration_{};
+  std::vector<unsigned>       interval_{};
+  std::vector<unsigned>       last_time_{};
+  std::vector<unsigned char>  fixated_flag_{};
+  std::vector<std::size_t>    stamp_{};     // Last sample within area
+  std::vector<Id>             fixated_{};   // Fixated areas
+  std::size_t                 sample_{0};   // Sample count
+};
+
+/// @}
+
+} // eye
+
+#endif // EYELIB_AREAS_OF_INTEREST_HPP
+//===========================================================================//
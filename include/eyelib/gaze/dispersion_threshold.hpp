@@ -29,7 +29,10 @@ SOFTWARE.
 #ifndef EYE_DISPERSION_THRESHOLD_HPP
 #define EYE_DISPERSION_THRESHOLD_HPP
 
-#include <deque>      // std::deque
+#include <algorithm>    // std::min, std::max
+#include <array>        // std::array
+#include <type_traits>  // std::conditional, std::enable_if
+#include <vector>       // std::vector
 
 namespace eye {
 
@@ -65,17 +68,44 @@ namespace eye {
   and the current point is added to a new detection window.  Then points
   must be collected to fill the window with `pts` points before checking
   for a new fixation.
+
+  The window of `N` points is a ring of coordinate arrays, allocated once.
+  During a fixation, only the extents and sums of the cluster are kept,
+  and updated per point.  For `N` greater than `0`, the window size is
+  fixed at compile time, so that the dispersion scan may be unrolled.
+  For `N` equal to `0`, the window size `pts` is given at run time; see
+  `DispersionThreshold`.
 */
-class DispersionThreshold
+template<unsigned N>
+class DispersionThresholdN
 {
 public:  //-----------------------------------------------------------
 
   /**
-  @brief  Construct a fixation detection object.
+  @brief  Construct a fixation detection object with a window of `N`
+          points.
+  @param  [in]  dmax  Maximum dispersion of fixation points.
+  */
+  template<unsigned M = N, typename std::enable_if<M != 0, int>::type = 0>
+  explicit
+  DispersionThresholdN(float dmax)
+  : pt_min_(N)
+  , d_max_(dmax)
+  {}
+
+  /**
+  @brief  Construct a fixation detection object with a window of @a pts
+          points.  Requires `N` equal to `0`.
   @param  [in]  pts   Number of points in the moving window.
   @param  [in]  dmax  Maximum dispersion of fixation points.
   */
-  DispersionThreshold(unsigned pts, float dmax);
+  template<unsigned M = N, typename std::enable_if<M == 0, int>::type = 0>
+  DispersionThresholdN(unsigned pts, float dmax)
+  : pt_min_(pts ? pts : 1)  // Neither 0 nor 1 point can detect a fixation
+  , d_max_(dmax)
+  , x_(pt_min_, 0.0f)
+  , y_(pt_min_, 0.0f)
+  {}
 
   /**
   @brief  Add a gaze point.
@@ -104,20 +134,192 @@ public:  //-----------------------------------------------------------
   float
   dispersion() const;
 
+  /// Returns number of points in the moving window.
+  unsigned
+  points() const;
+
+  /// Remove all points.
+  void
+  clear();
+
 private:  //-----------------------------------------------------------
 
+  // Coordinates: fixed size array, or vector sized on construction
+  using buffer = typename std::conditional<N == 0, std::vector<float>,
+                                           std::array<float, N ? N : 1>>::type;
+
   unsigned  pt_min_;        // Minimum number of points in a fixation group
   float     d_max_;         // Maximum dispersion of fixation group points
   float     d_{0};          // Dispersion of points
   bool      is_fix_{false}; // True if group of points is a fixation
 
-  // Double-ended queues
-  std::deque<float> x_{};   // x coordinates
-  std::deque<float> y_{};   // y coordinates
+  // Moving window, a ring of points
+  buffer    x_{};           // x coordinates
+  buffer    y_{};           // y coordinates
+  unsigned  head_{0};       // Oldest point
+  unsigned  size_{0};       // Number of points
+
+  // Fixation cluster
+  unsigned  n_{0};          // Number of points
+  float     x_min_{0}, x_max_{0}, y_min_{0}, y_max_{0};   // Extents
+  double    sum_x_{0}, sum_y_{0};                         // Sums
 };
 
+/**
+  @brief  Dispersion threshold (DT) fixation detection algorithm, with a
+          window of `pts` points given at run time.
+
+  Construct with `DispersionThreshold(pts, dmax)`.
+*/
+using DispersionThreshold = DispersionThresholdN<0>;
+
 /// @}
 
+//---------------------------------------------------------------------------
+
+template<unsigned N>
+inline bool
+DispersionThresholdN<N>::fixation(float x, float y)
+{
+  unsigned const pts = points();  // Constant for N > 0
+
+  // During a fixation, points are only added to the group, so its
+  // dispersion is that of its extents with the current point added
+  if (is_fix_)
+  {
+    float x_min = std::min(x_min_, x);
+    float x_max = std::max(x_max_, x);
+    float y_min = std::min(y_min_, y);
+    float y_max = std::max(y_max_, y);
+    d_ = ((x_max - x_min) + (y_max - y_min));
+
+    if ((d_ > 0) && (d_ <= d_max_))
+    {
+      x_min_ = x_min;
+      x_max_ = x_max;
+      y_min_ = y_min;
+      y_max_ = y_max;
+      sum_x_ += x;
+      sum_y_ += y;
+      ++n_;
+      return true;  // Continue adding points until threshold is exceeded
+    }
+
+    // Dispersion threshold was exceeded: clear all the points and
+    // start a new window with only the current point
+    is_fix_ = false;
+    x_[0]   = x;
+    y_[0]   = y;
+    head_   = 0;
+    size_   = 1;
+    return false;
+  }
+
+  // Add the current point
+  unsigned tail = head_ + size_;
+  if (tail >= pts) { tail -= pts; }
+  x_[tail] = x;
+  y_[tail] = y;
+  ++size_;
+
+  // The duration threshold is implemented as a
+  // minimum number of points within a cluster
+  if (size_ < pts)
+  {
+    d_ = 0;
+    return false;   // Continue adding points until the minimum is reached
+  }
+
+  // Compute dispersion of the points; the window is full,
+  // so the order of points within the ring is irrelevant
+  float x_min = x_[0], x_max = x_[0];
+  float y_min = y_[0], y_max = y_[0];
+  for (unsigned i = 1; i < pts; ++i)
+  {
+    x_min = std::min(x_min, x_[i]);
+    x_max = std::max(x_max, x_[i]);
+    y_min = std::min(y_min, y_[i]);
+    y_max = std::max(y_max, y_[i]);
+  }
+  d_ = ((x_max - x_min) + (y_max - y_min));
+
+  // If points are within dispersion threshold `max_px`,
+  // they are considered to represent a fixation; reject
+  // a value of zero, as it indicates invalid coordinates
+  if ((d_ > 0) && (d_ <= d_max_))
+  {
+    is_fix_ = true;
+    n_      = pts;
+    x_min_  = x_min;
+    x_max_  = x_max;
+    y_min_  = y_min;
+    y_max_  = y_max;
+
+    // Sum from the oldest point, in the order points were added
+    sum_x_  = 0.0;
+    sum_y_  = 0.0;
+    for (unsigned i = 0, j = head_; i < pts; ++i)
+    {
+      sum_x_ += x_[j];
+      sum_y_ += y_[j];
+      if (++j == pts) { j = 0; }
+    }
+    return true;    // Continue adding points until threshold is exceeded
+  }
+
+  // If a fixation has not been detected, remove the first
+  // point to move the window before adding the next point
+  if (++head_ == pts) { head_ = 0; }
+  --size_;
+  return false;
+}
+
+template<unsigned N>
+inline void
+DispersionThresholdN<N>::centroid(double& x, double& y, unsigned& n) const
+{
+  if (is_fix_)
+  {
+    // Number of points in fixation cluster
+    n = n_;
+
+    // Compute centroid of cluster points
+    x = sum_x_ / n_;
+    y = sum_y_ / n_;
+  }
+}
+
+template<unsigned N>
+inline float
+DispersionThresholdN<N>::dispersion() const
+{
+  return d_;
+}
+
+template<unsigned N>
+inline unsigned
+DispersionThresholdN<N>::points() const
+{
+  return N ? N : pt_min_;
+}
+
+template<unsigned N>
+inline void
+DispersionThresholdN<N>::clear()
+{
+  d_      = 0;
+  is_fix_ = false;
+  head_   = 0;
+  size_   = 0;
+  n_      = 0;
+}
+
+//---------------------------------------------------------------------------
+
+/// @cond
+extern template class DispersionThresholdN<0>;
+/// @endcond
+
 } // eye
 
 #endif // EYE_DISPERSION_THRESHOLD_HPP
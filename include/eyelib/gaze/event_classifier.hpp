@@ -0,0 +1,185 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Gaze event classification.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_EVENT_CLASSIFIER_HPP
+#define EYELIB_EVENT_CLASSIFIER_HPP
+
+#include <array>      // std::array
+#include <ostream>    // std::ostream
+#include <string>     // std::string
+#include <vector>     // std::vector
+
+namespace eye {
+
+struct Gaze;
+
+/// @addtogroup eyelib_gaze
+/// @{
+
+/// Gaze event of a sample.
+enum class GazeEvent : unsigned char
+{
+  fixation,   ///< Within dispersion threshold of a fixation cluster.
+  saccade,    ///< Tracking eyes, but not within a fixation.
+  blink,      ///< Tracking user, but not both eyes.
+  gap         ///< No gaze coordinates.
+};
+
+/// @relates  eye::GazeEvent
+/// Convert to string.
+std::string
+to_string(GazeEvent e);
+
+/// @relates  eye::GazeEvent
+/// Insert into output stream.
+std::ostream&
+operator<<(std::ostream& os, GazeEvent e);
+
+//---------------------------------------------------------------------------
+
+/** @brief  Single-pass fixation, saccade, blink and gap classification.
+
+  Each sample is read once.  The tracking state is checked once for both
+  streams, then the displacement from the previous point and the
+  dispersion of the point window are computed for the raw and smoothed
+  gaze points.  Each stream keeps its own state, so that the raw and
+  smoothed signals are never mixed.
+
+  The dispersion threshold (DT) and velocity threshold (VT) results are
+  those of `DispersionThreshold` and `VelocityThreshold` given the same
+  points.  Each stream has a DT window, a fixed ring of `pts` points, and
+  fixation extents and centroid updated per point.  The dispersion of a
+  full window is at least the distance along each axis between its newest
+  and oldest points, so the window is only scanned if that is within
+  `dmax`; from a saccade until a new fixation fills the window, most
+  windows are skipped.  The VT needs only the last point, so it is kept
+  inline.
+
+  A sample with the user present, but not both eyes, is a blink; a sample
+  otherwise without gaze coordinates is a gap.  Either ends any
+  fixation, and restarts both detectors of each stream.  Otherwise the
+  sample is a fixation if the DT detects one, and a saccade if not.
+
+  Example:
+  ```
+  eye::EventClassifier events(10, 72.0, 10.0);
+  …
+  events.update(g);
+  if (events.event(eye::EventClassifier::avg) == eye::GazeEvent::fixation)
+  …
+  ```
+*/
+class EventClassifier
+{
+public:
+
+  /// %Gaze point stream.
+  enum Stream : unsigned
+  {
+    raw = 0,  ///< Raw gaze point.
+    avg = 1   ///< Smoothed gaze point.
+  };
+
+  /// Classification of the last sample of a stream.
+  struct Sample
+  {
+    GazeEvent event;            ///< %Gaze event.
+    bool      dt;               ///< Dispersion threshold fixation.
+    bool      vt;               ///< Velocity threshold fixation.
+    float     dispersion;       ///< Dispersion of the point window, or
+                                ///< infinity if known to exceed `dmax`.
+    float     displacement_sq;  ///< Displacement squared from last point.
+  };
+
+  /**
+  @brief  Construct an event classifier.
+  @param  [in]  pts   Number of points in the dispersion window (min 2).
+  @param  [in]  dmax  Maximum dispersion of fixation points.
+  @param  [in]  vmax  Maximum displacement between fixation points.
+  */
+  EventClassifier(unsigned pts, float dmax, float vmax);
+
+  /// Classify gaze sample @a g.
+  void update(Gaze const& g);
+
+  Sample const& sample(Stream s) const;   ///< Last sample of stream @a s.
+  GazeEvent     event(Stream s) const;    ///< Last event of stream @a s.
+
+  /**
+  @brief  Returns the current DT fixation point of stream @a s, and the
+          number of gaze points within the fixation cluster.
+
+  Outputs are unchanged if the last point was not within a fixation.
+  */
+  void centroid(Stream s, double& x, double& y, unsigned& n) const;
+
+  void clear();   ///< Restart both streams.
+
+private:
+
+  // Detector state of one stream
+  struct State
+  {
+    explicit State(unsigned pts);
+
+    Sample              sample;
+
+    // DT window, a ring of points
+    std::vector<float>  x, y;
+    unsigned            head;   // Oldest point
+    unsigned            size;   // Number of points
+
+    // DT fixation cluster
+    bool      is_fix;
+    unsigned  n;
+    float     x_min, x_max, y_min, y_max;
+    double    sum_x, sum_y;
+
+    // VT last point
+    bool      has_last;
+    float     last_x, last_y;
+  };
+
+  void restart(State& s, GazeEvent e) const;
+  void classify(State& s, float x, float y) const;
+  bool velocity(State& s, float x, float y) const;
+  bool dispersion(State& s, float x, float y) const;
+
+  unsigned  pts_;
+  float     d_max_;
+  float     d_sq_max_;
+
+  std::array<State,2>  state_;
+};
+
+/// @}
+
+} // eye
+
+#endif // EYELIB_EVENT_CLASSIFIER_HPP
+//===========================================================================//
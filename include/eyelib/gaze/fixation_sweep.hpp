@@ -0,0 +1,188 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Fixation detection parameter sweep.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_FIXATION_SWEEP_HPP
+#define EYELIB_FIXATION_SWEEP_HPP
+
+#include <eyelib/screen.hpp>  // eye::Target, eye::Targets
+
+#include <cstddef>    // std::size_t
+#include <ostream>    // std::ostream
+#include <vector>     // std::vector
+
+namespace eye {
+
+struct Gaze;
+
+/// @addtogroup eyelib_gaze
+/// @{
+
+/** @brief  Evaluate many DT and VT settings in one pass over a session.
+
+  Gaze samples and the displayed target are recorded with `add()`, then
+  `run()` evaluates each configuration of a grid of dispersion threshold
+  (DT) and velocity threshold (VT) settings over the whole session.  Each
+  configuration detects the same fixations as a `DispersionThreshold` or
+  `VelocityThreshold` fed the smoothed gaze points, skipping points with a
+  zero coordinate.
+
+  Work shared by all configurations is done once per sample: the extents
+  of the last `pts` points for each DT window size, the displacement from
+  the last point, and the targets within the fixation radius.  Detector
+  state is then held per configuration in contiguous arrays, and updated
+  for all configurations of a chunk per sample.  Chunks of a large grid
+  run in separate threads.
+
+  Results are the agreement with the eye tracker fixation flag, the count
+  and mean duration of fixations, and the `Fixation` metrics of each
+  target while a target is active.
+
+  Example:
+  ```
+  eye::FixationSweep sweep(targets);
+  …                                 // sweep.add(g, t) for each sample
+  sweep.dispersion({4, 6, 10}, {30, 45, 72});
+  sweep.velocity({5, 7, 10});
+  std::cout << sweep.run() << '\n';
+  ```
+*/
+class FixationSweep
+{
+public:
+
+  /// Fixation detection algorithm.
+  enum class Method : unsigned char
+  {
+    dt,   ///< Dispersion threshold.
+    vt    ///< Velocity threshold.
+  };
+
+  /// Detector configuration.
+  struct Config
+  {
+    Method    method;   ///< Algorithm.
+    unsigned  pts;      ///< DT number of points in window, `0` for VT.
+    float     dmax;     ///< DT maximum dispersion, or VT displacement.
+  };
+
+  /// Fixation on one target, as computed by `Fixation`.
+  struct TargetMetrics
+  {
+    std::size_t count;        ///< Count of fixations.
+    std::size_t duration_ms;  ///< Sum duration of fixations.
+    std::size_t interval_ms;  ///< Time between the last two fixations.
+  };
+
+  /// Results of one configuration.
+  struct Result
+  {
+    Config      config;       ///< Configuration.
+    float       agreement;    ///< Fraction of samples agreeing with the
+                              ///< eye tracker fixation flag.
+    std::size_t fixations;    ///< Count of fixations.
+    float       duration_ms;  ///< Mean fixation duration.
+    std::vector<TargetMetrics> targets;   ///< Fixation on each target.
+  };
+
+  using Configs = std::vector<Config>;  ///< Configuration container.
+  using Results = std::vector<Result>;  ///< Result container.
+
+  /**
+  @brief  Construct a parameter sweep.
+  @param  [in]  targets   Targets for fixation metrics.
+  @param  [in]  radius    Fixation radius of targets in pixels.
+  */
+  explicit
+  FixationSweep(Targets const& targets, int radius = 56);
+
+  /// Record gaze sample @a g, with displayed target @a t.
+  void add(Gaze const& g, Target const& t);
+
+  /// Add DT configurations for each of @a pts with each of @a dmax.
+  void dispersion(std::vector<unsigned> const& pts,
+                  std::vector<float> const& dmax);
+
+  /// Add VT configurations for each of @a dmax.
+  void velocity(std::vector<float> const& dmax);
+
+  /**
+  @brief  Evaluate all configurations over the recorded session.
+  @param  [in]  threads   Maximum threads, or `0` for hardware concurrency.
+  @return Results in configuration order.
+  */
+  Results run(unsigned threads = 0) const;
+
+  Configs const& configs() const;   ///< Configurations.
+  std::size_t size() const;         ///< Number of recorded samples.
+  void clear();                     ///< Remove samples and configurations.
+
+private:
+
+  // Per-sample values shared by all configurations
+  struct Shared;
+
+  void sweep(Shared const& sh, std::size_t begin, std::size_t end,
+             Result* out) const;
+
+  Targets   targets_;
+  float     radius_sq_;
+  Configs   configs_{};
+
+  // Recorded session
+  std::vector<unsigned>       time_ms_{};
+  std::vector<float>          x_{};       // Smoothed gaze point
+  std::vector<float>          y_{};
+  std::vector<unsigned char>  fix_{};     // Eye tracker fixation flag
+  std::vector<unsigned char>  active_{};  // Target active
+};
+
+/// @name     Non-member function overloads
+/// @relates  eye::FixationSweep
+/// @{
+
+/** @brief    Insert into output stream, one configuration per line.
+
+  ```
+  method  pts    dmax  agreement  fixations  duration
+                                             (ms)
+  -------------------------------------------------------
+  DT        4    30.0     0.8123        121     251.6
+  …
+  ```
+*/
+std::ostream&
+operator<<(std::ostream& os, FixationSweep::Results const& r);
+
+/// @}
+
+/// @}
+
+} // eye
+
+#endif // EYELIB_FIXATION_SWEEP_HPP
+//===========================================================================//
@@ -0,0 +1,143 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Eye gaze heatmap.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_HEATMAP_HPP
+#define EYELIB_HEATMAP_HPP
+
+#include <cstddef>    // std::size_t
+#include <istream>    // std::istream
+#include <vector>     // std::vector
+
+namespace eye {
+
+/// @addtogroup eyelib_gaze
+/// @{
+
+/** @brief  Accumulated gaze density over the screen.
+
+  The screen is divided into square cells.  Each gaze point adds a
+  Gaussian splat, normalized to a total of one, centered on the cell
+  containing the point.  The splat is the product of a precomputed
+  horizontal and vertical kernel, so each row of the splat is a scaled
+  copy of one kernel.
+
+  If a half-life is given, the heatmap decays exponentially with gaze
+  time.  Rather than scaling every cell, decay scales a single factor
+  applied when cells are read, and points are added divided by that
+  factor.  Cells are rescaled only when the factor becomes very small.
+
+  Example:
+  ```
+  eye::Heatmap heatmap(1920, 1080);           // 8 pixel cells, no decay
+  heatmap.add(g.avg_px.x, g.avg_px.y, g.time_ms);
+
+  std::vector<unsigned char> rgba(heatmap.cols() * heatmap.rows() * 4);
+  heatmap.colorize(rgba.data());              // One RGBA pixel per cell
+  ```
+*/
+class Heatmap
+{
+public:
+
+  /**
+  @brief  Construct an empty heatmap.
+  @param  [in]  w_px          Screen width in pixels.
+  @param  [in]  h_px          Screen height in pixels.
+  @param  [in]  cell_px       Cell width and height in pixels.
+  @param  [in]  sigma_px      Splat standard deviation in pixels.
+  @param  [in]  half_life_ms  Decay half-life, or `0` for no decay.
+  */
+  Heatmap(unsigned w_px, unsigned h_px, unsigned cell_px = 8,
+          float sigma_px = 24.0f, unsigned half_life_ms = 0);
+
+  /// @brief  Decay to @a time_ms, then add gaze point (@a x_px, @a y_px).
+  ///
+  /// Points that are not finite are ignored.
+  void add(float x_px, float y_px, unsigned time_ms);
+
+  /// Decay to gaze time @a time_ms without adding a point.  Times older
+  /// than the last decay are ignored.
+  void decay(unsigned time_ms);
+
+  void clear();               ///< Remove all points.
+
+  unsigned    cols() const;     ///< Number of cell columns.
+  unsigned    rows() const;     ///< Number of cell rows.
+  unsigned    cell_px() const;  ///< Cell width and height in pixels.
+  std::size_t count() const;    ///< Number of points added.
+
+  /// Value of cell at @a col, @a row.
+  float value(unsigned col, unsigned row) const;
+
+  /// Maximum cell value.
+  float max() const;
+
+  /// @brief  Map cell values, relative to the maximum, to colors.
+  ///
+  /// Writes `cols() * rows()` RGBA pixels, row by row, to @a rgba.
+  /// Colors range from transparent blue for low values to opaque red for
+  /// the maximum; empty cells are fully transparent.
+  void colorize(unsigned char* rgba) const;
+
+private:
+  void renormalize();     // Apply scale factor to cells
+
+  unsigned            cols_;
+  unsigned            rows_;
+  unsigned            cell_px_;
+  unsigned            half_life_ms_;
+  int                 radius_;        // Kernel radius in cells
+  std::vector<float>  kernel_{};      // 1D kernel, 2 * radius_ + 1 values
+  std::vector<float>  cells_{};       // Values divided by scale_
+  float               max_{0.0f};     // Maximum of cells_
+  double              scale_{1.0};    // Decay factor
+  unsigned            time_ms_{0};    // Gaze time of last decay
+  bool                timed_{false};  // true if time_ms_ is set
+  std::size_t         count_{0};
+};
+
+//---------------------------------------------------------------------------
+
+/**
+  @brief  Add gaze points from a gaze data log to @a heatmap.
+  @param  [in]  is        CSV input, as written by the datalog application.
+  @param  [in]  heatmap   Heatmap to add points to.
+  @return Number of points added.
+
+  Lines before the `csv_header<Gaze>()` line are skipped.  The smoothed
+  gaze point of each sample with gaze tracking is added at its time.
+*/
+std::size_t
+add_log(std::istream& is, Heatmap& heatmap);
+
+/// @}
+
+} // eye
+
+#endif // EYELIB_HEATMAP_HPP
+//===========================================================================//
@@ -31,7 +31,11 @@ SOFTWARE.
 
 #include <eyelib/screen.hpp>  // eye::PointXY
 
-#include <utl/math.hpp>     // utl::math::sample_window
+#include <eyelib/gaze/quantile_sketch.hpp>  // eye::QuantileSketch
+#include <eyelib/gaze/rolling_stats.hpp>    // eye::RollingStats
+#include <eyelib/gaze/window_stats.hpp>     // eye::WindowStats
+
+#include <cmath>      // std::sqrt
 
 namespace eye {
 
@@ -46,10 +50,10 @@ class TimeMetrics
 public:
 
   /// Duration sample window: max, min, mean, sum.
-  using duration_values = utl::math::sample_window<unsigned, DurationWindow>;
+  using duration_values = WindowStats<unsigned, DurationWindow>;
 
   /// Interval sample window: max, min, mean, sum.
-  using interval_values = utl::math::sample_window<unsigned, IntervalWindow>;
+  using interval_values = WindowStats<unsigned, IntervalWindow>;
 
   /// Return a const reference to duration sample window.
   duration_values const&
@@ -65,10 +69,33 @@ public:
     return interval_;
   }
 
+  /// Return a const reference to quantiles of all durations.
+  QuantileSketch const&
+  duration_quantiles() const
+  {
+    return duration_q_;
+  }
+
+  /// Return a const reference to quantiles of all intervals.
+  QuantileSketch const&
+  interval_quantiles() const
+  {
+    return interval_q_;
+  }
+
+  /// Return a const reference to durations over 1 s to 10 min windows;
+  /// the rate of events is the `rate()` of their durations.
+  RollingStats const&
+  duration_rolling() const
+  {
+    return duration_r_;
+  }
+
   /// Update time metrics.
   void
   update(unsigned time, bool is_active)
   {
+    duration_r_.update(time);
     if (is_active)
     {
       // New duration
@@ -77,6 +104,7 @@ public:
         if (start_time_ != 0)
         {
           interval_.push(time - start_time_);   // Duration since last event
+          interval_q_.add(float(time - start_time_));
         }
         start_time_ = time;     // Start of new duration
         started_    = true;
@@ -86,6 +114,8 @@ public:
     else if (started_)
     {
       duration_.push(time - start_time_);   // Duration of event
+      duration_q_.add(float(time - start_time_));
+      duration_r_.add(time, float(time - start_time_));
       started_ = false;
     }
   }
@@ -93,6 +123,9 @@ public:
 private:
   duration_values   duration_{};      // Event time duration
   interval_values   interval_{};      // Duration between events
+  QuantileSketch    duration_q_{};    // Event time duration, all events
+  QuantileSketch    interval_q_{};    // Duration between events, all events
+  RollingStats      duration_r_{};    // Event time duration, 1 s to 10 min
   unsigned          start_time_{0};   // Timestamp current duration started
   bool              started_{false};  // True if recording duration
 };
@@ -100,9 +133,12 @@ private:
 /**
   @brief Blink time metrics.
 
-  Maximum, minimum, mean, and sum total of:
+  Maximum, minimum, mean, and sum total over the sample window, and
+  quantiles over all events, of:
   - Blink time duration.
   - Interval between blinks.
+
+  Rate and duration of blinks over 1 s, 10 s, 60 s and 10 min windows.
 */
 template <std::size_t DurationWindow, std::size_t IntervalWindow>
 using BlinkTime = TimeMetrics<DurationWindow, IntervalWindow>;
@@ -110,9 +146,12 @@ using BlinkTime = TimeMetrics<DurationWindow, IntervalWindow>;
 /**
   @brief Fixation time metrics.
 
-  Maximum, minimum, mean, and sum total of:
+  Maximum, minimum, mean, and sum total over the sample window, and
+  quantiles over all events, of:
   - Fixation time duration.
   - Interval between fixations.
+
+  Rate and duration of fixations over 1 s, 10 s, 60 s and 10 min windows.
 */
 template <std::size_t DurationWindow, std::size_t IntervalWindow>
 using FixationTime = TimeMetrics<DurationWindow, IntervalWindow>;
@@ -126,7 +165,7 @@ class SaccadeDistance
 public:
 
   /// Distance samples: max, min, mean, sum.
-  using distance_values = utl::math::sample_window<unsigned, SampleWindow>;
+  using distance_values = WindowStats<unsigned, SampleWindow>;
 
   /// Return a const reference to distance sample window.
   distance_values const&
@@ -135,6 +174,14 @@ public:
     return distance_sq_;
   }
 
+  /// Return a const reference to quantiles of all saccade amplitudes
+  /// (distance in pixels).
+  QuantileSketch const&
+  amplitude_quantiles() const
+  {
+    return amplitude_q_;
+  }
+
   /// Update saccade distance.
   void
   update(PointXY<float> pt, bool is_active)
@@ -150,6 +197,7 @@ public:
         auto dy   = (pt.y - start_pt_.y);
         auto d_sq = ((dx * dx) + (dy * dy));
         distance_sq_.push(static_cast<unsigned>(d_sq));
+        amplitude_q_.add(std::sqrt(d_sq));
       }
     }
     // Start new saccade
@@ -162,6 +210,7 @@ public:
 
 private:
   distance_values   distance_sq_{};
+  QuantileSketch    amplitude_q_{};   // Saccade amplitude, all saccades
   PointXY<float>    start_pt_{0.0,0.0};
   bool              started_{false};  // True if recording saccade
 };
@@ -175,7 +224,7 @@ class Pupillometry
 public:
 
   /// Pupil size samples: max, min, mean, sum.
-  using size_values = utl::math::sample_window<float, SampleWindow>;
+  using size_values = WindowStats<float, SampleWindow>;
 
   /// Return a const reference to pupil size sample window.
   size_values const&
@@ -184,15 +233,42 @@ public:
     return pupil_size_;
   }
 
+  /// Return a const reference to quantiles of all pupil sizes.
+  QuantileSketch const&
+  pupil_size_quantiles() const
+  {
+    return pupil_size_q_;
+  }
+
+  /// Return a const reference to pupil sizes over 1 s to 10 min windows,
+  /// if updated with sample times.
+  RollingStats const&
+  pupil_size_rolling() const
+  {
+    return pupil_size_r_;
+  }
+
   /// Update pupillometry sample window.
   void
   update(float left_size, float right_size)
   {
-    pupil_size_.push((left_size + right_size) / 2); // Average pupil size
+    float size = (left_size + right_size) / 2;  // Average pupil size
+    pupil_size_.push(size);
+    pupil_size_q_.add(size);
+  }
+
+  /// Update pupillometry sample window, and windows of time @a time.
+  void
+  update(unsigned time, float left_size, float right_size)
+  {
+    update(left_size, right_size);
+    pupil_size_r_.add(time, (left_size + right_size) / 2);
   }
 
 private:
-  size_values   pupil_size_{};
+  size_values     pupil_size_{};
+  QuantileSketch  pupil_size_q_{};    // Pupil size, all samples
+  RollingStats    pupil_size_r_{};    // Pupil size, 1 s to 10 min
 };
 
 //---------------------------------------------------------------------------
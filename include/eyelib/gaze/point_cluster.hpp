@@ -29,21 +29,36 @@ SOFTWARE.
 #ifndef EYELIB_POINT_CLUSTER_HPP
 #define EYELIB_POINT_CLUSTER_HPP
 
-#include <deque>      // std::deque
+#include <eyelib/gaze/ring.hpp>  // eye::Ring
+
+#include <cstddef>    // std::size_t
 
 namespace eye {
 
 /// @addtogroup eyelib_gaze
 /// @{
 
-/// @brief    Group of gaze point coordinates
-/// @ingroup  eyelib_gaze
+/** @brief    Group of gaze point coordinates
+    @ingroup  eyelib_gaze
+
+  Points are held in rings of timestamps and coordinates, allocated on
+  construction, so that adding and removing points is O(1) and never
+  allocates.  When full, adding a point removes the first point.
+  Coordinate sums are updated as points are added and removed, so that
+  the mean coordinates are O(1).
+*/
 class PointCluster
 {
 public:
+  /// Construct a cluster of at most @a capacity points, rounded up to a
+  /// power of two.
+  explicit
+  PointCluster(std::size_t capacity = 1024);
+
   void      clear();          ///< Clear content.
   unsigned  duration() const; ///< Time duration between first and last point.
   bool      empty() const;    ///< Return `true` if no points.
+  bool      full() const;     ///< Return `true` if at capacity.
 
   float     mean_x() const;   ///< Return mean average x coordinate.
   float     mean_y() const;   ///< Return mean average y coordinate.
@@ -53,13 +68,24 @@ public:
 
   std::size_t size() const;   ///< Return number of points.
 
-  void  start(unsigned t);    ///< Start time.
+  /// Clear content, and set the start time of the duration.
+  void  start(unsigned t);
+
+  unsigned  time(std::size_t i) const;  ///< Time of point @a i from first.
+  float     x(std::size_t i) const;     ///< x coordinate of point @a i.
+  float     y(std::size_t i) const;     ///< y coordinate of point @a i.
 
 private:
-  // Double-ended queues
-  std::deque<unsigned>  t_{};   // Timestamps
-  std::deque<float>     x_{};   // x coordinates
-  std::deque<float>     y_{};   // y coordinates
+  // Rings of points
+  Ring<unsigned>  t_;           // Timestamps
+  Ring<float>     x_;           // x coordinates
+  Ring<float>     y_;           // y coordinates
+
+  double    sum_x_{0};          // Sum of x coordinates
+  double    sum_y_{0};          // Sum of y coordinates
+
+  unsigned  start_{0};          // Start time, if set
+  bool      has_start_{false};  // Duration is from start time
 };
 
 /// @}
@@ -0,0 +1,155 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Streaming quantile sketch.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_QUANTILE_SKETCH_HPP
+#define EYELIB_QUANTILE_SKETCH_HPP
+
+#include <cstddef>    // std::size_t
+#include <cstdint>    // std::uint32_t, std::uint64_t
+#include <istream>    // std::istream
+#include <ostream>    // std::ostream
+#include <utility>    // std::pair
+#include <vector>     // std::vector
+
+namespace eye {
+
+/// @addtogroup eyelib_gaze
+/// @{
+
+/** @brief  Approximate quantiles of a stream of values, in bounded memory.
+
+  A KLL sketch: values are added to a level of weight 1.  When the values
+  retained exceed the capacity of the sketch, a full level is sorted, and
+  every other value, starting at a random offset, is moved to the next
+  level of twice the weight; the rest are discarded.  The capacity of each
+  level is `k` for the top level, decreasing by 2/3 per level below, so
+  that the sketch retains about `3k` values however many are added.
+
+  The rank error of a quantile is about `1.7 / k`: at the default `k` of
+  200, a median within 1% of the true rank.  The minimum and maximum are
+  exact.
+
+  Sketches of the same `k` merge by adding their levels, so that sketches
+  of separate sessions or threads can be combined into one, with the
+  error of a sketch of all their values.  A sketch is written as text of
+  its levels, a few kilobytes, to be read and merged in a later session.
+
+  quantile() sorts the retained values on the first call after a change,
+  and keeps them sorted for later calls: like the changing members, it
+  must not be called from several threads at once.
+
+  Example:
+  ```
+  eye::QuantileSketch durations;
+  …                                   // durations.add(ms) per fixation
+  float p50 = durations.median();
+  float p90 = durations.quantile(0.9);
+  ```
+*/
+class QuantileSketch
+{
+public:
+
+  /**
+  @brief  Construct an empty sketch.
+  @param  [in]  k   Capacity of the top level; accuracy increases, and
+                    memory with it, linearly with `k`.
+  */
+  explicit
+  QuantileSketch(unsigned k = 200);
+
+  /// Add value @a v.
+  void add(float v);
+
+  /**
+  @brief  Add the values of sketch @a other, which may be this sketch.
+  @return `false`, with this sketch unchanged, if the `k` of @a other
+          differs from this sketch.
+  */
+  bool merge(QuantileSketch const& other);
+
+  /**
+  @brief  Returns the approximate value at quantile @a q.
+  @param  [in]  q   Quantile, between `0` (minimum) and `1` (maximum).
+  @return Value at quantile @a q, or `0` if empty.
+  */
+  float quantile(double q) const;
+
+  float median() const;             ///< Value at quantile 0.5.
+  float min() const;                ///< Minimum value, or `0` if empty.
+  float max() const;                ///< Maximum value, or `0` if empty.
+
+  std::uint64_t count() const;      ///< Number of values added.
+  std::size_t size() const;         ///< Number of values retained.
+  bool empty() const;               ///< No values added.
+  void clear();                     ///< Remove all values.
+
+  /**
+  @brief  Write the sketch as text: a line of `k`, the count, the minimum
+          and maximum, and a line of the values of each level.
+  @param  [in]  os  Output stream; its format is unchanged.
+  */
+  void write(std::ostream& os) const;
+
+  /**
+  @brief  Read a sketch as written by write(), replacing this sketch.
+  @param  [in]  is  Input stream.
+  @return `false`, with this sketch unchanged, if the input is not a
+          valid sketch.
+  */
+  bool read(std::istream& is);
+
+private:
+
+  std::size_t capacity(std::size_t level) const;
+  void add_level();
+  void compress();
+  void compact(std::size_t level);
+
+  using Level   = std::vector<float>;
+  using Weighed = std::pair<float, std::uint64_t>;
+
+  unsigned            k_;             // Capacity of the top level
+  std::vector<Level>  levels_;        // Values of weight 2^level
+  std::size_t         size_{0};       // Values retained
+  std::size_t         capacity_{0};   // Sum of level capacities
+  std::uint64_t       count_{0};      // Values added
+  float               min_{0};        // Minimum value
+  float               max_{0};        // Maximum value
+  std::uint32_t       random_{1};     // Compaction offset generator
+
+  mutable std::vector<Weighed> sorted_{};   // Values and cumulative weights
+  mutable bool        is_sorted_{false};    // Values are sorted
+};
+
+/// @}
+
+} // eye
+
+#endif // EYELIB_QUANTILE_SKETCH_HPP
+//===========================================================================//
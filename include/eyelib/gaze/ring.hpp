@@ -0,0 +1,117 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Fixed capacity ring buffer.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_RING_HPP
+#define EYELIB_RING_HPP
+
+#include <cstddef>    // std::size_t
+#include <vector>     // std::vector
+
+namespace eye {
+
+/// @addtogroup eyelib_gaze
+/// @{
+
+/** @brief  Ring buffer of fixed capacity, a first-in first-out queue
+            which may also be removed from the back.
+
+  Elements are held in one contiguous array, allocated on construction
+  with a capacity rounded up to a power of two, so that the position of
+  an element is a mask of the index rather than a division.  Adding and
+  removing elements at either end is O(1), and never allocates.  When
+  the ring is full, adding an element removes the first.
+
+  For a structure of arrays, rings of the same capacity are kept in step,
+  as does `PointCluster` with timestamps and coordinates.
+*/
+template<typename T>
+class Ring
+{
+public:
+
+  /// Construct a ring for at least @a capacity elements.
+  explicit
+  Ring(std::size_t capacity)
+  : v_(round_up(capacity))
+  , mask_(v_.size() - 1)
+  {}
+
+  /// Add @a value at the end, removing the first element if full.
+  void
+  push_back(T const& value)
+  {
+    v_[(head_ + size_) & mask_] = value;
+    if (size_ == v_.size()) { head_ = (head_ + 1) & mask_; }
+    else                    { ++size_; }
+  }
+
+  /// Remove the first element.  The ring must not be empty.
+  void pop_front()  { head_ = (head_ + 1) & mask_; --size_; }
+
+  /// Remove the last element.  The ring must not be empty.
+  void pop_back()   { --size_; }
+
+  /// Remove all elements.
+  void clear()      { head_ = 0; size_ = 0; }
+
+  /// Element @a i from the first.
+  T&        operator[](std::size_t i)       { return v_[(head_ + i) & mask_]; }
+  T const&  operator[](std::size_t i) const { return v_[(head_ + i) & mask_]; }
+
+  T&        front()         { return v_[head_]; }   ///< First element.
+  T const&  front() const   { return v_[head_]; }   ///< First element.
+  T&        back()          { return (*this)[size_ - 1]; }  ///< Last element.
+  T const&  back() const    { return (*this)[size_ - 1]; }  ///< Last element.
+
+  std::size_t capacity() const  { return v_.size(); }   ///< Maximum size.
+  std::size_t size() const      { return size_; }       ///< Number of elements.
+  bool        empty() const     { return size_ == 0; }  ///< No elements.
+  bool        full() const      { return size_ == v_.size(); } ///< At capacity.
+
+private:
+
+  static std::size_t
+  round_up(std::size_t n)
+  {
+    std::size_t p = 1;
+    while (p < n) { p <<= 1; }
+    return p;
+  }
+
+  std::vector<T>  v_;         // Elements
+  std::size_t     mask_;      // Capacity - 1
+  std::size_t     head_{0};   // First element
+  std::size_t     size_{0};   // Number of elements
+};
+
+/// @}
+
+} // eye
+
+#endif // EYELIB_RING_HPP
+//===========================================================================//
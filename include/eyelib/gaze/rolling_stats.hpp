@@ -0,0 +1,148 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Rolling statistics over several time windows.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_ROLLING_STATS_HPP
+#define EYELIB_ROLLING_STATS_HPP
+
+#include <array>      // std::array
+#include <cstddef>    // std::size_t
+#include <vector>     // std::vector
+
+namespace eye {
+
+/// @addtogroup eyelib_gaze
+/// @{
+
+/** @brief  Statistics of timestamped values over the last second, 10
+            seconds, minute and 10 minutes, in one pass.
+
+  Values are summarized in time buckets: count, sum, minimum and maximum.
+  Each window is a ring of buckets, and each bucket of a window is one
+  whole window of the next finer resolution:
+
+  window    | bucket  | buckets
+  --------- | ------- | -------
+  1 s       | 100 ms  | 10
+  10 s      | 1 s     | 10
+  60 s      | 10 s    | 6
+  10 min    | 60 s    | 10
+
+  A value is added to the open 100 ms bucket only.  When a bucket closes,
+  it is merged into the open bucket of the next coarser window, and the
+  summary of the closed buckets of its window is updated.  The statistics
+  of a window are then its closed buckets, with the open buckets of it
+  and every finer window, so reading them is O(1).
+
+  A window spans its open bucket and the closed buckets before it, so
+  that its time span is up to one bucket less than the full window, and
+  `rate()` is computed over the time actually spanned.  A time without a
+  value, to close buckets, may be given by `update()`.
+*/
+class RollingStats
+{
+public:
+
+  /// Time window.
+  enum Window : unsigned
+  {
+    s1,       ///< 1 second.
+    s10,      ///< 10 seconds.
+    s60,      ///< 60 seconds.
+    min10     ///< 10 minutes.
+  };
+
+  /// Statistics of a time window.
+  struct Stats
+  {
+    std::size_t count;    ///< Number of values.
+    double      sum;      ///< Sum of values.
+    float       min;      ///< Minimum value, or `0` if none.
+    float       max;      ///< Maximum value, or `0` if none.
+    unsigned    span_ms;  ///< Time spanned by the window.
+
+    float mean() const;   ///< Mean of values, or `0` if none.
+    float rate() const;   ///< Values per minute, or `0` if no time spanned.
+  };
+
+  /// Construct empty statistics.
+  RollingStats();
+
+  /// Add value @a v at time @a time_ms.
+  void add(unsigned time_ms, float v);
+
+  /// Move time to @a time_ms, without a value.
+  void update(unsigned time_ms);
+
+  /// Statistics of window @a w.
+  Stats stats(Window w) const;
+
+  /// Remove all values.
+  void clear();
+
+private:
+
+  static constexpr std::size_t levels = 4;
+
+  // Values summarized over a time bucket or buckets
+  struct Summary
+  {
+    std::size_t count;
+    double      sum;
+    float       min;
+    float       max;
+
+    void add(float v);
+    void merge(Summary const& s);
+  };
+
+  // Ring of closed buckets, and the open bucket, of a window
+  struct Level
+  {
+    unsigned              bucket_ms;  // Bucket duration
+    std::vector<Summary>  closed;     // Closed buckets, one less than window
+    std::size_t           head;       // Oldest closed bucket
+    std::size_t           size;       // Number of closed buckets
+    Summary               summary;    // Summary of closed buckets
+    Summary               open;       // Open bucket
+    unsigned              start_ms;   // Start of open bucket
+  };
+
+  void advance(unsigned time_ms);
+  void close(std::size_t level);
+
+  std::array<Level, levels> level_;
+  unsigned  time_ms_{0};          // Last time
+  bool      started_{false};      // Time has been set
+};
+
+/// @}
+
+} // eye
+
+#endif // EYELIB_ROLLING_STATS_HPP
+//===========================================================================//
@@ -0,0 +1,156 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Dispersion threshold fixation detection over a time window.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYE_TIMED_DISPERSION_THRESHOLD_HPP
+#define EYE_TIMED_DISPERSION_THRESHOLD_HPP
+
+#include <eyelib/gaze/point_cluster.hpp>  // eye::PointCluster
+#include <eyelib/gaze/ring.hpp>           // eye::Ring
+
+#include <cstddef>    // std::size_t
+
+namespace eye {
+
+/// @addtogroup eyelib_gaze
+/// @{
+
+/** @brief  Dispersion threshold (DT) fixation detection algorithm, with
+            a minimum fixation duration in milliseconds.
+
+  Unlike `DispersionThreshold`, which counts points on the assumption of
+  a constant sampling rate, the moving window holds the fewest recent
+  points spanning `duration_ms` by their timestamps.  Dropped frames and
+  sampling jitter thus do not change the minimum duration of a fixation.
+
+  The `fixation` method accepts timestamped eye gaze points until the
+  window spans the minimum duration, then compares the dispersion of the
+  window points with the maximum dispersion `dmax`.  If it is within the
+  threshold, a fixation is detected, and subsequent points within the
+  threshold are added to the fixation cluster.  If not, the oldest points
+  are removed as newer points extend the window.  Upon a point exceeding
+  the threshold during a fixation, a new window is started with the
+  current point.  A timestamp earlier than the last point also starts a
+  new window.
+
+  The window is a `PointCluster`, and the window extents are kept by
+  monotonic queues, so that the work per point is O(1) amortized.  During
+  a fixation, only the extents and sums of the cluster are kept.  The
+  window and queues are rings allocated on construction, for at most
+  `max_pts` points; `max_pts` must be at least the number of points
+  sampled over `duration_ms`.
+*/
+class TimedDispersionThreshold
+{
+public:  //-----------------------------------------------------------
+
+  /**
+  @brief  Construct a fixation detection object.
+  @param  [in]  duration_ms   Minimum duration of fixation points.
+  @param  [in]  dmax          Maximum dispersion of fixation points.
+  @param  [in]  max_pts       Maximum number of points in the window.
+  */
+  TimedDispersionThreshold(unsigned duration_ms, float dmax,
+                           std::size_t max_pts = 512);
+
+  /**
+  @brief  Add a gaze point.
+  @param  [in]  t   %Gaze point time in milliseconds (`Gaze::time_ms`).
+  @param  [in]  x   %Gaze point X coordinate.
+  @param  [in]  y   %Gaze point Y coordinate.
+  @return `true` if a fixation is detected, `false` otherwise.
+  */
+  bool
+  fixation(unsigned t, float x, float y);
+
+  /**
+  @brief  Returns the current fixation point, and the
+          number of gaze points within the fixation cluster.
+  @param  [out] x   Horizontal coordinate.
+  @param  [out] y   Vertical coordinate.
+  @param  [out] n   Number of points in the fixation cluster, or `0` if
+                    the last point has not been identified with a fixation.
+
+  The fixation point is computed as the centroid
+  of the gaze points within the fixation cluster.
+  */
+  void
+  centroid(double& x, double& y, unsigned& n) const;
+
+  /// Returns dispersion of points within the moving window.
+  float
+  dispersion() const;
+
+  /// Returns duration of points within the moving window, or of the
+  /// fixation cluster.
+  unsigned
+  duration() const;
+
+  /// Remove all points.
+  void
+  clear();
+
+private:  //-----------------------------------------------------------
+
+  // Window point index and coordinate, for monotonic extent queues
+  struct Extent
+  {
+    std::size_t index;
+    float       value;
+  };
+  using Extents = Ring<Extent>;
+
+  void push(unsigned t, float x, float y);
+  void push(Extents& q, float v, bool is_min);
+  void pop_front();
+
+  unsigned      duration_ms_;   // Minimum duration of a fixation group
+  float         d_max_;         // Maximum dispersion of fixation group points
+  float         d_{0};          // Dispersion of points
+  bool          is_fix_{false}; // True if group of points is a fixation
+
+  // Moving window
+  PointCluster  points_;        // Points
+  std::size_t   first_{0};      // Index of the first point since restart
+  std::size_t   next_{0};       // Index of the next point since restart
+
+  // Window extents, as increasing minimum and decreasing maximum queues
+  Extents       x_min_, x_max_, y_min_, y_max_;
+
+  // Fixation cluster
+  unsigned      n_{0};          // Number of points
+  unsigned      t0_{0}, t1_{0}; // First and last timestamps
+  float         fx_min_{0}, fx_max_{0}, fy_min_{0}, fy_max_{0};  // Extents
+  double        sum_x_{0}, sum_y_{0};                           // Sums
+};
+
+/// @}
+
+} // eye
+
+#endif // EYE_TIMED_DISPERSION_THRESHOLD_HPP
+//===========================================================================//
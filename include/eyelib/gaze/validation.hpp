@@ -0,0 +1,175 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Eye tracker validation.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_VALIDATION_HPP
+#define EYELIB_VALIDATION_HPP
+
+#include <eyelib/screen.hpp>              // eye::Screen, eye::Target
+#include <eyelib/gaze/visual_angle.hpp>   // eye::VisualAngle
+
+#include <cstddef>    // std::size_t
+#include <ostream>    // std::ostream
+#include <vector>     // std::vector
+
+namespace eye {
+
+struct Gaze;
+
+/// @addtogroup eyelib_gaze
+/// @{
+
+/** @brief  Accuracy, precision and data loss of gaze at known targets.
+
+  Gaze samples are collected for one target at a time, between `begin()`
+  and `end()`, from live data or a replay of logged samples.  Samples
+  received within a settling time of the first, or earlier than the
+  first, are skipped, to exclude the saccade to the target.  Horizontal
+  and vertical offsets from the target are converted to visual angle with
+  `VisualAngle`, which accounts for the position of the target on the
+  screen, and stored contiguously.  On `end()`, loops over the offsets
+  with independent partial sums, which the compiler can vectorize,
+  compute:
+
+  - Accuracy: mean angular offset from the target.
+  - Precision: root mean square of sample-to-sample distances (RMS-S2S),
+    and standard deviation of sample positions (SD).
+  - Data loss: fraction of samples without gaze data.
+
+  Angles are computed for a viewing distance given at construction.
+  Distances combine the horizontal and vertical angles as if orthogonal,
+  which is accurate for offsets of a few degrees.
+
+  Example:
+  ```
+  eye::Validation v(scr);
+  for (auto const& t : targets)
+  {
+    v.begin(t);
+    …                       // v.add(g) for each gaze sample
+    v.end();
+  }
+  std::cout << v.results() << '\n';
+  ```
+*/
+class Validation
+{
+public:
+
+  /// Results at one target.
+  struct Result
+  {
+    Target      target;         ///< %Target.
+    std::size_t samples;        ///< Samples with gaze data.
+    std::size_t lost;           ///< Samples without gaze data.
+    float       accuracy_deg;   ///< Mean offset from target in degrees.
+    float       rms_s2s_deg;    ///< RMS sample-to-sample distance in degrees.
+    float       sd_deg;         ///< Standard deviation in degrees.
+    float       data_loss;      ///< Fraction of samples lost.
+  };
+
+  using Results = std::vector<Result>;  ///< Result container.
+
+  /**
+  @brief  Construct a validation engine.
+  @param  [in]  scr         Screen parameters, including physical size.
+  @param  [in]  distance_m  Viewing distance in meters.
+  @param  [in]  settle_ms   Time skipped after the first sample of a target.
+  */
+  explicit
+  Validation(Screen const& scr, float distance_m = 0.6f,
+             unsigned settle_ms = 200);
+
+  /// Start collecting samples at target @a t.  Discards unfinished samples.
+  void begin(Target const& t);
+
+  /// @brief  Add a gaze sample.  Ignored unless collecting.
+  ///
+  /// The raw gaze point is used, since smoothing would hide imprecision.
+  void add(Gaze const& g);
+
+  /// @brief  Add a gaze sample at (@a x_px, @a y_px) and @a time_ms.
+  /// @param  [in]  valid   `false` if the sample has no gaze data.
+  void add(float x_px, float y_px, unsigned time_ms, bool valid);
+
+  /// @brief  Finish the current target and compute its results.
+  /// @return `false` if not collecting.
+  bool end();
+
+  bool collecting() const;          ///< `true` between `begin()` and `end()`.
+  Results const& results() const;   ///< Results of finished targets.
+  void clear();                     ///< Remove all results.
+
+private:
+  VisualAngle angle_;
+  unsigned    settle_ms_;
+
+  Target              target_{0, 0, false};
+  PointXY<float>      target_deg_{0, 0};  // Angles of the target
+  bool                collecting_{false};
+  bool                started_{false};  // First sample received
+  unsigned            start_ms_{0};     // Time of first sample
+  std::size_t         lost_{0};
+  std::vector<float>  x_deg_{};         // Horizontal offsets in degrees
+  std::vector<float>  y_deg_{};         // Vertical offsets in degrees
+  Results             results_{};
+};
+
+/// @name     Non-member function overloads
+/// @relates  eye::Validation
+/// @{
+
+/// Return the mean of results over all targets.
+Validation::Result
+mean(Validation::Results const& r);
+
+/// Insert into output stream.
+std::ostream&
+operator<<(std::ostream& os, Validation::Result const& r);
+
+/** @brief    Insert into output stream, one target per line, then the mean.
+
+  ```
+       target      samples  lost    accuracy  rms_s2s   sd
+       (pixel)                      (degree)  (degree)  (degree)
+       ---------------------------------------------------------
+    0: 0192,0108       24     1      0.4213    0.0931    0.1502
+    …
+  mean                             …
+  ```
+*/
+std::ostream&
+operator<<(std::ostream& os, Validation::Results const& r);
+
+/// @}
+
+/// @}
+
+} // eye
+
+#endif // EYELIB_VALIDATION_HPP
+//===========================================================================//
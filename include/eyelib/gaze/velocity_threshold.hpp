@@ -29,8 +29,6 @@ SOFTWARE.
 #ifndef EYE_VELOCITY_THRESHOLD_HPP
 #define EYE_VELOCITY_THRESHOLD_HPP
 
-#include <vector>     // std::vector
-
 namespace eye {
 
 /// @addtogroup eyelib_gaze
@@ -89,8 +87,11 @@ private:  //-----------------------------------------------------------
   float d_sq_{0};         // Displacement squared of fixation points
   bool  is_fix_{false};   // True if group of points is a fixation
 
-  std::vector<float> x_{};    // x coordinates
-  std::vector<float> y_{};    // y coordinates
+  // Fixation cluster, as the last point and sums of coordinates
+  unsigned  n_{0};            // Number of points
+  float     x_{0}, y_{0};     // Last point
+  double    sum_x_{0};        // Sum of x coordinates
+  double    sum_y_{0};        // Sum of y coordinates
 };
 
 /// @}
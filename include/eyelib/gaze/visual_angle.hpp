@@ -0,0 +1,183 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Pixel to visual angle conversion, and angular velocity.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_VISUAL_ANGLE_HPP
+#define EYELIB_VISUAL_ANGLE_HPP
+
+#include <eyelib/screen.hpp>  // eye::Screen, eye::PointXY
+
+#include <vector>     // std::vector
+
+namespace eye {
+
+struct Gaze;
+
+/// @addtogroup eyelib_gaze
+/// @{
+
+/** @brief  Convert screen pixels to visual angle in degrees.
+
+  The eye is assumed to face the screen center at a viewing distance
+  given at construction.  The horizontal and vertical angle of each pixel,
+  `atan(offset / distance)`, is computed once per axis using the physical
+  screen size, for the screen and a margin of half its size on each side.
+  Coordinates are converted by interpolation between table entries,
+  without per-sample trigonometry, so that thresholds of the fixation
+  detection algorithms can be given in degrees, independent of screen and
+  viewing distance.  Coordinates beyond the margin are extrapolated.
+
+  The angular distance between two points is the angle between the
+  directions from the eye, computed from the chord between unit vectors
+  and a series for `asin`, accurate for the distances between samples.
+
+  Angles are zero if the physical screen size is unknown.
+
+  Example:
+  ```
+  eye::VisualAngle va(scr, 0.6f);
+  eye::VelocityThreshold vt{0.5f};    // degrees
+  auto p = va.degrees(g.avg_px);
+  bool fix = vt.fixation(p.x, p.y);
+  ```
+*/
+class VisualAngle
+{
+public:
+
+  /**
+  @brief  Construct conversion tables.
+  @param  [in]  scr         Screen parameters, including physical size.
+  @param  [in]  distance_m  Viewing distance in meters.
+  */
+  explicit
+  VisualAngle(Screen const& scr, float distance_m = 0.6f);
+
+  /// Unit vector from the eye towards a point.
+  struct Direction
+  {
+    float x;    ///< Horizontal component.
+    float y;    ///< Vertical component.
+    float z;    ///< Component towards the screen.
+  };
+
+  float degrees_x(float x_px) const;  ///< Horizontal angle from center.
+  float degrees_y(float y_px) const;  ///< Vertical angle from center.
+
+  /// Horizontal and vertical angle of point @a pt from the screen center.
+  PointXY<float> degrees(PointXY<float> pt) const;
+
+  /// Direction from the eye towards point @a pt.
+  Direction direction(PointXY<float> pt) const;
+
+  /// Angle in degrees between directions @a a and @a b.
+  static float angle(Direction const& a, Direction const& b);
+
+  /// Angular distance in degrees between points @a a and @a b.
+  float distance(PointXY<float> a, PointXY<float> b) const;
+
+  /// Horizontal size in pixels at the screen center of @a deg degrees.
+  float pixels(float deg) const;
+
+  float distance_m() const;   ///< Viewing distance in meters.
+
+private:
+
+  // Interpolate table t, starting at coordinate v0, at coordinate v
+  static float lookup(std::vector<float> const& t, float v0, float v);
+
+  float               distance_m_;
+  float               m_per_px_x_;
+  float               m_per_px_y_;
+  float               x_center_;    // Screen center in pixels
+  float               y_center_;
+  float               x0_;          // Coordinate of first table entry
+  float               y0_;
+  std::vector<float>  x_deg_;       // Angle of each pixel, with margins
+  std::vector<float>  y_deg_;
+};
+
+/** @brief  Angular velocity of gaze in degrees per second.
+
+  A gaze pipeline stage that converts each sample to visual angle with
+  `VisualAngle`, and returns the angular distance from the previous valid
+  sample divided by the time between them.  Samples without gaze data
+  restart the stage, as do samples earlier than the previous sample, and
+  the first valid sample after a restart has a velocity of zero.
+
+  Example:
+  ```
+  eye::AngularVelocity av(scr);
+  …                                 // for each gaze sample g
+  bool saccade = av.update(g) > 30.0f;
+  ```
+*/
+class AngularVelocity
+{
+public:
+
+  /**
+  @brief  Construct an angular velocity stage.
+  @param  [in]  scr         Screen parameters, including physical size.
+  @param  [in]  distance_m  Viewing distance in meters.
+  */
+  explicit
+  AngularVelocity(Screen const& scr, float distance_m = 0.6f);
+
+  /// @brief  Add a gaze sample, and return its angular velocity.
+  ///
+  /// The smoothed gaze point is used.
+  float update(Gaze const& g);
+
+  /// @brief  Add a gaze sample at (@a x_px, @a y_px) and @a time_ms, and
+  ///         return its angular velocity.
+  /// @param  [in]  valid   `false` if the sample has no gaze data.
+  float update(unsigned time_ms, float x_px, float y_px, bool valid = true);
+
+  float velocity() const;           ///< Last angular velocity in deg/s.
+  float amplitude() const;          ///< Last angular distance in degrees.
+  PointXY<float> position() const;  ///< Last angles from screen center.
+  VisualAngle const& angle() const; ///< Pixel to angle conversion.
+  void clear();                     ///< Restart.
+
+private:
+
+  VisualAngle             angle_;
+  bool                    has_last_{false};   // Previous valid sample
+  unsigned                time_ms_{0};        // Time of previous sample
+  PointXY<float>          point_{0, 0};       // Point of previous sample
+  VisualAngle::Direction  direction_{0, 0, 1};
+  float                   amplitude_{0};
+  float                   velocity_{0};
+};
+
+/// @}
+
+} // eye
+
+#endif // EYELIB_VISUAL_ANGLE_HPP
+//===========================================================================//
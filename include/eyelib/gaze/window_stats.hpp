@@ -0,0 +1,210 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Moving window statistics.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_WINDOW_STATS_HPP
+#define EYELIB_WINDOW_STATS_HPP
+
+#include <eyelib/gaze/ring.hpp>   // eye::Ring
+
+#include <cmath>        // std::sqrt
+#include <cstddef>      // std::size_t
+#include <type_traits>  // std::conditional, std::is_floating_point
+
+namespace eye {
+
+/// @addtogroup eyelib_gaze
+/// @{
+
+/** @brief  Statistics of the last `N` samples.
+
+  Each `push` adds a sample, removing the oldest sample once the window
+  holds `N` samples, and updates the statistics, so that every query is
+  O(1).  Push is O(1) amortized:
+
+  - The sum is updated by the added and removed samples.  For floating
+    point samples, it is summed again once per `N` samples, so that
+    rounding does not accumulate.
+  - The maximum and minimum are the first of monotonic queues, from which
+    samples are removed once a later sample exceeds them.
+  - If `Variance` is `true`, the mean and sum of squared differences from
+    the mean are updated by Welford's method, with removal of the oldest
+    sample, for `variance()` and `stddev()`.
+
+  All storage is allocated on construction.
+*/
+template<typename T, std::size_t N, bool Variance = false>
+class WindowStats
+{
+  static_assert(N != 0, "WindowStats requires a window of samples");
+
+public:
+
+  /// Type of the running sum.
+  using sum_type = typename std::conditional<std::is_floating_point<T>::value,
+                                             double, long long>::type;
+
+  WindowStats() : v_(N), max_(N), min_(N) {}
+
+  /// Add sample @a v, removing the oldest sample if the window is full.
+  void
+  push(T v)
+  {
+    T old{};
+    bool const remove = (v_.size() == N);
+    if (remove)
+    {
+      old = v_.front();
+      v_.pop_front();
+      sum_ -= old;
+      if (max_.front().index == first_) { max_.pop_front(); }
+      if (min_.front().index == first_) { min_.pop_front(); }
+      ++first_;
+    }
+    v_.push_back(v);
+    sum_ += v;
+
+    // Samples which can no longer be an extent of the window are removed
+    while (!max_.empty() && (max_.back().value <= v)) { max_.pop_back(); }
+    while (!min_.empty() && (min_.back().value >= v)) { min_.pop_back(); }
+    max_.push_back(Extent{next_, v});
+    min_.push_back(Extent{next_, v});
+    ++next_;
+
+    if (Variance) { welford(v, old, remove); }
+
+    // Sum again once per window of floating point samples
+    if (std::is_floating_point<T>::value && (++resum_ == N))
+    {
+      resum();
+    }
+  }
+
+  /// Mean of samples, or `0` if empty.
+  T mean() const  { return empty() ? T{} : T(sum_ / sum_type(size())); }
+
+  T max() const   { return empty() ? T{} : max_.front().value; } ///< Maximum.
+  T min() const   { return empty() ? T{} : min_.front().value; } ///< Minimum.
+  T sum() const   { return T(sum_); }                           ///< Sum.
+
+  /// Sample variance, or `0` if fewer than two samples.  Requires
+  /// `Variance`.
+  double
+  variance() const
+  {
+    static_assert(Variance, "WindowStats<T, N, true> required");
+    return (size() < 2) ? 0.0 : (m2_ / (size() - 1));
+  }
+
+  /// Sample standard deviation.  Requires `Variance`.
+  double stddev() const { return std::sqrt(variance()); }
+
+  std::size_t size() const  { return v_.size(); }   ///< Number of samples.
+  bool        empty() const { return v_.empty(); }  ///< No samples.
+  bool        full() const  { return v_.size() == N; } ///< `N` samples.
+
+  /// Remove all samples.
+  void
+  clear()
+  {
+    v_.clear();
+    max_.clear();
+    min_.clear();
+    sum_    = 0;
+    mean_   = 0;
+    m2_     = 0;
+    first_  = 0;
+    next_   = 0;
+    resum_  = 0;
+  }
+
+private:
+
+  // Sample index and value, for monotonic extent queues
+  struct Extent
+  {
+    std::size_t index;
+    T           value;
+  };
+
+  void
+  welford(T v, T old, bool remove)
+  {
+    double const x = v;
+    double const n = double(size());
+    if (remove)
+    {
+      // Replace the oldest sample
+      double const y    = old;
+      double const mean = mean_ + (x - y) / n;
+      m2_   += (x - y) * ((x - mean) + (y - mean_));
+      mean_  = mean;
+    }
+    else
+    {
+      double const d = x - mean_;
+      mean_ += d / n;
+      m2_   += d * (x - mean_);
+    }
+    if (m2_ < 0) { m2_ = 0; }
+  }
+
+  void
+  resum()
+  {
+    resum_ = 0;
+    sum_   = 0;
+    for (std::size_t i = 0; i != v_.size(); ++i) { sum_ += v_[i]; }
+    if (Variance)
+    {
+      mean_ = double(sum_) / double(v_.size());
+      m2_   = 0;
+      for (std::size_t i = 0; i != v_.size(); ++i)
+      {
+        double const d = v_[i] - mean_;
+        m2_ += d * d;
+      }
+    }
+  }
+
+  Ring<T>       v_;             // Samples
+  Ring<Extent>  max_;           // Decreasing maximum queue
+  Ring<Extent>  min_;           // Increasing minimum queue
+  sum_type      sum_{0};        // Sum of samples
+  double        mean_{0};       // Welford mean
+  double        m2_{0};         // Welford sum of squared differences
+  std::size_t   first_{0};      // Index of the oldest sample
+  std::size_t   next_{0};       // Index of the next sample
+  std::size_t   resum_{0};      // Samples since summed
+};
+
+/// @}
+
+} // eye
+
+#endif // EYELIB_WINDOW_STATS_HPP
+//===========================================================================//
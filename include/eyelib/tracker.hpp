@@ -39,9 +39,12 @@ SOFTWARE.
 
 namespace eye {
 
+struct AdaptiveDuration;
 struct Calibration;
+struct CalibrationTiming;
 struct Gaze;
 struct Screen;
+struct StoreTiming;
 
 /**
   @addtogroup eyelib_tracker
@@ -145,8 +148,13 @@ struct Screen;
 ### Start   ###################################################################
 
   Clients must call `start()` to connect to the eye tracker server in order to
-  begin receiving gaze data.  The caller can specify wait time in milliseconds
-  between starting asynchronous TCP I/O and requesting a server connection.
+  begin receiving gaze data.  A server connection is requested as soon as the
+  socket is open.  The caller can specify wait time in milliseconds for the
+  connection before `start()` returns.
+
+  A connection that fails, stops answering heartbeats, or is lost on a read
+  or write error is reopened, with a bounded number of attempts.  Clients
+  are notified of each change in `is_connected` and `connection_error`.
   ```
   tracker.start();        // Default wait time
   …
@@ -169,6 +177,8 @@ struct Screen;
   if (is_calibrating) { … }       // true if being calibrated
   if (is_connected) { … }         // true if connected to server
   if (is_started) { … }           // true if tracker is started
+
+  std::string e = s.connection_error;   // Last connection error, or empty
   ```
 ### %Gaze Targets   ###########################################################
 
@@ -205,6 +215,58 @@ struct Screen;
   tracker.calibrate(points);
 
   ```
+  Points can instead end as soon as gaze is stable.  Each point lasts
+  between `min_ms` and `max_ms`, ending once gaze has stayed within
+  `dmax_px` of dispersion for `stable_ms`.  Per-point dwell times and the
+  total time saved versus fixed timing are available afterward.
+  ```
+  eye::AdaptiveDuration adaptive = {400, 1500, 300, 40.f};  // min, max, stable, dispersion
+  tracker.adaptive_calibration(adaptive);
+  tracker.calibrate(points);
+
+  std::cout << tracker.calibration_timing() << '\n';
+
+  tracker.adaptive_calibration({0, 0, 0, 0.f});   // Fixed timing
+  ```
+  Member `recalibrate()` retests only points whose samples were missing or
+  questionable, or whose accuracy was rated `recalibrate`.  Each
+  calibration run replaces the previous one; to also retest the least
+  accurate good points, pass a minimum point count to
+  `recalibration_targets()`.
+  ```
+  if (!tracker.recalibrate())
+  {
+    std::cout << "All points good\n";
+  }
+
+  // In a session window
+  tracker.set_mode(eye::Tracker::Mode::calibration,
+                   eye::recalibration_targets(tracker.calibration()));
+  ```
+  Successful calibrations can be saved to disk for each participant and
+  screen.  On startup, a participant whose stored calibration is still
+  held by the server needs only a quick validation.
+  ```
+  tracker.participant("P07", "calibrations");   // Load stored calibration
+  tracker.start();
+  …
+  if (!tracker.calibration_stored())
+  {
+    tracker.calibrate(points);                  // Saved when complete
+  }
+  std::cout << tracker.store_timing() << '\n';  // Load and validate times
+  ```
+### Validation   ##############################################################
+
+  Member `validate()` opens a window with a target sequence, and measures
+  accuracy, precision and data loss of gaze at each target.  Results are
+  computed as each target ends.  A call to `validate()` blocks until the
+  window is closed.
+  ```
+  auto results = tracker.validate(points, {500,1500,500});
+  std::cout << results << '\n';
+  std::cout << eye::mean(results).accuracy_deg << '\n';
+  ```
 ### Window   ##################################################################
 
   Member `window()` opens a window to display gaze points and/or gaze targets.
@@ -228,6 +290,25 @@ struct Screen;
   // Target durations and background can be list initialized
   window(points, {500,1000,500}, {149,149,149});
   ```
+### Session   #################################################################
+
+  Member `session()` opens a single window that is reused for calibration,
+  target sequences and free viewing.  It blocks until the window is closed,
+  so call `set_mode()` from another thread to switch between modes.  The
+  window is not recreated, and each switch appears within one frame.
+  ```
+  std::thread t([&tracker](){ tracker.session(); });
+
+  tracker.set_mode(eye::Tracker::Mode::calibration, points);
+  …
+  tracker.set_mode(eye::Tracker::Mode::targets, points, {500,1000,500});
+  …
+  tracker.set_mode(eye::Tracker::Mode::validation, points);
+  …
+  tracker.set_mode(eye::Tracker::Mode::free_view);
+
+  t.join();   // Window closed by user
+  ```
 ###############################################################################
 */
 //----------------------------------------------------------------------------
@@ -284,6 +365,15 @@ public:
     unrecognized  = 5   ///< Unrecognized device state code.
   };
 
+  /// Session window mode.
+  enum class Mode : unsigned
+  {
+    free_view   = 0,  ///< Gaze points only.
+    targets     = 1,  ///< %Target sequence.
+    calibration = 2,  ///< Eye tracker calibration.
+    validation  = 3   ///< Accuracy and precision validation.
+  };
+
   /// Device, server, and calibration states.
   struct State
   {
@@ -293,6 +383,8 @@ public:
     bool     is_calibrating = false;   ///< `true` if being calibrated.
     bool     is_connected   = false;   ///< `true` if connected to server.
     bool     is_started     = false;   ///< `true` if tracker is started.
+    std::string connection_error{};    ///< Last connection error, or empty
+                                       ///< once reconnected.
   };
 
   /// Calibration change notification handler alias.
@@ -359,6 +451,30 @@ public:
   State
   state() const;
 
+  /// Return the current session window mode.
+  Mode
+  mode() const;
+
+  /// Return the last calibration results received from the server.
+  Calibration
+  calibration() const;
+
+  /// @brief  Return `true` if a quick validation can replace calibration.
+  ///
+  /// `true` if the participant's stored calibration for this screen was
+  /// successful, is not rated `recalibrate`, and is still the calibration
+  /// held by the server.
+  bool
+  calibration_stored() const;
+
+  /// Return accumulated calibration store load and validate times.
+  StoreTiming
+  store_timing() const;
+
+  /// Return active durations of the points of the last calibration.
+  CalibrationTiming
+  calibration_timing() const;
+
   ///// Get current gaze data.
   //Gaze
   //gaze() const;
@@ -378,8 +494,8 @@ public:
   /// @{
 
   /// @brief  Connect to an eye tracker.
-  /// @param  [in]  wait_ms       Wait in milliseconds between starting
-  ///         asynchronous TCP I/O and requesting a server connection.
+  /// @param  [in]  wait_ms       Wait in milliseconds for the connection
+  ///         after starting asynchronous TCP I/O.
   void
   start(unsigned wait_ms = 50);
 
@@ -393,6 +509,50 @@ public:
             TargetDuration const& target_ms = {500,1000,500},
             ColorRGB const& background = {149,149,149});
 
+  /// @brief  Select the participant whose calibrations are stored.
+  /// @param  [in]  id    Participant ID, or empty to stop storing.
+  /// @param  [in]  dir   Existing directory of the store, or empty for
+  ///                     the working directory.
+  /// @return `true` if a stored calibration was loaded for this screen.
+  ///
+  /// Successful calibrations completed afterward are saved to the store.
+  bool
+  participant(std::string const& id, std::string const& dir = "");
+
+  /// @brief  Recalibrate only the points that need it.
+  /// @param  [in]  target_ms   Target delay times in milliseconds.
+  /// @param  [in]  background  Background color.
+  /// @return `false`, without opening a window, if no point of the last
+  ///         calibration needs recalibration.
+  ///
+  /// Calibrates at `recalibration_targets(calibration())`.
+  /// @note   Blocks until the window is closed.
+  bool
+  recalibrate(TargetDuration const& target_ms = {500,1000,500},
+              ColorRGB const& background = {149,149,149});
+
+  /// @brief  Set adaptive calibration point duration.
+  /// @param  [in]  d   Duration limits and stability criterion.
+  ///
+  /// Applies to calibrations started afterward.  Pass a `stable_ms` of
+  /// `0` to return to fixed point durations.
+  void
+  adaptive_calibration(AdaptiveDuration const& d);
+
+  /// @brief  Validate calibration at the specified points.
+  /// @param  [in]  points      Validation points.
+  /// @param  [in]  target_ms   Target delay times in milliseconds.
+  /// @param  [in]  background  Background color.
+  /// @return Accuracy, precision and data loss at each point validated.
+  ///
+  /// Results are also written to the console as soon as the last point
+  /// ends.
+  /// @note   Blocks until the window is closed.
+  Validation::Results
+  validate(Targets const& points,
+           TargetDuration const& target_ms = {500,1000,500},
+           ColorRGB const& background = {149,149,149});
+
   /// @brief  Open a gaze window
   /// @param  [in]  background  Background color.
   /// @note   Blocks until the window is closed.
@@ -412,6 +572,28 @@ public:
          TargetDuration const& target_ms = {500,1000,500},
          ColorRGB const& background = {149,149,149});
 
+  /// @brief  Open a session window
+  /// @param  [in]  background  Background color.
+  ///
+  /// Creates a gaze window that stays open while `set_mode()` switches
+  /// between free viewing, target sequences and calibration.
+  /// @note   Blocks until the window is closed.
+  void
+  session(ColorRGB const& background = {149,149,149});
+
+  /// @brief  Switch the session window mode.
+  /// @param  [in]  m           Mode.
+  /// @param  [in]  points      Target or calibration points.
+  /// @param  [in]  target_ms   Target delay times in milliseconds.
+  /// @return `false` if no session window is open, or if @a points is
+  ///         empty for a target or calibration mode.
+  ///
+  /// Stops any running target sequence or calibration and replaces the
+  /// window content in a single frame.
+  bool
+  set_mode(Mode m, Targets const& points = {},
+           TargetDuration const& target_ms = {500,1000,500});
+
   /// @}
   //-----------------------------------------------------------
 
@@ -448,6 +630,25 @@ operator<<(std::ostream& os, Tracker::Device const& val);
 /// @}
 
 
+/////////////////////////////////////////////////////////////////////////////
+//  Session Mode
+/////////////////////////////////////////////////////////////////////////////
+
+/// Convert to string.
+std::string
+to_string(Tracker::Mode const& val);
+
+/// @name     Non-member function overloads
+/// @relates  eye::Tracker
+/// @{
+
+/// @brief    Insert into output stream.
+std::ostream&
+operator<<(std::ostream& os, Tracker::Mode const& val);
+
+/// @}
+
+
 /////////////////////////////////////////////////////////////////////////////
 //  Tracker State
 /////////////////////////////////////////////////////////////////////////////
@@ -479,13 +680,86 @@ namespace tracker { namespace message { namespace debug {
 /// @internal
 /// Eye tracker server test message types.
 enum class TestMessage
-{ all, calibration, ostream_string, predefined, requests };
+{ all, calibration, ostream_string, predefined, requests, serialized };
 
 /// @internal
 /// Test eye tracker server messages.
 void message_test(TestMessage const& t);
 
 } } } // tracker::message::debug
+
+/// Testing only.
+namespace gaze { namespace debug {
+
+/// @internal
+/// Test dispersion threshold ring agreement with the deque it replaced,
+/// and benchmark both for several window sizes.
+void dispersion_benchmark();
+
+/// @internal
+/// Test point cluster ring agreement with the deques it replaced, and
+/// benchmark rings and deques as moving windows.
+void ring_benchmark();
+
+/// @internal
+/// Test moving window statistics agreement with a scan of the window,
+/// and benchmark both for window sizes of 60 to 10,000 samples.
+void window_benchmark();
+
+/// @internal
+/// Test quantile sketch rank error, alone and merged from threads, and
+/// its write and read, and benchmark adding values.
+void quantile_benchmark();
+
+/// @internal
+/// Test areas of interest agreement with the fixation algorithm, and
+/// benchmark both for 9 to 1,000 targets.
+void aoi_benchmark();
+
+/// @internal
+/// Test visual angle and angular velocity agreement with trigonometry
+/// per sample, and benchmark both.
+void angle_benchmark();
+
+/// @internal
+/// Test event classifier agreement with the DT and VT algorithms, and
+/// benchmark it against those algorithms fed per sample.
+void classifier_benchmark();
+
+/// @internal
+/// Test fixation parameter sweep agreement with the DT, VT and fixation
+/// algorithms, and benchmark it against a pass per configuration.
+void sweep_benchmark();
+
+/// @internal
+/// Benchmark heatmap accumulation and colorizing, and test building a
+/// heatmap from a gaze data log.
+void heatmap_benchmark();
+
+} } // gaze::debug
+
+/// Testing only.
+namespace window { namespace debug {
+
+/// @internal
+/// Benchmark full and damage-region window drawing at 1080p and 4K.
+void draw_benchmark();
+
+/// @internal
+/// Test triple buffer handoff between threads.  Build with
+/// `-fsanitize=thread` to check for data races.
+void triple_buffer_test();
+
+/// @internal
+/// Benchmark drawing and hit-testing of 10 to 10,000 targets.
+void target_benchmark();
+
+/// @internal
+/// Test headless window states, and benchmark drawing gaze, target and
+/// calibration scenes into memory.  Does not require a display.
+void headless_benchmark();
+
+} } // window::debug
 /// @}
 /////////////////////////////////////////////////////////////////////////////
 /// @}
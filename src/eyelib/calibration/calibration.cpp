@@ -32,10 +32,11 @@ SOFTWARE.
 #include "calibration/calib_point.hpp"
 #include "calibration/calib_rating.hpp"
 
-#include <algorithm>  // std::max, std::min
+#include <algorithm>  // std::max, std::min, std::sort
 #include <sstream>    // std::ostringstream
 #include <ostream>    // std::ostream
 #include <string>     // std::string
+#include <vector>     // std::vector
 
 namespace eye {
 
@@ -129,6 +130,29 @@ json(Calibration const& c)
 #endif
 
 
+//---------------------------------------------------------------------------
+
+std::ostream&
+operator<<(std::ostream& os, CalibrationTiming const& t)
+{
+  os << "dwell_ms :";
+  for (auto ms : t.dwell_ms)
+  {
+    os << ' ' << ms;
+  }
+  return os << "\nfixed_ms : " << t.fixed_ms
+            << "\nsaved_ms : " << t.saved_ms;
+}
+
+std::ostream&
+operator<<(std::ostream& os, StoreTiming const& t)
+{
+  return os << "loads       : " << t.loads
+            << "\nload_ms     : " << t.load_ms
+            << "\nvalidations : " << t.validations
+            << "\nvalidate_ms : " << t.validate_ms;
+}
+
 //---------------------------------------------------------------------------
 
 void
@@ -150,6 +174,51 @@ centroid(unsigned& x, unsigned& y, Calibration::Points const& pts)
   y = min_y + ((max_y - min_y) / 2);
 }
 
+bool
+needs_recalibration(Calibration::Point const& p)
+{
+  using R = Calibration::Rating;
+  using S = Calibration::Point::State;
+  return (p.sample_state != S::ok)
+      || (p.accuracy_rating.binocular == R::recalibrate)
+      || (p.accuracy_rating.binocular == R::uncalibrated);
+}
+
+Targets
+recalibration_targets(Calibration const& c, std::size_t min_points)
+{
+  // Points to retest first, then good points from least to most accurate
+  std::vector<Calibration::Point const*> retest;
+  std::vector<Calibration::Point const*> good;
+  for (auto const& p : c.points)
+  {
+    (needs_recalibration(p) ? retest : good).push_back(&p);
+  }
+  if (retest.empty())
+  {
+    return Targets();
+  }
+  std::sort(good.begin(), good.end(),
+    [](Calibration::Point const* a, Calibration::Point const* b)
+    {
+      return a->accuracy_deg.binocular > b->accuracy_deg.binocular;
+    });
+  for (auto p : good)
+  {
+    if (retest.size() >= min_points) { break; }
+    retest.push_back(p);
+  }
+
+  Targets targets;
+  targets.reserve(retest.size());
+  for (auto p : retest)
+  {
+    targets.push_back({ static_cast<int>(p->calibrate_px.x),
+                        static_cast<int>(p->calibrate_px.y), true });
+  }
+  return targets;
+}
+
 //---------------------------------------------------------------------------
 
 
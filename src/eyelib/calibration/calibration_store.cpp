@@ -0,0 +1,175 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include "calibration/calibration_store.hpp"
+
+#include "debug/debug_out.hpp"    // eye::debug::error
+#include "tracker/message.hpp"    // eye::tracker::Message
+
+#include <cctype>     // std::isalnum
+#include <chrono>     // std::chrono::steady_clock
+#include <exception>  // std::exception
+#include <fstream>    // std::ifstream, std::ofstream
+
+namespace {   //-------------------------------------------------------------
+
+using steady   = std::chrono::steady_clock;
+using ms_float = std::chrono::duration<double, std::milli>;
+
+// Key of the raw calibration results object
+std::string const
+result_key(eye::tracker::Message::Value::calibration_result);
+
+nlohmann::json
+to_json(eye::Screen const& s)
+{
+  return { {"index", s.index}, {"x_px", s.x_px}, {"y_px", s.y_px},
+           {"w_px", s.w_px}, {"h_px", s.h_px},
+           {"w_m", s.w_m}, {"h_m", s.h_m} };
+}
+
+// Participant ID with characters unsafe in a file name replaced
+std::string
+file_name(std::string const& id)
+{
+  std::string name(id);
+  for (auto& c : name)
+  {
+    if (!std::isalnum(static_cast<unsigned char>(c)) && (c != '-'))
+    {
+      c = '_';
+    }
+  }
+  return name;
+}
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye { namespace tracker {
+
+//---------------------------------------------------------------------------
+
+CalibrationStore::CalibrationStore(std::string const& dir)
+: dir_(dir)
+{
+  if (!dir_.empty() && (dir_.back() != '/') && (dir_.back() != '\\'))
+  {
+    dir_ += '/';
+  }
+}
+
+//---------------------------------------------------------------------------
+
+bool
+CalibrationStore::load(std::string const& participant, Screen const& scr,
+                       Entry& e)
+{
+  // Read and deserialize
+  auto t0 = steady::now();
+  nlohmann::json j;
+  {
+    std::ifstream ifs(path(participant, scr));
+    if (!ifs)
+    {
+      return false;   // Nothing stored
+    }
+    try
+    {
+      ifs >> j;
+    }
+    catch (std::exception& ex)
+    {
+      eye::debug::error(__FILE__, __LINE__,
+                        "invalid calibration store file", ex.what());
+      return false;
+    }
+  }
+  auto t1 = steady::now();
+  ++timing_.loads;
+  timing_.load_ms += ms_float(t1 - t0).count();
+
+  // Validate: same screen, and results parse
+  Message m;
+  bool valid = j.count("screen") && (j.at("screen") == to_json(scr))
+            && j.count(result_key);
+  Entry entry;
+  if (valid)
+  {
+    entry.raw = j.at(result_key);
+    m.values[result_key] = entry.raw;
+    valid = message::parse(m, entry.calibration);
+  }
+  ++timing_.validations;
+  timing_.validate_ms += ms_float(steady::now() - t1).count();
+
+  if (valid)
+  {
+    e = std::move(entry);
+  }
+  return valid;
+}
+
+bool
+CalibrationStore::save(std::string const& participant, Screen const& scr,
+                       nlohmann::json const& raw)
+{
+  nlohmann::json j = { {"participant", participant},
+                       {"screen", to_json(scr)},
+                       {result_key, raw} };
+  std::ofstream ofs(path(participant, scr));
+  ofs << j.dump(2) << '\n';
+  if (!ofs)
+  {
+    eye::debug::error(__FILE__, __LINE__,
+                      "failed to write calibration store file",
+                      path(participant, scr));
+    return false;
+  }
+  return true;
+}
+
+StoreTiming
+CalibrationStore::timing() const
+{
+  return timing_;
+}
+
+//---------------------------------------------------------------------------
+// private
+
+std::string
+CalibrationStore::path(std::string const& participant,
+                       Screen const& scr) const
+{
+  return dir_ + file_name(participant)
+       + "_screen" + std::to_string(scr.index)
+       + '_' + std::to_string(scr.w_px) + 'x' + std::to_string(scr.h_px)
+       + ".json";
+}
+
+//---------------------------------------------------------------------------
+
+} } // eye::tracker
+//===========================================================================//
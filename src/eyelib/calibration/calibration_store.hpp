@@ -0,0 +1,89 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Eye tracker calibration store.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_CALIBRATION_STORE_HPP
+#define EYELIB_CALIBRATION_STORE_HPP
+
+#include <eyelib/calibration.hpp>   // eye::Calibration, eye::StoreTiming
+#include <eyelib/screen.hpp>        // eye::Screen
+
+#include <utl/json.hpp>   // nlohmann::json
+
+#include <string>     // std::string
+
+namespace eye { namespace tracker {
+
+/**
+  @brief  Calibration results saved on local disk.
+
+  Results are keyed by participant ID and screen, one file per key, in a
+  directory that must already exist.  Each file holds the raw `calibresult`
+  object received from the server, from which the `Calibration` is parsed
+  when loaded.  The raw object also identifies the calibration currently
+  held by the server.
+
+  Loading is timed in two parts: reading and deserializing the file, and
+  validating it by checking the screen and parsing the results.
+*/
+class CalibrationStore
+{
+public:
+
+  /// Stored calibration.
+  struct Entry
+  {
+    Calibration     calibration{};  ///< Parsed results.
+    nlohmann::json  raw{};          ///< Raw `calibresult` object.
+  };
+
+  /// Construct a store in directory @a dir, or the working directory.
+  explicit
+  CalibrationStore(std::string const& dir = "");
+
+  /// @brief  Load the calibration of @a participant on screen @a scr.
+  /// @return `true` if a valid entry was found.
+  bool load(std::string const& participant, Screen const& scr, Entry& e);
+
+  /// @brief  Save raw calibration results of @a participant on @a scr.
+  /// @return `false` if the file could not be written.
+  bool save(std::string const& participant, Screen const& scr,
+            nlohmann::json const& raw);
+
+  StoreTiming timing() const;   ///< Accumulated load and validate times.
+
+private:
+  std::string path(std::string const& participant, Screen const& scr) const;
+
+  std::string dir_;
+  StoreTiming timing_{0, 0.0, 0, 0.0};
+};
+
+} } // eye::tracker
+
+#endif // EYELIB_CALIBRATION_STORE_HPP
+//===========================================================================//
@@ -30,7 +30,9 @@ SOFTWARE.
 
 #include "debug/debug_out.hpp"  // eye::debug::error
 
+#include <algorithm>  // std::max
 #include <iostream>   // std::cout
+#include <string>     // std::to_string
 
 namespace {   //-------------------------------------------------------------
 
@@ -43,7 +45,7 @@ namespace eye { namespace tracker {
 
 //---------------------------------------------------------------------------
 
-Calibrator::Calibrator(utl::io::tcp::client& tcp)
+Calibrator::Calibrator(Connection& tcp)
 : tcp_(tcp)
 {}
 
@@ -58,8 +60,21 @@ Calibrator::setup(Window& win, Targets const& points,
   // Events will be handled in the lambda expression below.
   gaze_target_.register_window(win, false);
 
-  // Set targets and timer delays.
-  gaze_target_.set_targets(points, target_ms);
+  // Set targets and timer delays.  With adaptive timing, the active
+  // duration is the maximum; stable gaze ends a point sooner.
+  TargetDuration delay_ms = target_ms;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    setup_adaptive_ = adaptive_;
+    if (setup_adaptive_.stable_ms != 0)
+    {
+      delay_ms.active_ms = std::max(setup_adaptive_.max_ms,
+                                    setup_adaptive_.min_ms);
+    }
+    timing_ = CalibrationTiming{{}, target_ms.active_ms, 0};
+    point_active_ = false;
+  }
+  gaze_target_.set_targets(points, delay_ms);
 
   // Register to receive window events.
   win.register_handler([this, points/*, &mutex*/](Window::Event const& e)
@@ -79,7 +94,7 @@ Calibrator::setup(Window& win, Targets const& points,
           if (!gaze_target_.is_started())
           {
             std::cout << (std::to_string(e.time_ms) + ",start_calibration\n");
-            tcp_.write(msg::calibration_start(points.size()).dump());
+            tcp_.write(msg::serialized::calibration_start(points.size()));
           }
         }
         else if (e.key.special() == Special::escape)  // Esc key
@@ -89,13 +104,66 @@ Calibrator::setup(Window& win, Targets const& points,
           //if (gaze_target_.is_started())
           //{
             std::cout << (std::to_string(e.time_ms) + ",abort_calibration\n");
-            tcp_.write(msg::calibration_abort().dump());
+            tcp_.write(msg::CALIBRATION_ABORT);
           //}
         }
       }
     });
 }
 
+void
+Calibrator::stop()
+{
+  if (gaze_target_.is_started())
+  {
+    tcp_.write(msg::CALIBRATION_ABORT);
+  }
+  gaze_target_.set_targets({});   // Stop sequence
+  std::lock_guard<std::mutex> lock(mutex_);
+  point_active_ = false;
+}
+
+//---------------------------------------------------------------------------
+
+void
+Calibrator::handle(Gaze const& g, unsigned frame_rate)
+{
+  unsigned id = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (frame_rate != 0) { frame_rate_ = frame_rate; }
+    gaze_time_ms_ = g.time_ms;
+    if (!point_active_ || (setup_adaptive_.stable_ms == 0))
+    {
+      return;
+    }
+    // End the point once gaze has been stable for the minimum duration
+    bool stable = stability_.fixation(g.avg_px.x, g.avg_px.y);
+    auto active = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    clock::now() - point_start_).count();
+    if (!stable || (active < static_cast<long long>(setup_adaptive_.min_ms)))
+    {
+      return;
+    }
+    id = point_id_;
+  }
+  end_point(id);
+}
+
+void
+Calibrator::adaptive(AdaptiveDuration const& d)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  adaptive_ = d;
+}
+
+CalibrationTiming
+Calibrator::timing() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return timing_;
+}
+
 //---------------------------------------------------------------------------
 
 void
@@ -109,6 +177,11 @@ Calibrator::process_response(Message const& m)
     //-----------------------------------------------------------
     case Msg::Request::start:         // successful "start" request
     {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        timing_.dwell_ms.clear();
+        timing_.saved_ms = 0;
+      }
       gaze_target_.start([this]()
         {
           Target t;
@@ -118,7 +191,8 @@ Calibrator::process_response(Message const& m)
             std::cout << "eyelib: calibration_point_start("
                       << t.x_px << ',' << t.y_px << ")\n";
             #endif
-            tcp_.write(msg::calibration_point_start(t.x_px, t.y_px).dump());
+            tcp_.write(
+              msg::serialized::calibration_point_start(t.x_px, t.y_px));
           }
         });
       break;
@@ -126,13 +200,9 @@ Calibrator::process_response(Message const& m)
     //-----------------------------------------------------------
     case Msg::Request::point_start:   // successful "pointstart" request
     {
-      gaze_target_.point_start([this]()
-        {
-          #ifdef EYELIB_DEBUG
-          std::cout << "eyelib: calibration_point_end()\n";
-          #endif
-          tcp_.write(msg::calibration_point_end().dump());
-        });
+      // Ended by stable gaze or, at the latest, by the active duration
+      unsigned id = begin_point();
+      gaze_target_.point_start([this, id](){ end_point(id); });
       break;
     }
     //-----------------------------------------------------------
@@ -149,7 +219,8 @@ Calibrator::process_response(Message const& m)
                 std::cout << "eyelib: calibration_point_start("
                           << t.x_px << ',' << t.y_px << ")\n";
                 #endif
-                tcp_.write(msg::calibration_point_start(t.x_px,t.y_px).dump());
+                tcp_.write(
+                  msg::serialized::calibration_point_start(t.x_px, t.y_px));
               }
             });
         });
@@ -177,6 +248,50 @@ Calibrator::process_response(Message const& m)
   }
 }
 
+//---------------------------------------------------------------------------
+// private
+
+unsigned
+Calibrator::begin_point()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Number of samples spanning the stable duration
+  unsigned pts = setup_adaptive_.stable_ms * frame_rate_ / 1000;
+  stability_    = DispersionThreshold(std::max(pts, 2u),
+                                      setup_adaptive_.dmax_px);
+  point_start_  = clock::now();
+  point_active_ = true;
+  return ++point_id_;
+}
+
+void
+Calibrator::end_point(unsigned id)
+{
+  unsigned dwell_ms = 0;
+  unsigned time_ms  = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!point_active_ || (id != point_id_))
+    {
+      return;     // Already ended early, or a later point is active
+    }
+    point_active_ = false;
+    dwell_ms = static_cast<unsigned>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+        clock::now() - point_start_).count());
+    timing_.dwell_ms.push_back(dwell_ms);
+    timing_.saved_ms += static_cast<int>(timing_.fixed_ms)
+                      - static_cast<int>(dwell_ms);
+    time_ms = gaze_time_ms_;
+  }
+  #ifdef EYELIB_DEBUG
+  std::cout << "eyelib: calibration_point_end()\n";
+  #endif
+  std::cout << (std::to_string(time_ms) + ",calibration_point_end,"
+                + std::to_string(dwell_ms) + '\n');
+  tcp_.write(msg::CALIBRATION_POINT_END);
+}
+
 //---------------------------------------------------------------------------
 
 } } // eye::tracker
@@ -29,34 +29,68 @@ SOFTWARE.
 #ifndef EYELIB_CALIBRATOR_HPP
 #define EYELIB_CALIBRATOR_HPP
 
+#include <eyelib/calibration.hpp>
+#include <eyelib/gaze.hpp>
+#include <eyelib/gaze/dispersion_threshold.hpp>
 #include <eyelib/screen.hpp>
 
 #include "gaze/gaze_target.hpp"
+#include "tracker/connection.hpp"
 #include "tracker/message.hpp"
 #include "window/window.hpp"
 
-#include <utl/asio/tcp/client.hpp>  // utl::io::tcp::server
-
-//#include <mutex>      // std::mutex, std::lock_guard
+#include <chrono>     // std::chrono::steady_clock
+#include <mutex>      // std::mutex, std::lock_guard
 
 namespace eye { namespace tracker {
 
 /// Eye tracker calibrator.
 ///
+/// With adaptive timing, each point ends early once gaze received during
+/// the point has been stable; see `AdaptiveDuration`.
 class Calibrator
 {
 public:
 
-  Calibrator(utl::io::tcp::client& tcp);
+  Calibrator(Connection& tcp);
 
   void setup(Window& win, Targets const& points,
              TargetDuration const& target_ms);
 
+  /// Abort any calibration in progress and remove the points.
+  void stop();
+
   void process_response(Message const& m);
 
+  /// Process gaze data received at @a frame_rate samples per second.
+  void handle(Gaze const& g, unsigned frame_rate);
+
+  /// Set adaptive point duration.  Takes effect at the next `setup()`.
+  void adaptive(AdaptiveDuration const& d);
+
+  /// Return active durations of the points of the last calibration.
+  CalibrationTiming timing() const;
+
 private:
+  using clock = std::chrono::steady_clock;
+
+  unsigned begin_point();         // Start timing a point, return its id
+  void end_point(unsigned id);    // End point id unless already ended
+
   GazeTarget  gaze_target_{};     // sequence of targets
-  utl::io::tcp::client& tcp_;
+  Connection& tcp_;
+
+  // Point timing, shared by I/O, timer and window threads
+  mutable std::mutex  mutex_{};
+  AdaptiveDuration    adaptive_{0, 0, 0, 0.f};  // Disabled
+  AdaptiveDuration    setup_adaptive_{0, 0, 0, 0.f};  // Current calibration
+  DispersionThreshold stability_{2, 0.f};       // Gaze during current point
+  clock::time_point   point_start_{};
+  unsigned            point_id_{0};
+  bool                point_active_{false};
+  unsigned            frame_rate_{30};          // Last known sampling rate
+  unsigned            gaze_time_ms_{0};         // Last gaze timestamp
+  CalibrationTiming   timing_{{}, 0, 0};
 };
 
 } } // eye::tracker
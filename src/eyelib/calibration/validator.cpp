@@ -0,0 +1,139 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include "calibration/validator.hpp"
+
+#include <iostream>   // std::cout
+#include <string>     // std::to_string
+
+namespace eye { namespace tracker {
+
+//---------------------------------------------------------------------------
+
+Validator::Validator(Screen const& scr)
+: validation_(scr)
+{}
+
+//---------------------------------------------------------------------------
+
+void
+Validator::setup(Window& win, Targets const& points,
+                 TargetDuration const& target_ms)
+{
+  // Window events are handled in the lambda expression below.
+  gaze_target_.register_window(win, false);
+  gaze_target_.set_targets(points, target_ms);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    validation_.clear();
+    count_ = points.size();
+  }
+
+  win.register_handler([this](Window::Event const& e)
+    {
+      using Special = eye::Window::Event::Key::Special;
+
+      if (e.key.is_press())   // Key press
+      {
+        if (e.key.is_enter() && !gaze_target_.is_started())   // Enter key
+        {
+          std::cout << (std::to_string(e.time_ms) + ",start_validation\n");
+          {
+            std::lock_guard<std::mutex> lock(mutex_);
+            validation_.clear();
+          }
+          gaze_target_.start([this](){ begin_point(); });
+        }
+        else if ((e.key.special() == Special::escape)   // Esc key
+                 && gaze_target_.is_started())
+        {
+          std::cout << (std::to_string(e.time_ms) + ",stop_validation\n");
+          gaze_target_.reset();
+        }
+      }
+    });
+}
+
+void
+Validator::stop()
+{
+  gaze_target_.set_targets({});   // Stop sequence
+}
+
+void
+Validator::handle(Gaze const& g)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  validation_.add(g);     // Ignored unless a target is active
+}
+
+Validation::Results
+Validator::results() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return validation_.results();
+}
+
+//---------------------------------------------------------------------------
+// private
+
+void
+Validator::begin_point()
+{
+  Target t;
+  if (!gaze_target_.get_target(t))
+  {
+    return;     // Sequence stopped
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    validation_.begin(t);
+  }
+  gaze_target_.point_start([this](){ end_point(); });
+}
+
+void
+Validator::end_point()
+{
+  bool done = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    validation_.end();
+    done = (validation_.results().size() == count_);
+    if (done)
+    {
+      std::cout << validation_.results() << '\n';   // Report
+    }
+  }
+  gaze_target_.point_end([this]()
+    {
+      gaze_target_.advance([this](){ begin_point(); });
+    });
+}
+
+//---------------------------------------------------------------------------
+
+} } // eye::tracker
+//===========================================================================//
@@ -0,0 +1,78 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Eye tracker validator.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_VALIDATOR_HPP
+#define EYELIB_VALIDATOR_HPP
+
+#include <eyelib/gaze.hpp>
+#include <eyelib/screen.hpp>
+
+#include "gaze/gaze_target.hpp"
+#include "window/window.hpp"
+
+#include <mutex>      // std::mutex, std::lock_guard
+
+namespace eye { namespace tracker {
+
+/// Eye tracker validator.
+///
+/// Shows a target sequence and collects gaze received while each target is
+/// active.  Results are computed as each target ends, so the report is
+/// complete as soon as the sequence ends.
+class Validator
+{
+public:
+
+  Validator(Screen const& scr);
+
+  void setup(Window& win, Targets const& points,
+             TargetDuration const& target_ms);
+
+  /// Stop any sequence in progress and remove the points.
+  void stop();
+
+  /// Process gaze data.
+  void handle(Gaze const& g);
+
+  /// Return results of the targets validated so far.
+  Validation::Results results() const;
+
+private:
+  void begin_point();     // Activate current target and collect gaze
+  void end_point();       // Compute target results, then advance
+
+  GazeTarget          gaze_target_{};     // sequence of targets
+  mutable std::mutex  mutex_{};
+  Validation          validation_;
+  std::size_t         count_{0};          // Number of targets
+};
+
+} } // eye::tracker
+
+#endif // EYELIB_VALIDATOR_HPP
+//===========================================================================//
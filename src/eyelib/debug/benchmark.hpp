@@ -0,0 +1,185 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Benchmark timing and synthetic gaze for the debug tests.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_DEBUG_BENCHMARK_HPP
+#define EYELIB_DEBUG_BENCHMARK_HPP
+
+#include <algorithm>  // std::min
+#include <chrono>     // std::chrono::steady_clock
+#include <cstddef>    // std::size_t
+#include <iostream>   // std::cout
+#include <random>     // std::mt19937, std::normal_distribution
+#include <string>     // std::string
+#include <vector>     // std::vector
+
+namespace eye { namespace debug {
+//---------------------------------------------------------------------------
+
+using steady_clock = std::chrono::steady_clock;
+
+constexpr unsigned  sample_count  = 200000;   // Samples per measurement
+constexpr unsigned  repeat_count  = 5;        // Best of measurements
+constexpr unsigned  frame_count   = 240;      // Frames drawn per measurement
+
+inline double
+elapsed_ms(steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(steady_clock::now()
+                                                   - start).count();
+}
+
+inline double
+elapsed_ns(steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::nano>(steady_clock::now()
+                                                  - start).count();
+}
+
+// Keeps results of measured runs from being optimized away
+template<typename T>
+struct Sink
+{
+  static volatile T value;
+};
+
+template<typename T>
+volatile T Sink<T>::value{};
+
+template<typename T>
+inline void
+keep(T x)
+{
+  Sink<T>::value = x;
+}
+
+// Mean time in ns per item of the best of repeated runs; each run
+// returns a result, which is kept
+template<typename F>
+double
+measure(std::size_t items, F run, unsigned repeats = repeat_count)
+{
+  double best = 0.0;
+  for (unsigned r = 0; r != repeats; ++r)
+  {
+    auto start = steady_clock::now();
+    keep(run());
+    double ns = elapsed_ns(start) / items;
+    best = (r == 0) ? ns : std::min(best, ns);
+  }
+  return best;
+}
+
+// Mean time in ms per frame, calling frame(i) for frames 0 to n - 1
+template<typename F>
+double
+per_frame(unsigned n, F frame)
+{
+  auto start = steady_clock::now();
+  for (unsigned i = 0; i != n; ++i)
+  {
+    frame(i);
+  }
+  return elapsed_ms(start) / n;
+}
+
+// Line ending the output of each test
+inline void
+rule()
+{
+  std::cout << "----------------------------------------------------" << '\n';
+}
+
+// Test result line, such as "Cluster mean agreement: OK"
+inline void
+verdict(std::string const& what, bool ok)
+{
+  std::cout << what << ": " << (ok ? "OK" : "FAIL") << '\n';
+}
+
+//---------------------------------------------------------------------------
+
+// Gaze point of a synthetic scanpath
+struct GazeSample
+{
+  unsigned  time_ms;
+  float     x;
+  float     y;
+  bool      fixation;       // Point of a fixation, not a saccade
+};
+
+// Synthetic scanpath parameters
+struct Scanpath
+{
+  unsigned  seed;
+  float     x_min, x_max;   // Area of fixations
+  float     y_min, y_max;
+  int       fix_min;        // Points per fixation
+  int       fix_max;
+  float     jitter;         // Standard deviation of fixation points
+};
+
+// Synthetic 60 Hz gaze: fixations with jitter at random points of the
+// area, and saccades of 4 points between them
+inline std::vector<GazeSample>
+samples(Scanpath const& p, std::size_t n = sample_count)
+{
+  std::mt19937 rng(p.seed);
+  std::uniform_real_distribution<float> x(p.x_min, p.x_max);
+  std::uniform_real_distribution<float> y(p.y_min, p.y_max);
+  std::uniform_int_distribution<int>    fix_len(p.fix_min, p.fix_max);
+  std::normal_distribution<float>       jitter(0.0f, p.jitter);
+
+  std::vector<GazeSample> v;
+  v.reserve(n + p.fix_max + 4);
+  unsigned time_ms = 0;
+  float fx = x(rng), fy = y(rng);
+  while (v.size() < n)
+  {
+    for (int i = fix_len(rng); i != 0; --i)
+    {
+      v.push_back({ time_ms += 17, fx + jitter(rng), fy + jitter(rng),
+                    true });
+    }
+    float nx = x(rng), ny = y(rng);
+    for (int i = 1; i != 5; ++i)
+    {
+      v.push_back({ time_ms += 17, fx + (nx - fx) * i / 5,
+                                   fy + (ny - fy) * i / 5, false });
+    }
+    fx = nx;
+    fy = ny;
+  }
+  v.resize(n);
+  return v;
+}
+
+//---------------------------------------------------------------------------
+} } // eye::debug
+
+#endif // EYELIB_DEBUG_BENCHMARK_HPP
+//===========================================================================//
@@ -0,0 +1,325 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib/gaze/areas_of_interest.hpp>
+
+#include <algorithm>  // std::min, std::max, std::remove_if, std::sort
+#include <cmath>      // std::floor
+
+namespace {   //-------------------------------------------------------------
+
+// Number of cells of size cell_px over px pixels
+int
+cell_count(int px, int cell_px)
+{
+  return std::max(1, (px + cell_px - 1) / cell_px);
+}
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye {
+
+//---------------------------------------------------------------------------
+
+AreasOfInterest::AreasOfInterest(int w_px, int h_px, int cell_px)
+: w_cells_(cell_count(w_px, std::max(cell_px, 1)))
+, h_cells_(cell_count(h_px, std::max(cell_px, 1)))
+, cell_px_(float(std::max(cell_px, 1)))
+{}
+
+//---------------------------------------------------------------------------
+
+AreasOfInterest::Id
+AreasOfInterest::circle(float x, float y, float r)
+{
+  Id id = add(Shape::circle, x - r, y - r, x + r, y + r);
+  cx_.back()    = x;
+  cy_.back()    = y;
+  r_sq_.back()  = r * r;
+  return id;
+}
+
+AreasOfInterest::Id
+AreasOfInterest::rectangle(float x, float y, float w, float h)
+{
+  return add(Shape::rectangle, x, y, x + w, y + h);
+}
+
+AreasOfInterest::Id
+AreasOfInterest::polygon(std::vector<PointXY<float>> const& vertices)
+{
+  float x0 = vertices.empty() ? 0.0f : vertices[0].x;
+  float y0 = vertices.empty() ? 0.0f : vertices[0].y;
+  float x1 = x0, y1 = y0;
+  for (auto const& v : vertices)
+  {
+    x0 = std::min(x0, v.x);
+    x1 = std::max(x1, v.x);
+    y0 = std::min(y0, v.y);
+    y1 = std::max(y1, v.y);
+  }
+  Id id = add(Shape::polygon, x0, y0, x1, y1);
+  vertices_.insert(vertices_.end(), vertices.begin(), vertices.end());
+  return id;
+}
+
+bool
+AreasOfInterest::contains(Id id, PointXY<float> pt) const
+{
+  switch (shape_[id])
+  {
+    case Shape::circle:
+    {
+      float dx = pt.x - cx_[id];
+      float dy = pt.y - cy_[id];
+      return ((dx * dx) + (dy * dy)) < r_sq_[id];
+    }
+    case Shape::rectangle:
+    {
+      return (pt.x >= x0_[id]) && (pt.x < x1_[id])
+          && (pt.y >= y0_[id]) && (pt.y < y1_[id]);
+    }
+    case Shape::polygon:
+    {
+      if ((pt.x < x0_[id]) || (pt.x > x1_[id]) ||
+          (pt.y < y0_[id]) || (pt.y > y1_[id]))
+      {
+        return false;
+      }
+
+      // Even-odd rule: count edges crossed by a ray to the right
+      std::size_t first = vertex_[id];
+      std::size_t last  = (id + 1 < vertex_.size()) ? vertex_[id + 1]
+                                                    : vertices_.size();
+      if (last - first < 3) { return false; }
+
+      bool inside = false;
+      for (std::size_t i = first, j = last - 1; i != last; j = i++)
+      {
+        auto const& a = vertices_[i];
+        auto const& b = vertices_[j];
+        if (((a.y > pt.y) != (b.y > pt.y)) &&
+            (pt.x < (b.x - a.x) * (pt.y - a.y) / (b.y - a.y) + a.x))
+        {
+          inside = !inside;
+        }
+      }
+      return inside;
+    }
+    default:
+      return false;
+  }
+}
+
+std::size_t
+AreasOfInterest::size() const
+{
+  return shape_.size();
+}
+
+void
+AreasOfInterest::clear()
+{
+  for (auto* v : { &x0_, &y0_, &x1_, &y1_, &cx_, &cy_, &r_sq_ })
+  {
+    v->clear();
+  }
+  shape_.clear();
+  vertex_.clear();
+  vertices_.clear();
+  count_.clear();
+  duration_.clear();
+  interval_.clear();
+  last_time_.clear();
+  fixated_flag_.clear();
+  stamp_.clear();
+  fixated_.clear();
+  sample_   = 0;
+  indexed_  = false;
+}
+
+//---------------------------------------------------------------------------
+
+void
+AreasOfInterest::gaze(unsigned time, PointXY<float> pt, bool fixation)
+{
+  if (!indexed_) { index(); }
+  ++sample_;
+  auto const fixated_n = fixated_.size();
+
+  // Fixation within candidate areas of the cell
+  if (fixation)
+  {
+    auto c = std::size_t(cell(pt.y, h_cells_)) * w_cells_
+           + std::size_t(cell(pt.x, w_cells_));
+    for (auto i = cell_start_[c]; i != cell_start_[c + 1]; ++i)
+    {
+      Id id = cell_ids_[i];
+      if (!contains(id, pt)) { continue; }
+
+      stamp_[id] = sample_;
+      if (!fixated_flag_[id])
+      {
+        // New fixation on area
+        fixated_flag_[id] = true;
+        fixated_.push_back(id);
+        ++count_[id];
+        if (last_time_[id] != 0)
+        {
+          interval_[id] = (time - last_time_[id]);
+        }
+      }
+      else
+      {
+        // Continuing fixation
+        duration_[id] += (time - last_time_[id]);
+      }
+      last_time_[id] = time;
+    }
+  }
+
+  // Keep fixated areas in order of Id, whatever the order of fixations
+  if (fixated_.size() != fixated_n)
+  {
+    std::sort(fixated_.begin(), fixated_.end());
+  }
+
+  // End fixation of previously fixated areas not within this sample
+  auto end = std::remove_if(fixated_.begin(), fixated_.end(), [&](Id id)
+    {
+      if (stamp_[id] == sample_) { return false; }
+
+      fixated_flag_[id]  = false;
+      duration_[id]     += (time - last_time_[id]);
+      last_time_[id]     = time;
+      return true;
+    });
+  fixated_.erase(end, fixated_.end());
+}
+
+std::size_t AreasOfInterest::count(Id id) const     { return count_[id]; }
+std::size_t AreasOfInterest::duration(Id id) const  { return duration_[id]; }
+std::size_t AreasOfInterest::interval(Id id) const  { return interval_[id]; }
+bool AreasOfInterest::is_fixated(Id id) const { return fixated_flag_[id]; }
+
+std::vector<AreasOfInterest::Id> const&
+AreasOfInterest::fixated() const
+{
+  return fixated_;
+}
+
+// Round and cast to integer
+int
+AreasOfInterest::x(Id id) const
+{
+  return static_cast<int>((x0_[id] + x1_[id]) / 2 + 0.5f);
+}
+
+int
+AreasOfInterest::y(Id id) const
+{
+  return static_cast<int>((y0_[id] + y1_[id]) / 2 + 0.5f);
+}
+
+//---------------------------------------------------------------------------
+// private
+
+AreasOfInterest::Id
+AreasOfInterest::add(Shape s, float x0, float y0, float x1, float y1)
+{
+  shape_.push_back(s);
+  x0_.push_back(x0);
+  y0_.push_back(y0);
+  x1_.push_back(x1);
+  y1_.push_back(y1);
+  cx_.push_back(0);
+  cy_.push_back(0);
+  r_sq_.push_back(0);
+  vertex_.push_back(vertices_.size());
+
+  count_.push_back(0);
+  duration_.push_back(0);
+  interval_.push_back(0);
+  last_time_.push_back(0);
+  fixated_flag_.push_back(false);
+  stamp_.push_back(0);
+
+  indexed_ = false;
+  return shape_.size() - 1;
+}
+
+void
+AreasOfInterest::index()
+{
+  // Count areas per cell, then list them contiguously by cell
+  std::size_t const cells = std::size_t(w_cells_) * h_cells_;
+  cell_start_.assign(cells + 1, 0);
+  for (int pass = 0; pass != 2; ++pass)
+  {
+    for (Id id = 0; id != shape_.size(); ++id)
+    {
+      int cx0 = cell(x0_[id], w_cells_), cx1 = cell(x1_[id], w_cells_);
+      int cy0 = cell(y0_[id], h_cells_), cy1 = cell(y1_[id], h_cells_);
+      for (int cy = cy0; cy <= cy1; ++cy)
+      {
+        for (int cx = cx0; cx <= cx1; ++cx)
+        {
+          std::size_t c = std::size_t(cy) * w_cells_ + cx;
+          if (pass == 0)  { ++cell_start_[c + 1]; }
+          else            { cell_ids_[cell_start_[c]++] = id; }
+        }
+      }
+    }
+    if (pass == 0)
+    {
+      for (std::size_t c = 0; c != cells; ++c)
+      {
+        cell_start_[c + 1] += cell_start_[c];
+      }
+      cell_ids_.resize(cell_start_[cells]);
+    }
+  }
+
+  // Filling moved each start to the next, so shift them back
+  for (std::size_t c = cells; c != 0; --c)
+  {
+    cell_start_[c] = cell_start_[c - 1];
+  }
+  cell_start_[0] = 0;
+  indexed_ = true;
+}
+
+int
+AreasOfInterest::cell(float v, int cells) const
+{
+  // Nearest cell of a coordinate
+  int c = static_cast<int>(std::floor(v / cell_px_));
+  return std::min(std::max(c, 0), cells - 1);
+}
+
+//---------------------------------------------------------------------------
+
+} // eye
+//===========================================================================//
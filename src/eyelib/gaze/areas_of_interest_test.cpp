@@ -0,0 +1,205 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib.hpp>
+
+#include "debug/benchmark.hpp"  // eye::debug::measure
+
+#include <algorithm>  // std::is_sorted
+#include <iomanip>    // std::setw
+#include <iostream>   // std::cout
+#include <random>     // std::mt19937, std::normal_distribution
+#include <vector>     // std::vector
+
+namespace {   //-------------------------------------------------------------
+
+using eye::debug::measure;
+
+// Fewer samples and measurements than the other benchmarks, since a
+// Fixation per target takes microseconds per sample for 1000 targets
+constexpr unsigned  sample_count  = 100000;   // Samples per measurement
+constexpr unsigned  repeat_count  = 3;        // Best of measurements
+constexpr int       w_px          = 1920;     // Screen size
+constexpr int       h_px          = 1080;
+constexpr int       radius        = 56;       // Target fixation radius
+
+struct Sample
+{
+  unsigned            time_ms;
+  eye::PointXY<float> pt;
+  bool                fixation;
+};
+
+// Targets at random positions
+std::vector<eye::PointXY<int>>
+targets(unsigned n)
+{
+  std::mt19937 rng(n);
+  std::uniform_int_distribution<int> x(0, w_px - 1);
+  std::uniform_int_distribution<int> y(0, h_px - 1);
+
+  std::vector<eye::PointXY<int>> t(n);
+  for (auto& p : t) { p = { x(rng), y(rng) }; }
+  return t;
+}
+
+// Synthetic 60 Hz gaze: fixations near random targets, with saccades
+// between them, and points off screen
+std::vector<Sample>
+samples(std::vector<eye::PointXY<int>> const& t)
+{
+  std::mt19937 rng(17);
+  std::uniform_int_distribution<std::size_t> target(0, t.size() - 1);
+  std::uniform_int_distribution<int>  fix_len(8, 40);
+  std::normal_distribution<float>     jitter(0.0f, 20.0f);
+
+  std::vector<Sample> v;
+  v.reserve(sample_count);
+  unsigned time_ms = 0;
+  while (v.size() < sample_count)
+  {
+    auto const& p = t[target(rng)];
+    for (int i = fix_len(rng); i != 0; --i)
+    {
+      v.push_back({ time_ms += 17,
+                    { p.x + jitter(rng), p.y + jitter(rng) }, true });
+    }
+    for (int i = 0; i != 4; ++i)
+    {
+      v.push_back({ time_ms += 17,
+                    { p.x + 8 * jitter(rng), p.y + 8 * jitter(rng) },
+                    false });
+    }
+  }
+  v.resize(sample_count);
+  return v;
+}
+
+// Fixation object per target, updated per sample
+std::vector<eye::Fixation>
+fixations(std::vector<eye::PointXY<int>> const& t,
+          std::vector<Sample> const& v)
+{
+  std::vector<eye::Fixation> f;
+  for (auto const& p : t)
+  {
+    f.push_back(radius);
+    f.back().position(p.x, p.y);
+  }
+  for (auto const& s : v)
+  {
+    for (auto& x : f) { x.gaze(s.time_ms, s.pt, s.fixation); }
+  }
+  return f;
+}
+
+eye::AreasOfInterest
+areas(std::vector<eye::PointXY<int>> const& t, std::vector<Sample> const& v)
+{
+  eye::AreasOfInterest a(w_px, h_px);
+  for (auto const& p : t) { a.circle(p.x, p.y, radius); }
+  for (auto const& s : v) { a.gaze(s.time_ms, s.pt, s.fixation); }
+  return a;
+}
+
+// Compare area metrics with Fixation, and rectangles with
+// the same rectangles as polygons, with fixated areas in order of Id
+bool
+agreement(std::vector<eye::PointXY<int>> const& t,
+          std::vector<Sample> const& v)
+{
+  auto f = fixations(t, v);
+  auto a = areas(t, v);
+  for (std::size_t i = 0; i != t.size(); ++i)
+  {
+    if ((f[i].count() != a.count(i)) || (f[i].duration() != a.duration(i)) ||
+        (f[i].interval() != a.interval(i)))
+    {
+      return false;
+    }
+  }
+
+  eye::AreasOfInterest r(w_px, h_px), p(w_px, h_px);
+  for (auto const& c : t)
+  {
+    float x = c.x - 40.0f, y = c.y - 25.0f;
+    r.rectangle(x, y, 80, 50);
+    p.polygon({ { x, y }, { x + 80, y }, { x + 80, y + 50 }, { x, y + 50 } });
+  }
+  for (auto const& s : v)
+  {
+    r.gaze(s.time_ms, s.pt, s.fixation);
+    p.gaze(s.time_ms, s.pt, s.fixation);
+    auto const& f = r.fixated();
+    if ((f != p.fixated()) || !std::is_sorted(f.begin(), f.end()))
+    {
+      return false;
+    }
+  }
+  for (std::size_t i = 0; i != t.size(); ++i)
+  {
+    if ((r.count(i) != p.count(i)) || (r.duration(i) != p.duration(i)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye { namespace gaze { namespace debug {
+
+void
+aoi_benchmark()
+{
+  std::cout <<'\n'<< "eyelib: Areas of interest (" << sample_count
+            << " samples per measurement)" <<'\n'<<'\n';
+
+  bool ok = true;
+  std::cout << "                per sample (ns)" << '\n'
+            << "targets    Fixation  AreasOfInterest" << '\n'
+            << std::fixed << std::setprecision(1);
+  for (unsigned n : { 9u, 100u, 1000u })
+  {
+    auto const t = targets(n);
+    auto const v = samples(t);
+    ok = ok && agreement(t, v);
+
+    double f = measure(v.size(), [&]() { return fixations(t, v)[0].count(); },
+                       repeat_count);
+    double a = measure(v.size(), [&]() { return areas(t, v).count(0); },
+                       repeat_count);
+
+    std::cout << std::setw(7) << n << std::setw(12) << f
+              << std::setw(17) << a << '\n';
+  }
+  std::cout << '\n';
+  eye::debug::verdict("Fixation agreement", ok);
+  eye::debug::rule();
+}
+
+} } } // eye::gaze::debug
+//===========================================================================//
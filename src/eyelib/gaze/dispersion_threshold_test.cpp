@@ -0,0 +1,190 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib.hpp>
+
+#include "debug/benchmark.hpp"  // eye::debug::measure, eye::debug::samples
+
+#include <algorithm>  // std::minmax_element
+#include <deque>      // std::deque
+#include <iomanip>    // std::setw
+#include <iostream>   // std::cout
+#include <numeric>    // std::accumulate
+#include <vector>     // std::vector
+
+namespace {   //-------------------------------------------------------------
+
+using eye::debug::GazeSample;
+using eye::debug::measure;
+using eye::debug::sample_count;
+
+constexpr float     dmax          = 72.0;     // Max dispersion of points
+
+// Dispersion threshold as implemented before the ring, on deques
+class DequeThreshold
+{
+public:
+
+  DequeThreshold(unsigned pts, float dmax) : pt_min_(pts), d_max_(dmax) {}
+
+  bool
+  fixation(float x, float y)
+  {
+    x_.push_back(x);
+    y_.push_back(y);
+    if (x_.size() < pt_min_)
+    {
+      d_ = 0;
+      return false;
+    }
+    auto xe = std::minmax_element( std::begin(x_), std::end(x_) );
+    auto ye = std::minmax_element( std::begin(y_), std::end(y_) );
+    d_  = ((*xe.second - *xe.first) + (*ye.second - *ye.first));
+    if ((d_ > 0) && (d_ <= d_max_))
+    {
+      is_fix_ = true;
+      return true;
+    }
+    if (is_fix_)
+    {
+      is_fix_ = false;
+      x_.clear();
+      y_.clear();
+      x_.push_back(x);
+      y_.push_back(y);
+    }
+    else
+    {
+      x_.pop_front();
+      y_.pop_front();
+    }
+    return false;
+  }
+
+  void
+  centroid(double& x, double& y, unsigned& n) const
+  {
+    if (is_fix_)
+    {
+      n = x_.size();
+      x = std::accumulate(x_.begin(), x_.end(), 0.0) / n;
+      y = std::accumulate(y_.begin(), y_.end(), 0.0) / n;
+    }
+  }
+
+  float dispersion() const { return d_; }
+
+private:
+
+  unsigned          pt_min_;
+  float             d_max_;
+  float             d_{0};
+  bool              is_fix_{false};
+  std::deque<float> x_{};
+  std::deque<float> y_{};
+};
+
+// Compare fixation, dispersion and centroid of each point
+template<typename T>
+bool
+agreement(std::vector<GazeSample> const& v, unsigned pts, T dt)
+{
+  DequeThreshold ref{pts, dmax};
+  for (auto const& p : v)
+  {
+    if (ref.fixation(p.x, p.y) != dt.fixation(p.x, p.y)) { return false; }
+    if (ref.dispersion() != dt.dispersion())             { return false; }
+
+    double x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+    unsigned n0 = 0, n1 = 0;
+    ref.centroid(x0, y0, n0);
+    dt.centroid(x1, y1, n1);
+    if ((n0 != n1) || (x0 != x1) || (y0 != y1))          { return false; }
+  }
+  return true;
+}
+
+// Mean time per sample of the best of repeated runs from init
+template<typename T>
+double
+fixations(std::vector<GazeSample> const& v, T const& init)
+{
+  return measure(v.size(), [&]()
+    {
+      T dt = init;
+      unsigned count = 0;
+      for (auto const& p : v)
+      {
+        count += dt.fixation(p.x, p.y);
+      }
+      return count;
+    });
+}
+
+template<unsigned N>
+void
+compare(std::vector<GazeSample> const& v, bool& ok)
+{
+  DequeThreshold                  deque{N, dmax};
+  eye::DispersionThreshold        ring{N, dmax};
+  eye::DispersionThresholdN<N>    fixed{dmax};
+
+  ok = ok && agreement(v, N, ring) && agreement(v, N, fixed);
+
+  std::cout << std::setw(6) << N
+            << std::setw(12) << fixations(v, deque)
+            << std::setw(12) << fixations(v, ring)
+            << std::setw(12) << fixations(v, fixed) << '\n';
+}
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye { namespace gaze { namespace debug {
+
+void
+dispersion_benchmark()
+{
+  std::cout <<'\n'<< "eyelib: Dispersion threshold ("
+            << sample_count << " samples per measurement)" <<'\n'<<'\n';
+
+  // Fixations with jitter, and saccades between them
+  auto const v = eye::debug::samples({ 11, 100.0f, 1800.0f,
+                                           100.0f, 1800.0f, 6, 40, 6.0f });
+
+  std::cout << "                 per sample (ns)" << '\n'
+            << "   pts       deque        ring   ring<pts>" << '\n'
+            << std::fixed << std::setprecision(1);
+  bool ok = true;
+  compare<4>(v, ok);
+  compare<6>(v, ok);
+  compare<10>(v, ok);
+  compare<20>(v, ok);
+  std::cout << '\n';
+  eye::debug::verdict("Deque agreement", ok);
+  eye::debug::rule();
+}
+
+} } } // eye::gaze::debug
+//===========================================================================//
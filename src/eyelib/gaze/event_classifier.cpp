@@ -0,0 +1,284 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib/gaze/event_classifier.hpp>
+
+#include <eyelib/gaze.hpp>    // eye::Gaze
+
+#include <algorithm>  // std::min, std::max
+#include <cmath>      // std::abs
+#include <limits>     // std::numeric_limits
+#include <ostream>    // std::ostream
+
+namespace eye {
+
+//---------------------------------------------------------------------------
+
+std::string
+to_string(GazeEvent e)
+{
+  switch (e)
+  {
+    case GazeEvent::fixation: return "fixation";
+    case GazeEvent::saccade:  return "saccade";
+    case GazeEvent::blink:    return "blink";
+    case GazeEvent::gap:      return "gap";
+    default:                  return "error";
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, GazeEvent e)
+{
+  return os << to_string(e);
+}
+
+//---------------------------------------------------------------------------
+
+EventClassifier::State::State(unsigned pts)
+: x(pts, 0.0f)
+, y(pts, 0.0f)
+{}
+
+EventClassifier::EventClassifier(unsigned pts, float dmax, float vmax)
+: pts_(std::max(pts, 2u))
+, d_max_(dmax)
+, d_sq_max_(vmax * vmax)
+, state_{{ State(pts_), State(pts_) }}
+{
+  for (auto& s : state_)
+  {
+    restart(s, GazeEvent::gap);
+  }
+}
+
+//---------------------------------------------------------------------------
+
+void
+EventClassifier::update(Gaze const& g)
+{
+  // Tracking state is shared by both streams
+  auto const& t = g.tracking;
+  if (t.user && !t.eyes)
+  {
+    restart(state_[raw], GazeEvent::blink);
+    restart(state_[avg], GazeEvent::blink);
+  }
+  else if (!t.gaze)
+  {
+    restart(state_[raw], GazeEvent::gap);
+    restart(state_[avg], GazeEvent::gap);
+  }
+  else
+  {
+    classify(state_[raw], g.raw_px.x, g.raw_px.y);
+    classify(state_[avg], g.avg_px.x, g.avg_px.y);
+  }
+}
+
+EventClassifier::Sample const&
+EventClassifier::sample(Stream s) const
+{
+  return state_[s].sample;
+}
+
+GazeEvent
+EventClassifier::event(Stream s) const
+{
+  return state_[s].sample.event;
+}
+
+void
+EventClassifier::centroid(Stream s, double& x, double& y, unsigned& n) const
+{
+  State const& st = state_[s];
+  if (st.is_fix)
+  {
+    n = st.n;
+    x = st.sum_x / st.n;
+    y = st.sum_y / st.n;
+  }
+}
+
+void
+EventClassifier::clear()
+{
+  restart(state_[raw], GazeEvent::gap);
+  restart(state_[avg], GazeEvent::gap);
+}
+
+//---------------------------------------------------------------------------
+// private
+
+void
+EventClassifier::restart(State& s, GazeEvent e) const
+{
+  s.sample    = Sample{e, false, false, 0.0f, 0.0f};
+  s.head      = 0;
+  s.size      = 0;
+  s.is_fix    = false;
+  s.n         = 0;
+  s.has_last  = false;
+  s.last_x    = s.last_y = 0.0f;
+}
+
+void
+EventClassifier::classify(State& s, float x, float y) const
+{
+  s.sample.vt     = velocity(s, x, y);
+  s.sample.dt     = dispersion(s, x, y);
+  s.sample.event  = s.sample.dt ? GazeEvent::fixation : GazeEvent::saccade;
+}
+
+bool
+EventClassifier::velocity(State& s, float x, float y) const
+{
+  if (!s.has_last)
+  {
+    s.has_last  = true;
+    s.last_x    = x;
+    s.last_y    = y;
+    s.sample.displacement_sq = 0;
+    return false;
+  }
+
+  float dx  = x - s.last_x;
+  float dy  = y - s.last_y;
+  s.last_x  = x;
+  s.last_y  = y;
+  s.sample.displacement_sq = (dx * dx) + (dy * dy);
+
+  // Reject a value of zero, as it indicates invalid coordinates
+  return (s.sample.displacement_sq > 0)
+      && (s.sample.displacement_sq <= d_sq_max_);
+}
+
+// The DispersionThreshold algorithm, with the window scan skipped when the
+// current and oldest points alone exceed d_max_
+bool
+EventClassifier::dispersion(State& s, float x, float y) const
+{
+  // During a fixation, points are only added to the cluster, so its
+  // dispersion is that of its extents with the current point added
+  if (s.is_fix)
+  {
+    float x_min = std::min(s.x_min, x);
+    float x_max = std::max(s.x_max, x);
+    float y_min = std::min(s.y_min, y);
+    float y_max = std::max(s.y_max, y);
+    float d = ((x_max - x_min) + (y_max - y_min));
+    s.sample.dispersion = d;
+
+    if ((d > 0) && (d <= d_max_))
+    {
+      s.x_min = x_min;
+      s.x_max = x_max;
+      s.y_min = y_min;
+      s.y_max = y_max;
+      s.sum_x += x;
+      s.sum_y += y;
+      ++s.n;
+      return true;
+    }
+
+    // Start a new window with only the current point
+    s.is_fix  = false;
+    s.x[0]    = x;
+    s.y[0]    = y;
+    s.head    = 0;
+    s.size    = 1;
+    return false;
+  }
+
+  // Add the current point
+  unsigned tail = s.head + s.size;
+  if (tail >= pts_) { tail -= pts_; }
+  s.x[tail] = x;
+  s.y[tail] = y;
+  ++s.size;
+
+  if (s.size < pts_)
+  {
+    s.sample.dispersion = 0;
+    return false;
+  }
+
+  // The dispersion is at least the distance between the current and the
+  // oldest point along each axis, so if that exceeds the threshold, the
+  // window is not scanned
+  float const dx = x - s.x[s.head];
+  float const dy = y - s.y[s.head];
+  if ((std::abs(dx) + std::abs(dy)) > d_max_)
+  {
+    s.sample.dispersion = std::numeric_limits<float>::infinity();
+  }
+  else
+  {
+    // The window is full, so the order of points is irrelevant
+    float x_min = s.x[0], x_max = s.x[0];
+    float y_min = s.y[0], y_max = s.y[0];
+    for (unsigned i = 1; i < pts_; ++i)
+    {
+      x_min = std::min(x_min, s.x[i]);
+      x_max = std::max(x_max, s.x[i]);
+      y_min = std::min(y_min, s.y[i]);
+      y_max = std::max(y_max, s.y[i]);
+    }
+    float d = ((x_max - x_min) + (y_max - y_min));
+    s.sample.dispersion = d;
+
+    // Reject a value of zero, as it indicates invalid coordinates
+    if ((d > 0) && (d <= d_max_))
+    {
+      s.is_fix  = true;
+      s.n       = pts_;
+      s.x_min   = x_min;
+      s.x_max   = x_max;
+      s.y_min   = y_min;
+      s.y_max   = y_max;
+
+      // Sum from the oldest point, in the order points were added
+      s.sum_x = 0.0;
+      s.sum_y = 0.0;
+      for (unsigned i = 0, j = s.head; i < pts_; ++i)
+      {
+        s.sum_x += s.x[j];
+        s.sum_y += s.y[j];
+        if (++j == pts_) { j = 0; }
+      }
+      return true;
+    }
+  }
+
+  // Remove the oldest point to move the window
+  if (++s.head == pts_) { s.head = 0; }
+  --s.size;
+  return false;
+}
+
+//---------------------------------------------------------------------------
+
+} // eye
+//===========================================================================//
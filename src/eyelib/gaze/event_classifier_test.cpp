@@ -0,0 +1,258 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib.hpp>
+
+#include "debug/benchmark.hpp"  // eye::debug::measure, eye::debug::samples
+
+#include <array>      // std::array
+#include <cmath>      // std::abs, std::isinf
+#include <iomanip>    // std::setw
+#include <iostream>   // std::cout
+#include <random>     // std::mt19937, std::uniform_int_distribution
+#include <vector>     // std::vector
+
+namespace {   //-------------------------------------------------------------
+
+using eye::debug::measure;
+using eye::debug::sample_count;
+using Stream = eye::EventClassifier::Stream;
+
+// Parameters of the eyelib-test gaze metrics
+constexpr unsigned  DTN = 10;     // Number of points in moving window
+constexpr float     DTD = 72.0;   // Max dispersion of points
+constexpr float     VTD = 10.0;   // Max displacement between points
+
+// Synthetic 60 Hz gaze: the scanpath, with blinks and tracking gaps
+// after some fixations; the smoothed point follows the raw point
+std::vector<eye::Gaze>
+samples()
+{
+  auto const path = eye::debug::samples({ 42, 100.0f, 1800.0f,
+                                              100.0f, 1800.0f, 12, 30, 2.0f });
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> event(0, 19);
+
+  std::vector<eye::Gaze> v;
+  v.reserve(sample_count);
+
+  eye::Gaze g;
+  unsigned time_ms = 0;
+  float avg_x = path[0].x, avg_y = path[0].y;
+  auto add = [&](unsigned bits, float rx, float ry)
+    {
+      g.time_ms   = (time_ms += 17);
+      g.tracking  = eye::Gaze::Tracking(bits);
+      g.raw_px    = { rx, ry };
+      if (bits & 0x01)
+      {
+        avg_x += 0.3f * (rx - avg_x);
+        avg_y += 0.3f * (ry - avg_y);
+        g.avg_px = { avg_x, avg_y };
+      }
+      else
+      {
+        g.raw_px = g.avg_px = { 0.0f, 0.0f };
+      }
+      v.push_back(g);
+    };
+
+  for (std::size_t i = 0; v.size() < sample_count; ++i)
+  {
+    add(0x07, path[i].x, path[i].y);
+
+    // Occasional blink or tracking gap at the end of a fixation
+    if (path[i].fixation && (i + 1 != path.size()) && !path[i + 1].fixation)
+    {
+      int e = event(rng);
+      if (e == 0)       { for (int k = 0; k != 8; ++k) { add(0x04, 0, 0); } }
+      else if (e == 1)  { for (int k = 0; k != 2; ++k) { add(0x18, 0, 0); } }
+    }
+  }
+  v.resize(sample_count);
+  return v;
+}
+
+// Sum of parts, as fed by the gaze metrics: one DT and one VT object
+// receive the raw then the smoothed point, and blinks are checked apart
+double
+shared_detectors(std::vector<eye::Gaze> const& v)
+{
+  return measure(v.size(), [&v]()
+    {
+      unsigned count = 0;
+      eye::DispersionThreshold  dt{DTN, DTD};
+      eye::VelocityThreshold    vt{VTD};
+      for (auto const& g : v)
+      {
+        count += !g.tracking.eyes;
+        count += dt.fixation(g.raw_px.x, g.raw_px.y);
+        count += vt.fixation(g.raw_px.x, g.raw_px.y);
+        count += dt.fixation(g.avg_px.x, g.avg_px.y);
+        count += vt.fixation(g.avg_px.x, g.avg_px.y);
+      }
+      return count;
+    });
+}
+
+// Separate DT and VT objects per stream, restarted on each blink or gap,
+// with the same events as the classifier: the separate updates it replaces
+double
+separate_detectors(std::vector<eye::Gaze> const& v)
+{
+  return measure(v.size(), [&v]()
+    {
+      unsigned count = 0;
+      eye::DispersionThreshold  dt_raw{DTN, DTD}, dt_avg{DTN, DTD};
+      eye::VelocityThreshold    vt_raw{VTD},      vt_avg{VTD};
+      for (auto const& g : v)
+      {
+        bool const blink = g.tracking.user && !g.tracking.eyes;
+        if (blink || !g.tracking.gaze)
+        {
+          dt_raw.clear();
+          dt_avg.clear();
+          vt_raw = eye::VelocityThreshold{VTD};
+          vt_avg = eye::VelocityThreshold{VTD};
+          count += blink ? 4 : 6;   // Blink or gap in both streams
+          continue;
+        }
+        count += vt_raw.fixation(g.raw_px.x, g.raw_px.y);
+        count += dt_raw.fixation(g.raw_px.x, g.raw_px.y) ? 0 : 1;
+        count += vt_avg.fixation(g.avg_px.x, g.avg_px.y);
+        count += dt_avg.fixation(g.avg_px.x, g.avg_px.y) ? 0 : 1;
+      }
+      return count;
+    });
+}
+
+double
+classifier(std::vector<eye::Gaze> const& v)
+{
+  return measure(v.size(), [&v]()
+    {
+      unsigned count = 0;
+      eye::EventClassifier events{DTN, DTD, VTD};
+      for (auto const& g : v)
+      {
+        events.update(g);
+        count += unsigned(events.event(eye::EventClassifier::raw));
+        count += unsigned(events.event(eye::EventClassifier::avg));
+      }
+      return count;
+    });
+}
+
+// Compare with separate DT and VT objects per stream, restarted on each
+// blink or gap, and count events
+bool
+agreement(std::vector<eye::Gaze> const& v,
+          std::array<std::array<unsigned,4>,2>& events)
+{
+  eye::EventClassifier ec{DTN, DTD, VTD};
+  std::array<eye::DispersionThreshold,2>  dt{{ {DTN, DTD}, {DTN, DTD} }};
+  std::array<eye::VelocityThreshold,2>    vt{{ {VTD}, {VTD} }};
+
+  for (auto& e : events) { e.fill(0); }
+
+  bool ok = true;
+  for (auto const& g : v)
+  {
+    ec.update(g);
+    for (auto s : { Stream::raw, Stream::avg })
+    {
+      auto const& sample = ec.sample(s);
+      ++events[s][unsigned(sample.event)];
+
+      bool valid = g.tracking.gaze && !(g.tracking.user && !g.tracking.eyes);
+      if (!valid)
+      {
+        dt[s] = eye::DispersionThreshold{DTN, DTD};
+        vt[s] = eye::VelocityThreshold{VTD};
+        ok = ok && !sample.dt && !sample.vt;
+        continue;
+      }
+      auto const& p = (s == Stream::raw) ? g.raw_px : g.avg_px;
+      ok = ok && (dt[s].fixation(p.x, p.y) == sample.dt);
+      ok = ok && (vt[s].fixation(p.x, p.y) == sample.vt);
+      ok = ok && ((dt[s].dispersion() == sample.dispersion)
+                  || (std::isinf(sample.dispersion)
+                      && (dt[s].dispersion() > DTD)));
+
+      double x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+      unsigned n0 = 0, n1 = 0;
+      dt[s].centroid(x0, y0, n0);
+      ec.centroid(s, x1, y1, n1);
+      ok = ok && (n0 == n1) && (std::abs(x0 - x1) < 1e-3)
+                            && (std::abs(y0 - y1) < 1e-3);
+    }
+  }
+  return ok;
+}
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye { namespace gaze { namespace debug {
+
+void
+classifier_benchmark()
+{
+  std::cout <<'\n'<< "eyelib: Gaze event classification ("
+            << sample_count << " samples per measurement)" <<'\n'<<'\n';
+
+  auto const v = samples();
+
+  std::array<std::array<unsigned,4>,2> events;
+  bool const ok = agreement(v, events);
+  eye::debug::verdict("DT and VT agreement", ok);
+  std::cout <<'\n';
+
+  std::cout << "stream    fixation   saccade     blink       gap" << '\n';
+  for (auto s : { Stream::raw, Stream::avg })
+  {
+    std::cout << std::left << std::setw(6)
+              << (s == Stream::raw ? "raw" : "avg") << std::right;
+    for (auto n : events[s]) { std::cout << std::setw(10) << n; }
+    std::cout << '\n';
+  }
+  std::cout <<'\n';
+
+  double const shared   = shared_detectors(v);
+  double const separate = separate_detectors(v);
+  double const unified  = classifier(v);
+
+  std::cout << "detectors                         per sample" << '\n'
+            << std::fixed << std::setprecision(1)
+            << "shared DT/VT, raw then avg    " << std::setw(10) << shared
+            << " ns" << '\n'
+            << "DT/VT per stream, restarted   " << std::setw(10) << separate
+            << " ns" << '\n'
+            << "EventClassifier               " << std::setw(10) << unified
+            << " ns" << '\n';
+  eye::debug::rule();
+}
+
+} } } // eye::gaze::debug
+//===========================================================================//
@@ -0,0 +1,464 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib/gaze/fixation_sweep.hpp>
+
+#include <eyelib/gaze.hpp>    // eye::Gaze
+
+#include <algorithm>  // std::find, std::min, std::max
+#include <iomanip>    // std::setw, std::setprecision
+#include <limits>     // std::numeric_limits
+#include <ostream>    // std::ostream
+#include <thread>     // std::thread
+
+namespace {   //-------------------------------------------------------------
+
+// Minimum configurations per thread, below which threads cost more
+// than they save
+constexpr std::size_t min_chunk = 16;
+
+constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+char const*
+method_name(eye::FixationSweep::Method m)
+{
+  switch (m)
+  {
+    case eye::FixationSweep::Method::dt:  return "DT";
+    case eye::FixationSweep::Method::vt:  return "VT";
+    default:                              return "error";
+  }
+}
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye {
+
+//---------------------------------------------------------------------------
+
+struct FixationSweep::Shared
+{
+  std::vector<std::size_t>        index;    // Valid point of sample, or npos
+  std::vector<unsigned>           pts;      // Distinct DT window sizes
+  std::vector<std::vector<float>> extents;  // Per window size, per point:
+                                            // x_min, x_max, y_min, y_max
+  std::vector<float>              d_sq;     // Displacement squared
+  std::vector<unsigned char>      inside;   // Per sample, per target
+};
+
+//---------------------------------------------------------------------------
+
+FixationSweep::FixationSweep(Targets const& targets, int radius)
+: targets_(targets)
+, radius_sq_(float(radius) * radius)
+{}
+
+void
+FixationSweep::add(Gaze const& g, Target const& t)
+{
+  time_ms_.push_back(g.time_ms);
+  x_.push_back(g.avg_px.x);
+  y_.push_back(g.avg_px.y);
+  fix_.push_back(g.fixation);
+  active_.push_back(t.active);
+}
+
+void
+FixationSweep::dispersion(std::vector<unsigned> const& pts,
+                          std::vector<float> const& dmax)
+{
+  for (auto p : pts)
+  {
+    for (auto d : dmax)
+    {
+      configs_.push_back(Config{Method::dt, p, d});
+    }
+  }
+}
+
+void
+FixationSweep::velocity(std::vector<float> const& dmax)
+{
+  for (auto d : dmax)
+  {
+    configs_.push_back(Config{Method::vt, 0, d});
+  }
+}
+
+FixationSweep::Configs const&
+FixationSweep::configs() const
+{
+  return configs_;
+}
+
+std::size_t
+FixationSweep::size() const
+{
+  return time_ms_.size();
+}
+
+void
+FixationSweep::clear()
+{
+  configs_.clear();
+  time_ms_.clear();
+  x_.clear();
+  y_.clear();
+  fix_.clear();
+  active_.clear();
+}
+
+//---------------------------------------------------------------------------
+
+FixationSweep::Results
+FixationSweep::run(unsigned threads) const
+{
+  Results results(configs_.size());
+  if (configs_.empty()) { return results; }
+
+  //-----------------------------------------------------------
+  // Shared per-sample values
+
+  Shared sh;
+  std::size_t const n = time_ms_.size();
+  std::size_t const tn = targets_.size();
+
+  // Valid points: reject a zero coordinate as a potential blink
+  std::vector<float> vx;
+  std::vector<float> vy;
+  sh.index.assign(n, npos);
+  for (std::size_t i = 0; i != n; ++i)
+  {
+    if ((x_[i] != 0) && (y_[i] != 0))
+    {
+      sh.index[i] = vx.size();
+      vx.push_back(x_[i]);
+      vy.push_back(y_[i]);
+    }
+  }
+  std::size_t const vn = vx.size();
+
+  // Extents of the last pts points, for each distinct DT window size
+  for (auto const& c : configs_)
+  {
+    if ((c.method == Method::dt) &&
+        (std::find(sh.pts.begin(), sh.pts.end(), c.pts) == sh.pts.end()))
+    {
+      sh.pts.push_back(c.pts);
+    }
+  }
+  sh.extents.resize(sh.pts.size());
+  for (std::size_t w = 0; w != sh.pts.size(); ++w)
+  {
+    std::size_t const p = sh.pts[w] ? sh.pts[w] : 1;
+    auto& e = sh.extents[w];
+    e.assign(4 * vn, 0.0f);
+    for (std::size_t k = p - 1; k < vn; ++k)
+    {
+      float x_min = vx[k], x_max = vx[k], y_min = vy[k], y_max = vy[k];
+      for (std::size_t j = k + 1 - p; j != k; ++j)
+      {
+        x_min = std::min(x_min, vx[j]);
+        x_max = std::max(x_max, vx[j]);
+        y_min = std::min(y_min, vy[j]);
+        y_max = std::max(y_max, vy[j]);
+      }
+      e[4*k]     = x_min;
+      e[4*k + 1] = x_max;
+      e[4*k + 2] = y_min;
+      e[4*k + 3] = y_max;
+    }
+  }
+
+  // Displacement squared from the last point
+  sh.d_sq.assign(vn, 0.0f);
+  for (std::size_t k = 1; k < vn; ++k)
+  {
+    float dx = vx[k] - vx[k-1];
+    float dy = vy[k] - vy[k-1];
+    sh.d_sq[k] = (dx * dx) + (dy * dy);
+  }
+
+  // Targets within the fixation radius while a target is active
+  sh.inside.assign(n * tn, 0);
+  for (std::size_t i = 0; i != n; ++i)
+  {
+    if (!active_[i]) { continue; }
+    for (std::size_t t = 0; t != tn; ++t)
+    {
+      float dx = x_[i] - targets_[t].x_px;
+      float dy = y_[i] - targets_[t].y_px;
+      sh.inside[i*tn + t] = ((dx * dx) + (dy * dy)) < radius_sq_;
+    }
+  }
+
+  //-----------------------------------------------------------
+  // Configurations, in chunks per thread
+
+  std::size_t const cn = configs_.size();
+  std::size_t tc = threads ? threads : std::thread::hardware_concurrency();
+  tc = std::max<std::size_t>(1, std::min(tc, cn / min_chunk));
+  std::size_t const chunk = (cn + tc - 1) / tc;
+
+  std::vector<std::thread> pool;
+  for (std::size_t b = chunk; b < cn; b += chunk)
+  {
+    pool.emplace_back([this, &sh, &results, b, chunk, cn]()
+      {
+        sweep(sh, b, std::min(b + chunk, cn), results.data() + b);
+      });
+  }
+  sweep(sh, 0, std::min(chunk, cn), results.data());
+  for (auto& t : pool) { t.join(); }
+
+  return results;
+}
+
+//---------------------------------------------------------------------------
+// private
+
+void
+FixationSweep::sweep(Shared const& sh, std::size_t begin, std::size_t end,
+                     Result* out) const
+{
+  std::size_t const cn = end - begin;
+  std::size_t const tn = targets_.size();
+
+  // Detector state, per configuration
+  std::vector<std::size_t>    dt;         // DT configurations
+  std::vector<std::size_t>    vt;         // VT configurations
+  std::vector<std::size_t>    window(cn); // Index of DT window size
+  std::vector<std::size_t>    pts(cn);
+  std::vector<float>          d_max(cn);  // DT dispersion, VT squared
+  std::vector<std::size_t>    start(cn, 0);   // First point of DT window
+  std::vector<unsigned char>  is_fix(cn, 0);  // DT fixation cluster
+  std::vector<float>          x_min(cn), x_max(cn), y_min(cn), y_max(cn);
+
+  for (std::size_t j = 0; j != cn; ++j)
+  {
+    auto const& c = configs_[begin + j];
+    if (c.method == Method::dt)
+    {
+      dt.push_back(j);
+      window[j] = std::find(sh.pts.begin(), sh.pts.end(), c.pts)
+                - sh.pts.begin();
+      pts[j]    = c.pts ? c.pts : 1;
+      d_max[j]  = c.dmax;
+    }
+    else
+    {
+      vt.push_back(j);
+      d_max[j]  = c.dmax * c.dmax;
+    }
+  }
+
+  // Metrics, per configuration
+  std::vector<unsigned char>  flag(cn, 0);
+  std::vector<std::size_t>    agree(cn, 0);
+  std::vector<std::size_t>    fixations(cn, 0);
+  std::vector<std::size_t>    duration(cn, 0);
+  std::vector<unsigned char>  in_fix(cn, 0);
+  std::vector<unsigned>       fix_start(cn, 0);
+
+  // Target metrics, per target and configuration
+  std::vector<std::size_t>    t_count(tn * cn, 0);
+  std::vector<std::size_t>    t_duration(tn * cn, 0);
+  std::vector<std::size_t>    t_interval(tn * cn, 0);
+  std::vector<unsigned char>  t_fixated(tn * cn, 0);
+  std::vector<unsigned>       t_last(tn * cn, 0);
+
+  std::size_t const n = time_ms_.size();
+  for (std::size_t i = 0; i != n; ++i)
+  {
+    unsigned const time = time_ms_[i];
+    std::size_t const k = sh.index[i];
+
+    if (k == npos)
+    {
+      std::fill(flag.begin(), flag.end(), 0);
+    }
+    else
+    {
+      float const x = x_[i];
+      float const y = y_[i];
+
+      for (auto j : dt)
+      {
+        if (is_fix[j])
+        {
+          // Extend the fixation cluster extents by the new point
+          float x0 = std::min(x_min[j], x);
+          float x1 = std::max(x_max[j], x);
+          float y0 = std::min(y_min[j], y);
+          float y1 = std::max(y_max[j], y);
+          float d  = (x1 - x0) + (y1 - y0);
+          if ((d > 0) && (d <= d_max[j]))
+          {
+            x_min[j] = x0;  x_max[j] = x1;
+            y_min[j] = y0;  y_max[j] = y1;
+            flag[j]  = 1;
+          }
+          else
+          {
+            is_fix[j] = 0;    // New window with only the current point
+            start[j]  = k;
+            flag[j]   = 0;
+          }
+        }
+        else if (k + 1 - start[j] < pts[j])
+        {
+          flag[j] = 0;        // Window not yet filled
+        }
+        else
+        {
+          // Window holds exactly the last pts points
+          float const* e = &sh.extents[window[j]][4*k];
+          float d = (e[1] - e[0]) + (e[3] - e[2]);
+          if ((d > 0) && (d <= d_max[j]))
+          {
+            is_fix[j] = 1;
+            x_min[j]  = e[0];  x_max[j] = e[1];
+            y_min[j]  = e[2];  y_max[j] = e[3];
+            flag[j]   = 1;
+          }
+          else
+          {
+            ++start[j];       // Move the window
+            flag[j] = 0;
+          }
+        }
+      }
+
+      float const d_sq = sh.d_sq[k];
+      bool const moved = (k != 0) && (d_sq > 0);
+      for (auto j : vt)
+      {
+        flag[j] = moved && (d_sq <= d_max[j]);
+      }
+    }
+
+    // Agreement, and fixation count and duration
+    unsigned char const et = fix_[i];
+    for (std::size_t j = 0; j != cn; ++j)
+    {
+      agree[j] += (flag[j] == et);
+    }
+    for (std::size_t j = 0; j != cn; ++j)
+    {
+      if (flag[j] && !in_fix[j])
+      {
+        in_fix[j]    = 1;
+        fix_start[j] = time;
+        ++fixations[j];
+      }
+      else if (!flag[j] && in_fix[j])
+      {
+        in_fix[j]    = 0;
+        duration[j] += time - fix_start[j];
+      }
+    }
+
+    // Fixation on each target, as computed by Fixation::gaze
+    if (!active_[i]) { continue; }
+    for (std::size_t t = 0; t != tn; ++t)
+    {
+      bool const inside = sh.inside[i*tn + t];
+      std::size_t const o = t * cn;
+      for (std::size_t j = 0; j != cn; ++j)
+      {
+        if (flag[j] && inside)
+        {
+          if (!t_fixated[o+j])
+          {
+            t_fixated[o+j] = 1;
+            ++t_count[o+j];
+            if (t_last[o+j] != 0) { t_interval[o+j] = time - t_last[o+j]; }
+          }
+          else
+          {
+            t_duration[o+j] += time - t_last[o+j];
+          }
+          t_last[o+j] = time;
+        }
+        else if (t_fixated[o+j])
+        {
+          t_fixated[o+j] = 0;
+          t_duration[o+j] += time - t_last[o+j];
+          t_last[o+j] = time;
+        }
+      }
+    }
+  }
+
+  // Results
+  unsigned const last = n ? time_ms_[n-1] : 0;
+  for (std::size_t j = 0; j != cn; ++j)
+  {
+    if (in_fix[j]) { duration[j] += last - fix_start[j]; }
+
+    Result& r     = out[j];
+    r.config      = configs_[begin + j];
+    r.agreement   = n ? float(agree[j]) / n : 0.0f;
+    r.fixations   = fixations[j];
+    r.duration_ms = fixations[j] ? float(duration[j]) / fixations[j] : 0.0f;
+    r.targets.resize(tn);
+    for (std::size_t t = 0; t != tn; ++t)
+    {
+      r.targets[t] = TargetMetrics{ t_count[t*cn + j],
+                                    t_duration[t*cn + j],
+                                    t_interval[t*cn + j] };
+    }
+  }
+}
+
+//---------------------------------------------------------------------------
+
+std::ostream&
+operator<<(std::ostream& os, FixationSweep::Results const& r)
+{
+  os <<   "method  pts    dmax  agreement  fixations  duration"
+     << "\n                                           (ms)"
+     << "\n-------------------------------------------------------";
+  for (auto const& x : r)
+  {
+    os << '\n' << std::left << std::setw(6) << method_name(x.config.method)
+       << std::right << std::setw(5);
+    if (x.config.method == FixationSweep::Method::dt) { os << x.config.pts; }
+    else                                              { os << ""; }
+    os << std::fixed << std::setprecision(1)
+       << std::setw(8)  << x.config.dmax
+       << std::setprecision(4)
+       << std::setw(11) << x.agreement
+       << std::setw(11) << x.fixations
+       << std::setprecision(1)
+       << std::setw(10) << x.duration_ms;
+  }
+  return os;
+}
+
+//---------------------------------------------------------------------------
+
+} // eye
+//===========================================================================//
@@ -0,0 +1,262 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib.hpp>
+
+#include "debug/benchmark.hpp"  // eye::debug::elapsed_ms
+
+#include <algorithm>  // std::max
+#include <iomanip>    // std::setw
+#include <iostream>   // std::cout
+#include <random>     // std::mt19937, std::normal_distribution
+#include <string>     // std::to_string
+#include <thread>     // std::thread::hardware_concurrency
+#include <vector>     // std::vector
+
+namespace {   //-------------------------------------------------------------
+
+using eye::debug::elapsed_ms;
+using eye::debug::steady_clock;
+using Method = eye::FixationSweep::Method;
+
+constexpr unsigned  sample_count  = 50000;  // Samples in session
+constexpr int       radius        = 56;     // Target fixation radius
+
+// 3 x 3 targets on a 1920 x 1080 screen
+eye::Targets
+targets()
+{
+  eye::Targets t;
+  for (int y : { 180, 540, 900 })
+  {
+    for (int x : { 320, 960, 1600 })
+    {
+      t.push_back(eye::Target{x, y, false});
+    }
+  }
+  return t;
+}
+
+// Synthetic 60 Hz session: each target is active in turn, and gaze
+// fixates near it, with saccades, wandering and dropped points
+void
+record(eye::FixationSweep& sweep, std::vector<eye::Gaze>& gaze,
+       std::vector<eye::Target>& shown)
+{
+  auto const tg = targets();
+  std::mt19937 rng(7);
+  std::normal_distribution<float>     jitter(0.0f, 3.0f);
+  std::uniform_int_distribution<int>  offset(-60, 60);
+  std::uniform_int_distribution<int>  fix_len(8, 40);
+  std::uniform_int_distribution<int>  event(0, 9);
+
+  eye::Gaze g;
+  unsigned time_ms = 0;
+  float x = 960, y = 540;
+  for (std::size_t i = 0; gaze.size() < sample_count; ++i)
+  {
+    eye::Target t = tg[i % tg.size()];
+    t.active = (i % 3) != 0;
+    float tx = float(t.x_px + offset(rng));
+    float ty = float(t.y_px + offset(rng));
+
+    // Saccade to the target, then fixation with tracker flag
+    for (int s = 1; s != 5; ++s)
+    {
+      g.time_ms  = (time_ms += 17);
+      g.fixation = false;
+      g.avg_px   = { x + (tx - x) * s / 5, y + (ty - y) * s / 5 };
+      gaze.push_back(g);
+      shown.push_back(t);
+    }
+    x = tx;
+    y = ty;
+    for (int f = fix_len(rng); f != 0; --f)
+    {
+      int e = event(rng);
+      g.time_ms  = (time_ms += (e == 0) ? 34 : 17);   // Dropped frame
+      g.fixation = (e != 1);
+      g.avg_px   = (e == 2) ? eye::PointXY<float>{ 0.0f, 0.0f }
+                            : eye::PointXY<float>{ x + jitter(rng),
+                                                   y + jitter(rng) };
+      gaze.push_back(g);
+      shown.push_back(t);
+    }
+  }
+  for (std::size_t i = 0; i != gaze.size(); ++i)
+  {
+    sweep.add(gaze[i], shown[i]);
+  }
+}
+
+// Results of one configuration, with a detector object per configuration
+eye::FixationSweep::Result
+reference(eye::FixationSweep::Config const& c,
+          std::vector<eye::Gaze> const& gaze,
+          std::vector<eye::Target> const& shown)
+{
+  eye::DispersionThreshold dt{c.pts, c.dmax};
+  eye::VelocityThreshold   vt{c.dmax};
+
+  std::vector<eye::Fixation> fixations;
+  for (auto const& t : targets())
+  {
+    fixations.push_back(radius);
+    fixations.back().position(t.x_px, t.y_px);
+  }
+
+  std::size_t agree = 0, count = 0, duration = 0;
+  unsigned start = 0;
+  bool in_fix = false;
+  for (std::size_t i = 0; i != gaze.size(); ++i)
+  {
+    auto const& g = gaze[i];
+    bool fix = false;
+    if ((g.avg_px.x != 0) && (g.avg_px.y != 0))
+    {
+      fix = (c.method == Method::dt) ? dt.fixation(g.avg_px.x, g.avg_px.y)
+                                     : vt.fixation(g.avg_px.x, g.avg_px.y);
+    }
+    agree += (fix == g.fixation);
+    if (fix && !in_fix)       { in_fix = true;  start = g.time_ms; ++count; }
+    else if (!fix && in_fix)  { in_fix = false; duration += g.time_ms - start; }
+
+    if (shown[i].active)
+    {
+      for (auto& f : fixations) { f.gaze(g.time_ms, g.avg_px, fix); }
+    }
+  }
+  if (in_fix) { duration += gaze.back().time_ms - start; }
+
+  eye::FixationSweep::Result r;
+  r.config      = c;
+  r.agreement   = float(agree) / gaze.size();
+  r.fixations   = count;
+  r.duration_ms = count ? float(duration) / count : 0.0f;
+  for (auto const& f : fixations)
+  {
+    r.targets.push_back({ f.count(), f.duration(), f.interval() });
+  }
+  return r;
+}
+
+bool
+equal(eye::FixationSweep::Result const& a, eye::FixationSweep::Result const& b)
+{
+  if ((a.agreement != b.agreement) || (a.fixations != b.fixations) ||
+      (a.duration_ms != b.duration_ms) ||
+      (a.targets.size() != b.targets.size()))
+  {
+    return false;
+  }
+  for (std::size_t t = 0; t != a.targets.size(); ++t)
+  {
+    if ((a.targets[t].count       != b.targets[t].count) ||
+        (a.targets[t].duration_ms != b.targets[t].duration_ms) ||
+        (a.targets[t].interval_ms != b.targets[t].interval_ms))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye { namespace gaze { namespace debug {
+
+void
+sweep_benchmark()
+{
+  eye::FixationSweep sweep(targets(), radius);
+  std::vector<eye::Gaze>    gaze;
+  std::vector<eye::Target>  shown;
+  record(sweep, gaze, shown);
+
+  // 10 x 12 DT and 20 VT configurations
+  std::vector<unsigned> pts;
+  std::vector<float>    dt_dmax;
+  std::vector<float>    vt_dmax;
+  for (unsigned p = 3; p != 13; ++p)  { pts.push_back(p); }
+  for (int d = 20; d <= 75; d += 5)   { dt_dmax.push_back(float(d)); }
+  for (int d = 1; d <= 20; ++d)       { vt_dmax.push_back(float(d)); }
+  sweep.dispersion(pts, dt_dmax);
+  sweep.velocity(vt_dmax);
+  auto const& configs = sweep.configs();
+
+  std::cout <<'\n'<< "eyelib: Fixation parameter sweep (" << configs.size()
+            << " configurations, " << sweep.size() << " samples)" <<'\n'<<'\n';
+
+  // Reference: one pass per configuration
+  auto start = steady_clock::now();
+  eye::FixationSweep::Results expected;
+  for (auto const& c : configs)
+  {
+    expected.push_back(reference(c, gaze, shown));
+  }
+  double const ref_ms = elapsed_ms(start);
+
+  start = steady_clock::now();
+  auto const single = sweep.run(1);
+  double const single_ms = elapsed_ms(start);
+
+  unsigned const tc = std::max(2u, std::thread::hardware_concurrency());
+  start = steady_clock::now();
+  auto const multi = sweep.run(tc);
+  double const multi_ms = elapsed_ms(start);
+
+  bool ok = (single.size() == expected.size())
+         && (multi.size() == expected.size());
+  for (std::size_t i = 0; ok && (i != expected.size()); ++i)
+  {
+    ok = equal(single[i], expected[i]) && equal(multi[i], expected[i]);
+  }
+  eye::debug::verdict("DT, VT and Fixation agreement", ok);
+  std::cout <<'\n';
+
+  // Best configurations of each method
+  eye::FixationSweep::Results best(2);
+  for (auto const& r : single)
+  {
+    auto& b = best[r.config.method == Method::dt ? 0 : 1];
+    if (r.agreement > b.agreement) { b = r; }
+  }
+  std::cout << best <<'\n'<<'\n';
+
+  std::cout << "method                          total" << '\n'
+            << std::fixed << std::setprecision(1)
+            << "one pass per configuration " << std::setw(10) << ref_ms
+            << " ms" << '\n'
+            << "sweep, 1 thread            " << std::setw(10) << single_ms
+            << " ms" << '\n'
+            << "sweep, " << std::left << std::setw(20)
+            << (std::to_string(tc) + " threads") << std::right
+            << std::setw(10) << multi_ms
+            << " ms" << '\n';
+  eye::debug::rule();
+}
+
+} } } // eye::gaze::debug
+//===========================================================================//
@@ -0,0 +1,290 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib/gaze/heatmap.hpp>
+
+#include <algorithm>  // std::fill, std::max, std::min
+#include <array>      // std::array
+#include <cmath>      // std::ceil, std::exp, std::exp2, std::floor, std::isfinite
+#include <cstdint>    // std::uint32_t
+#include <cstring>    // std::memcpy
+#include <sstream>    // std::istringstream
+#include <stdexcept>  // std::exception
+#include <string>     // std::string, std::getline, std::stod
+
+namespace {   //-------------------------------------------------------------
+
+// Rescale cells when the decay factor falls below this value
+constexpr double min_scale = 1e-12;
+
+// Color map: transparent blue through cyan, green and yellow to opaque red
+std::array<std::uint32_t, 256>
+make_palette()
+{
+  struct Stop { float v, r, g, b, a; };
+  Stop const stops[] = {
+    { 0.00f,   0,   0, 255,  64 },
+    { 0.25f,   0, 255, 255, 112 },
+    { 0.50f,   0, 255,   0, 160 },
+    { 0.75f, 255, 255,   0, 208 },
+    { 1.00f, 255,   0,   0, 255 }};
+
+  std::array<std::uint32_t, 256> palette{};
+  for (unsigned i = 1; i != palette.size(); ++i)  // Entry 0 is transparent
+  {
+    float v = i / 255.0f;
+    unsigned s = 1;
+    while (stops[s].v < v) { ++s; }
+    Stop const& a = stops[s-1];
+    Stop const& b = stops[s];
+    float f = (v - a.v) / (b.v - a.v);
+    unsigned char rgba[4] = {
+      static_cast<unsigned char>(a.r + f * (b.r - a.r) + 0.5f),
+      static_cast<unsigned char>(a.g + f * (b.g - a.g) + 0.5f),
+      static_cast<unsigned char>(a.b + f * (b.b - a.b) + 0.5f),
+      static_cast<unsigned char>(a.a + f * (b.a - a.a) + 0.5f) };
+    std::memcpy(&palette[i], rgba, sizeof(rgba));   // Byte order of RGBA
+  }
+  return palette;
+}
+
+std::array<std::uint32_t, 256> const palette = make_palette();
+
+// Return index of named column in CSV header, or -1 if not found
+int
+column(std::string const& header, std::string const& name)
+{
+  std::istringstream iss(header);
+  std::string field;
+  for (int i = 0; std::getline(iss, field, ','); ++i)
+  {
+    if (field == name) { return i; }
+  }
+  return -1;
+}
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye {
+
+//---------------------------------------------------------------------------
+
+Heatmap::Heatmap(unsigned w_px, unsigned h_px, unsigned cell_px,
+                 float sigma_px, unsigned half_life_ms)
+: cols_((w_px + cell_px - 1) / cell_px)
+, rows_((h_px + cell_px - 1) / cell_px)
+, cell_px_(cell_px)
+, half_life_ms_(half_life_ms)
+, radius_(static_cast<int>(std::ceil(3 * sigma_px / cell_px)))
+, cells_(static_cast<std::size_t>(cols_) * rows_, 0.0f)
+{
+  // Gaussian sampled at cell centers, normalized to sum to one
+  float sum = 0.0f;
+  for (int i = -radius_; i <= radius_; ++i)
+  {
+    float d = static_cast<float>(i * static_cast<int>(cell_px)) / sigma_px;
+    kernel_.push_back(std::exp(-0.5f * d * d));
+    sum += kernel_.back();
+  }
+  for (auto& k : kernel_) { k /= sum; }
+}
+
+void
+Heatmap::add(float x_px, float y_px, unsigned time_ms)
+{
+  if (!std::isfinite(x_px) || !std::isfinite(y_px)) { return; }
+  decay(time_ms);
+
+  // Kernel rows and columns that fall on the grid
+  int cx = static_cast<int>(std::floor(x_px / cell_px_));
+  int cy = static_cast<int>(std::floor(y_px / cell_px_));
+  int c0 = std::max(cx - radius_, 0);
+  int c1 = std::min(cx + radius_, static_cast<int>(cols_) - 1);
+  int r0 = std::max(cy - radius_, 0);
+  int r1 = std::min(cy + radius_, static_cast<int>(rows_) - 1);
+  if ((c0 > c1) || (r0 > r1)) { return; }   // Entirely off screen
+
+  float const weight = static_cast<float>(1.0 / scale_);
+  float const* kx = &kernel_[c0 - (cx - radius_)];
+  float peak = max_;
+  for (int r = r0; r <= r1; ++r)
+  {
+    float const wy = weight * kernel_[r - (cy - radius_)];
+    float* cell = &cells_[static_cast<std::size_t>(r) * cols_ + c0];
+    for (int i = 0; i <= c1 - c0; ++i)
+    {
+      cell[i] += wy * kx[i];
+      peak = std::max(peak, cell[i]);
+    }
+  }
+  max_ = peak;
+  ++count_;
+}
+
+void
+Heatmap::decay(unsigned time_ms)
+{
+  if (timed_ && (time_ms <= time_ms_)) { return; }  // Never rewind
+  if (half_life_ms_ && timed_)
+  {
+    scale_ *= std::exp2(-static_cast<double>(time_ms - time_ms_)
+                        / half_life_ms_);
+    if (scale_ < min_scale) { renormalize(); }
+  }
+  time_ms_ = time_ms;
+  timed_ = true;
+}
+
+void
+Heatmap::clear()
+{
+  std::fill(cells_.begin(), cells_.end(), 0.0f);
+  max_ = 0.0f;
+  scale_ = 1.0;
+  timed_ = false;
+  count_ = 0;
+}
+
+unsigned
+Heatmap::cols() const
+{
+  return cols_;
+}
+
+unsigned
+Heatmap::rows() const
+{
+  return rows_;
+}
+
+unsigned
+Heatmap::cell_px() const
+{
+  return cell_px_;
+}
+
+std::size_t
+Heatmap::count() const
+{
+  return count_;
+}
+
+float
+Heatmap::value(unsigned col, unsigned row) const
+{
+  return static_cast<float>(cells_[row * cols_ + col] * scale_);
+}
+
+float
+Heatmap::max() const
+{
+  return static_cast<float>(max_ * scale_);
+}
+
+void
+Heatmap::colorize(unsigned char* rgba) const
+{
+  // Relative values are independent of the decay factor
+  float const k = (max_ > 0.0f) ? (255.0f / max_) : 0.0f;
+  std::size_t const n = cells_.size();
+  std::uint32_t* out = reinterpret_cast<std::uint32_t*>(rgba);
+
+  // Convert to palette indices in blocks, so the conversion vectorizes
+  constexpr std::size_t block = 256;
+  unsigned char index[block];
+  for (std::size_t i = 0; i < n; i += block)
+  {
+    std::size_t m = std::min(block, n - i);
+    float const* c = &cells_[i];
+    for (std::size_t j = 0; j != m; ++j)
+    {
+      index[j] = static_cast<unsigned char>(std::min(c[j] * k, 255.0f));
+    }
+    for (std::size_t j = 0; j != m; ++j)
+    {
+      std::memcpy(&out[i + j], &palette[index[j]], sizeof(std::uint32_t));
+    }
+  }
+}
+
+//---------------------------------------------------------------------------
+// private
+
+void
+Heatmap::renormalize()
+{
+  float const s = static_cast<float>(scale_);
+  for (auto& c : cells_) { c *= s; }
+  max_ *= s;
+  scale_ = 1.0;
+}
+
+//---------------------------------------------------------------------------
+
+std::size_t
+add_log(std::istream& is, Heatmap& heatmap)
+{
+  // Find gaze data header
+  std::string line;
+  int time_col = -1, gaze_col = -1, x_col = -1, y_col = -1;
+  while (std::getline(is, line))
+  {
+    if (!line.empty() && (line.back() == '\r')) { line.pop_back(); }
+    time_col = column(line, "time_ms");
+    gaze_col = column(line, "tracking.gaze");
+    x_col    = column(line, "avg_px.x");
+    y_col    = column(line, "avg_px.y");
+    if ((time_col >= 0) && (gaze_col >= 0) && (x_col >= 0) && (y_col >= 0))
+    {
+      break;
+    }
+  }
+
+  std::size_t n = 0;
+  std::vector<std::string> fields;
+  while (std::getline(is, line))
+  {
+    if (!line.empty() && (line.back() == '\r')) { line.pop_back(); }
+    fields.clear();
+    std::istringstream iss(line);
+    std::string field;
+    while (std::getline(iss, field, ',')) { fields.push_back(field); }
+
+    int last = std::max(std::max(time_col, gaze_col), std::max(x_col, y_col));
+    if (static_cast<int>(fields.size()) <= last) { continue; }
+    if (fields[gaze_col] != "true") { continue; }   // Not tracking gaze
+    try
+    {
+      heatmap.add(std::stof(fields[x_col]), std::stof(fields[y_col]),
+                  static_cast<unsigned>(std::stoul(fields[time_col])));
+      ++n;
+    }
+    catch (std::exception const&) {}  // Skip malformed sample
+  }
+  return n;
+}
+
+} // eye
+//===========================================================================//
@@ -0,0 +1,141 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib.hpp>
+
+#include "debug/benchmark.hpp"  // eye::debug::elapsed_ms
+
+#include <cmath>      // std::cos, std::sin
+#include <iostream>   // std::cout
+#include <sstream>    // std::stringstream
+#include <vector>     // std::vector
+
+namespace {   //-------------------------------------------------------------
+
+using eye::debug::elapsed_ms;
+using eye::debug::per_frame;
+using eye::debug::steady_clock;
+
+constexpr unsigned  screen_w    = 1920;
+constexpr unsigned  screen_h    = 1080;
+constexpr unsigned  rate_hz     = 2000;   // Gaze sample rate
+constexpr unsigned  seconds     = 60;     // Gaze data duration
+constexpr unsigned  frame_count = 600;    // Colorized frames
+
+// Gaze sample i of a path wandering between fixations
+eye::Gaze
+sample(unsigned i)
+{
+  double t = static_cast<double>(i) / rate_hz;
+  double f = static_cast<unsigned>(t * 3);    // Three fixations per second
+  eye::Gaze g{};
+  g.time_ms = i * 1000 / rate_hz;
+  g.tracking = eye::Gaze::Tracking(0x07);
+  g.avg_px = { static_cast<float>(screen_w/2 + 600 * std::sin(1.3 * f)),
+               static_cast<float>(screen_h/2 + 350 * std::cos(0.7 * f)) };
+  return g;
+}
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye { namespace gaze { namespace debug {
+
+void
+heatmap_benchmark()
+{
+  std::cout <<'\n'<< "eyelib: Gaze heatmap (" << screen_w << 'x' << screen_h
+            << ", " << seconds << " s at " << rate_hz << " Hz)" <<'\n'<<'\n';
+
+  std::vector<eye::Gaze> gazes;
+  for (unsigned i = 0; i != seconds * rate_hz; ++i)
+  {
+    gazes.push_back(sample(i));
+  }
+
+  // Real-time accumulation with decay
+  eye::Heatmap live(screen_w, screen_h, 8, 24.0f, 10000);
+  auto start = steady_clock::now();
+  for (auto const& g : gazes)
+  {
+    live.add(g.avg_px.x, g.avg_px.y, g.time_ms);
+  }
+  double add_ms = elapsed_ms(start);
+
+  std::vector<unsigned char> rgba(live.cols() * live.rows() * 4);
+  double colorize_ms = per_frame(frame_count, [&](unsigned)
+    {
+      live.colorize(rgba.data());
+    });
+
+  std::cout << "grid:     " << live.cols() << " x " << live.rows()
+            << " cells of " << live.cell_px() << " px" <<'\n'
+            << "add:      " << (1e6 * add_ms / gazes.size()) << " ns/point, "
+            << (seconds * 1000.0 / add_ms) << "x real time" <<'\n'
+            << "colorize: " << colorize_ms << " ms/frame" <<'\n';
+
+  // Offline build from a gaze data log
+  std::stringstream log;
+  log << "eyelib-test,heatmap\n"
+      << eye::csv_header<eye::Gaze>() <<'\n';
+  for (auto const& g : gazes)
+  {
+    log << eye::csv(g) <<'\n';
+  }
+  eye::Heatmap offline(screen_w, screen_h);
+  start = steady_clock::now();
+  std::size_t n = eye::add_log(log, offline);
+  double log_ms = elapsed_ms(start);
+
+  unsigned peak_col = 0;
+  unsigned peak_row = 0;
+  for (unsigned r = 0; r != offline.rows(); ++r)
+  {
+    for (unsigned c = 0; c != offline.cols(); ++c)
+    {
+      if (offline.value(c, r) > offline.value(peak_col, peak_row))
+      {
+        peak_col = c;
+        peak_row = r;
+      }
+    }
+  }
+  std::cout << "log:      " << n << " points in " << log_ms << " ms, peak "
+            << offline.max() << " at (" << peak_col * offline.cell_px()
+            << ", " << peak_row * offline.cell_px() << ")" <<'\n';
+  eye::debug::verdict("log points", n == gazes.size());
+
+  // An out-of-order time must not rewind the decay
+  eye::Heatmap ordered(screen_w, screen_h, 8, 24.0f, 1000);
+  ordered.add(960.0f, 540.0f, 0);
+  ordered.decay(1000);
+  float const half = ordered.max();
+  ordered.decay(500);
+  ordered.decay(1000);
+  eye::debug::verdict("out-of-order decay", ordered.max() == half);
+  eye::debug::rule();
+}
+
+} } } // eye::gaze::debug
+//===========================================================================//
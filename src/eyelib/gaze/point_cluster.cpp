@@ -25,24 +25,33 @@ SOFTWARE.
 
 #include <eyelib/gaze/point_cluster.hpp>
 
-#include <numeric>    // std::accumulate
-
 namespace eye {
 //---------------------------------------------------------------------------
 
+PointCluster::PointCluster(std::size_t capacity)
+: t_(capacity)
+, x_(capacity)
+, y_(capacity)
+{}
+
 void
 PointCluster::clear()
 {
   t_.clear();
   x_.clear();
   y_.clear();
+  sum_x_      = 0;
+  sum_y_      = 0;
+  has_start_  = false;
 }
 
 unsigned
 PointCluster::duration() const
 {
-  if (t_.back() < t_.front()) { return 0; }
-  return t_.back() - t_.front();
+  if (t_.empty()) { return 0; }
+  unsigned first = has_start_ ? start_ : t_.front();
+  if (t_.back() < first) { return 0; }
+  return t_.back() - first;
 }
 
 bool
@@ -51,32 +60,51 @@ PointCluster::empty() const
   return x_.empty();
 }
 
+bool
+PointCluster::full() const
+{
+  return x_.full();
+}
+
 float
 PointCluster::mean_x() const
 {
-  return std::accumulate(x_.cbegin(), x_.cend(), 0.0) / x_.size();
+  return sum_x_ / x_.size();
 }
 
 float
 PointCluster::mean_y() const
 {
-  return std::accumulate(y_.cbegin(), y_.cend(), 0.0) / y_.size();
+  return sum_y_ / y_.size();
 }
 
 void
 PointCluster::pop_front()
 {
+  sum_x_ -= x_.front();
+  sum_y_ -= y_.front();
   t_.pop_front();
   x_.pop_front();
   y_.pop_front();
+  has_start_ = false;
+
+  // Restart sums when empty, so that rounding does not accumulate
+  if (x_.empty())
+  {
+    sum_x_ = 0;
+    sum_y_ = 0;
+  }
 }
 
 void
 PointCluster::push_back(unsigned t, float x, float y)
 {
+  if (x_.full()) { pop_front(); }
   t_.push_back(t);
   x_.push_back(x);
   y_.push_back(y);
+  sum_x_ += x;
+  sum_y_ += y;
 }
 
 std::size_t
@@ -88,7 +116,27 @@ PointCluster::size() const
 void
 PointCluster::start(unsigned t)
 {
-  t_.push_back(t);
+  clear();
+  start_      = t;
+  has_start_  = true;
+}
+
+unsigned
+PointCluster::time(std::size_t i) const
+{
+  return t_[i];
+}
+
+float
+PointCluster::x(std::size_t i) const
+{
+  return x_[i];
+}
+
+float
+PointCluster::y(std::size_t i) const
+{
+  return y_[i];
 }
 
 //---------------------------------------------------------------------------
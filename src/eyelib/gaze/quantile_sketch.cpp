@@ -0,0 +1,319 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib/gaze/quantile_sketch.hpp>
+
+#include <algorithm>  // std::max, std::min, std::sort, std::lower_bound
+#include <cmath>      // std::ceil, std::pow
+#include <limits>     // std::numeric_limits
+#include <sstream>    // std::istringstream
+#include <string>     // std::string, std::getline
+#include <utility>    // std::move
+
+namespace {   //-------------------------------------------------------------
+
+char const* const tag = "quantile_sketch";    // First field of write()
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye {
+
+//---------------------------------------------------------------------------
+
+QuantileSketch::QuantileSketch(unsigned k)
+: k_(std::max(k, 8u))
+{
+  add_level();
+}
+
+void
+QuantileSketch::add(float v)
+{
+  min_ = (count_ == 0) ? v : std::min(min_, v);
+  max_ = (count_ == 0) ? v : std::max(max_, v);
+  ++count_;
+
+  levels_[0].push_back(v);
+  ++size_;
+  is_sorted_ = false;
+  compress();
+}
+
+bool
+QuantileSketch::merge(QuantileSketch const& other)
+{
+  // Levels of a different k have different capacities and weights
+  if (other.k_ != k_)     { return false; }
+  if (other.count_ == 0)  { return true; }
+  if (&other == this)
+  {
+    // Levels would grow while being appended to themselves
+    QuantileSketch const copy(other);
+    return merge(copy);
+  }
+
+  min_ = (count_ == 0) ? other.min_ : std::min(min_, other.min_);
+  max_ = (count_ == 0) ? other.max_ : std::max(max_, other.max_);
+  count_ += other.count_;
+
+  while (levels_.size() < other.levels_.size()) { add_level(); }
+  for (std::size_t h = 0; h != other.levels_.size(); ++h)
+  {
+    auto const& src = other.levels_[h];
+    levels_[h].insert(levels_[h].end(), src.begin(), src.end());
+  }
+  size_ += other.size_;
+  is_sorted_ = false;
+  compress();
+  return true;
+}
+
+float
+QuantileSketch::quantile(double q) const
+{
+  if (count_ == 0)  { return 0; }
+  if (q <= 0)       { return min_; }
+  if (q >= 1)       { return max_; }
+
+  // Sort retained values once, with cumulative weights, until changed
+  if (!is_sorted_)
+  {
+    sorted_.clear();
+    sorted_.reserve(size_);
+    for (std::size_t h = 0; h != levels_.size(); ++h)
+    {
+      for (auto v : levels_[h]) { sorted_.push_back(Weighed(v, 1ull << h)); }
+    }
+    std::sort(sorted_.begin(), sorted_.end());
+    std::uint64_t sum = 0;
+    for (auto& w : sorted_) { w.second = (sum += w.second); }
+    is_sorted_ = true;
+  }
+
+  // First value with a cumulative weight of at least the rank
+  auto rank = static_cast<std::uint64_t>(std::ceil(q * count_));
+  auto it = std::lower_bound(sorted_.begin(), sorted_.end(), rank,
+    [](Weighed const& w, std::uint64_t r) { return w.second < r; });
+  return (it == sorted_.end()) ? max_ : it->first;
+}
+
+float
+QuantileSketch::median() const
+{
+  return quantile(0.5);
+}
+
+float
+QuantileSketch::min() const
+{
+  return min_;
+}
+
+float
+QuantileSketch::max() const
+{
+  return max_;
+}
+
+std::uint64_t
+QuantileSketch::count() const
+{
+  return count_;
+}
+
+std::size_t
+QuantileSketch::size() const
+{
+  return size_;
+}
+
+bool
+QuantileSketch::empty() const
+{
+  return count_ == 0;
+}
+
+void
+QuantileSketch::clear()
+{
+  levels_.clear();
+  add_level();
+  size_       = 0;
+  count_      = 0;
+  min_        = 0;
+  max_        = 0;
+  is_sorted_  = false;
+}
+
+void
+QuantileSketch::write(std::ostream& os) const
+{
+  // Enough digits that values read back are exactly those written
+  auto const flags = os.flags();
+  auto const precision = os.precision();
+  os.flags(std::ios_base::dec);
+  os.precision(std::numeric_limits<float>::max_digits10);
+
+  os << tag << ',' << k_ << ',' << count_ << ',' << min_ << ',' << max_
+     << ',' << random_ << ',' << levels_.size() << '\n';
+  for (auto const& level : levels_)
+  {
+    for (std::size_t i = 0; i != level.size(); ++i)
+    {
+      os << (i ? "," : "") << level[i];
+    }
+    os << '\n';
+  }
+
+  os.flags(flags);
+  os.precision(precision);
+}
+
+bool
+QuantileSketch::read(std::istream& is)
+{
+  std::string line;
+  if (!std::getline(is, line)) { return false; }
+
+  std::istringstream header(line);
+  std::string name;
+  unsigned k = 0;
+  std::uint64_t count = 0;
+  float min = 0, max = 0;
+  std::uint32_t random = 0;
+  std::size_t levels = 0;
+  char sep;
+  std::getline(header, name, ',');
+  header >> k >> sep >> count >> sep >> min >> sep >> max >> sep
+         >> random >> sep >> levels;
+  if (!header || (name != tag) || (k < 8) || (random == 0) ||
+      (levels == 0) || (levels > 64))
+  {
+    return false;
+  }
+
+  QuantileSketch q(k);
+  while (q.levels_.size() < levels) { q.add_level(); }
+
+  // Values of each level, whose weights must add up to the count
+  std::uint64_t weight = 0;
+  for (std::size_t h = 0; h != levels; ++h)
+  {
+    if (!std::getline(is, line)) { return false; }
+    std::istringstream values(line);
+    float v;
+    while (values >> v)
+    {
+      q.levels_[h].push_back(v);
+      if (!(values >> sep))  { break; }
+      if (sep != ',')        { return false; }
+    }
+    if (!values.eof()) { return false; }
+    q.size_ += q.levels_[h].size();
+    weight  += q.levels_[h].size() << h;
+  }
+  if (weight != count) { return false; }
+
+  q.count_  = count;
+  q.min_    = min;
+  q.max_    = max;
+  q.random_ = random;
+  q.compress();
+  *this = std::move(q);
+  return true;
+}
+
+//---------------------------------------------------------------------------
+// private
+
+std::size_t
+QuantileSketch::capacity(std::size_t level) const
+{
+  // Capacity decreases by 2/3 per level below the top level
+  auto depth = levels_.size() - 1 - level;
+  auto c = std::ceil(k_ * std::pow(2.0 / 3.0, double(depth)));
+  return std::max(std::size_t(8), static_cast<std::size_t>(c));
+}
+
+void
+QuantileSketch::add_level()
+{
+  levels_.emplace_back();
+  capacity_ = 0;
+  for (std::size_t h = 0; h != levels_.size(); ++h)
+  {
+    capacity_ += capacity(h);
+  }
+}
+
+void
+QuantileSketch::compress()
+{
+  while (size_ > capacity_)
+  {
+    // Compact the lowest full level
+    for (std::size_t h = 0; h != levels_.size(); ++h)
+    {
+      if (levels_[h].size() >= capacity(h))
+      {
+        compact(h);
+        break;
+      }
+    }
+  }
+}
+
+void
+QuantileSketch::compact(std::size_t level)
+{
+  if (level + 1 == levels_.size()) { add_level(); }
+  auto& src = levels_[level];
+  auto& dst = levels_[level + 1];
+
+  // An odd value out remains at this level
+  std::sort(src.begin(), src.end());
+  bool const odd = (src.size() % 2) != 0;
+  float const kept = odd ? src.back() : 0.0f;
+  if (odd) { src.pop_back(); }
+
+  // Offset of promoted values, from a xorshift generator
+  random_ ^= random_ << 13;
+  random_ ^= random_ >> 17;
+  random_ ^= random_ << 5;
+  std::size_t const offset = random_ & 1u;
+
+  for (std::size_t i = offset; i < src.size(); i += 2)
+  {
+    dst.push_back(src[i]);
+  }
+  size_ -= src.size() / 2;
+  src.clear();
+  if (odd) { src.push_back(kept); }
+}
+
+//---------------------------------------------------------------------------
+
+} // eye
+//===========================================================================//
@@ -0,0 +1,186 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib.hpp>
+
+#include "debug/benchmark.hpp"  // eye::debug::measure
+
+#include <algorithm>  // std::max, std::sort, std::lower_bound
+#include <cmath>      // std::abs
+#include <iomanip>    // std::setw
+#include <iostream>   // std::cout
+#include <random>     // std::mt19937, std::lognormal_distribution
+#include <sstream>    // std::stringstream
+#include <string>     // std::string
+#include <thread>     // std::thread
+#include <vector>     // std::vector
+
+namespace {   //-------------------------------------------------------------
+
+using eye::debug::measure;
+
+constexpr unsigned  part_count  = 8;    // Sketches merged
+
+// Synthetic fixation durations in milliseconds, log-normal about 250 ms
+std::vector<float>
+samples(std::size_t n)
+{
+  std::mt19937 rng(13);
+  std::lognormal_distribution<float> ms(5.5f, 0.5f);
+
+  std::vector<float> v(n);
+  for (auto& x : v) { x = ms(rng); }
+  return v;
+}
+
+eye::QuantileSketch
+sketch(std::vector<float> const& v)
+{
+  eye::QuantileSketch q;
+  for (auto x : v) { q.add(x); }
+  return q;
+}
+
+// Largest rank error of percentiles 1 to 99, against sorted values
+double
+rank_error(eye::QuantileSketch const& q, std::vector<float> const& sorted)
+{
+  double worst = 0;
+  for (unsigned p = 1; p != 100; ++p)
+  {
+    auto it = std::lower_bound(sorted.begin(), sorted.end(),
+                               q.quantile(p / 100.0));
+    double rank = double(it - sorted.begin()) / sorted.size();
+    worst = std::max(worst, std::abs(rank - p / 100.0));
+  }
+  return worst;
+}
+
+// Sketch parts of the values in separate threads, then merge the parts
+eye::QuantileSketch
+merged(std::vector<float> const& v)
+{
+  std::vector<eye::QuantileSketch> parts(part_count);
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t != part_count; ++t)
+  {
+    threads.emplace_back([&v, &parts, t]()
+      {
+        for (std::size_t i = t; i < v.size(); i += part_count)
+        {
+          parts[t].add(v[i]);
+        }
+      });
+  }
+  for (auto& t : threads) { t.join(); }
+
+  eye::QuantileSketch q;
+  for (auto const& p : parts) { q.merge(p); }
+  return q;
+}
+
+// Write a sketch and read it back: the copy must have the same quantiles,
+// and the same text cut short must be rejected
+bool
+round_trip(eye::QuantileSketch const& q, std::size_t& bytes)
+{
+  std::stringstream ss;
+  q.write(ss);
+  std::string const text = ss.str();
+  bytes = text.size();
+
+  eye::QuantileSketch r;
+  if (!r.read(ss) || (r.count() != q.count()) || (r.size() != q.size()) ||
+      (r.min() != q.min()) || (r.max() != q.max()))
+  {
+    return false;
+  }
+  for (unsigned p = 0; p <= 100; ++p)
+  {
+    if (r.quantile(p / 100.0) != q.quantile(p / 100.0)) { return false; }
+  }
+
+  std::stringstream cut(text.substr(0, text.size() / 2));
+  eye::QuantileSketch t;
+  return !t.read(cut) && t.empty();
+}
+
+// Merge a sketch with a sketch of another k, which is rejected, and
+// with itself, which doubles every value
+bool
+merges(eye::QuantileSketch q, std::vector<float> const& sorted)
+{
+  auto const n = q.count();
+  eye::QuantileSketch other(100);
+  other.add(1.0f);
+  return !q.merge(other) && (q.count() == n) && q.merge(q) &&
+         (q.count() == 2 * n) && (rank_error(q, sorted) < 0.02);
+}
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye { namespace gaze { namespace debug {
+
+void
+quantile_benchmark()
+{
+  std::cout <<'\n'<< "eyelib: Quantile sketch (k = 200, "
+            << part_count << " merged sketches)" <<'\n'<<'\n';
+
+  std::cout << "   values  retained  rank error  merged error  ns/value"
+            << "  written" << '\n';
+  bool ok = true;
+  bool io = true;
+  for (std::size_t n : { 1000u, 100000u, 1000000u })
+  {
+    auto v = samples(n);
+
+    double ns = measure(n, [&v]() { return sketch(v).size(); });
+    auto q = sketch(v);
+
+    auto m = merged(v);
+    std::sort(v.begin(), v.end());
+    double e  = rank_error(q, v);
+    double me = rank_error(m, v);
+    ok = ok && (q.count() == n) && (m.count() == n) && (e < 0.02)
+            && (me < 0.02) && (m.min() == v.front()) && (m.max() == v.back());
+
+    std::size_t bytes = 0;
+    io = io && round_trip(m, bytes) && merges(q, v);
+
+    std::cout << std::setw(9) << n << std::setw(10) << q.size()
+              << std::fixed << std::setprecision(4)
+              << std::setw(12) << e << std::setw(14) << me
+              << std::setprecision(1) << std::setw(10) << ns
+              << std::setw(9) << bytes << '\n';
+  }
+  std::cout << '\n';
+  eye::debug::verdict("Rank error within 2%", ok);
+  eye::debug::verdict("Write, read and merge", io);
+  eye::debug::rule();
+}
+
+} } } // eye::gaze::debug
+//===========================================================================//
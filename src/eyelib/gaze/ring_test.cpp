@@ -0,0 +1,189 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib.hpp>
+
+#include "debug/benchmark.hpp"  // eye::debug::measure, eye::debug::samples
+
+#include <cmath>      // std::abs
+#include <deque>      // std::deque
+#include <iomanip>    // std::setw
+#include <iostream>   // std::cout
+#include <numeric>    // std::accumulate
+#include <vector>     // std::vector
+
+namespace {   //-------------------------------------------------------------
+
+using eye::debug::GazeSample;
+using eye::debug::measure;
+using eye::debug::sample_count;
+
+// Point cluster as implemented before the ring, on deques
+class DequeCluster
+{
+public:
+  void
+  pop_front()
+  {
+    t_.pop_front();
+    x_.pop_front();
+    y_.pop_front();
+  }
+
+  void
+  push_back(unsigned t, float x, float y)
+  {
+    t_.push_back(t);
+    x_.push_back(x);
+    y_.push_back(y);
+  }
+
+  float
+  mean_x() const
+  {
+    return std::accumulate(x_.cbegin(), x_.cend(), 0.0) / x_.size();
+  }
+
+  float
+  mean_y() const
+  {
+    return std::accumulate(y_.cbegin(), y_.cend(), 0.0) / y_.size();
+  }
+
+  std::size_t size() const { return x_.size(); }
+
+private:
+  std::deque<unsigned>  t_{};
+  std::deque<float>     x_{};
+  std::deque<float>     y_{};
+};
+
+// Moving window of n points, with the mean of the window per point
+template<typename C>
+float
+cluster_window(std::vector<GazeSample> const& v, unsigned n, C& c)
+{
+  float sum = 0;
+  unsigned t = 0;
+  for (auto const& p : v)
+  {
+    c.push_back(t += 17, p.x, p.y);
+    if (c.size() > n) { c.pop_front(); }
+    sum += c.mean_x() + c.mean_y();
+  }
+  return sum;
+}
+
+// Moving window of n values, with the first value per point
+template<typename C>
+float
+queue_window(std::vector<GazeSample> const& v, unsigned n, C& c)
+{
+  float sum = 0;
+  for (auto const& p : v)
+  {
+    c.push_back(p.x);
+    if (c.size() > n) { c.pop_front(); }
+    sum += c.front();
+  }
+  return sum;
+}
+
+// Compare the means of ring and deque clusters
+bool
+agreement(std::vector<GazeSample> const& v, unsigned n)
+{
+  DequeCluster      dc;
+  eye::PointCluster pc(n + 1);
+  unsigned t = 0;
+  for (auto const& p : v)
+  {
+    t += 17;
+    dc.push_back(t, p.x, p.y);
+    pc.push_back(t, p.x, p.y);
+    if (dc.size() > n) { dc.pop_front(); pc.pop_front(); }
+    if ((std::abs(dc.mean_x() - pc.mean_x()) > 1e-2) ||
+        (std::abs(dc.mean_y() - pc.mean_y()) > 1e-2) ||
+        (dc.size() != pc.size()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye { namespace gaze { namespace debug {
+
+void
+ring_benchmark()
+{
+  std::cout <<'\n'<< "eyelib: Point ring buffer ("
+            << sample_count << " samples per measurement)" <<'\n'<<'\n';
+
+  auto const v = eye::debug::samples({ 5, 100.0f, 1800.0f,
+                                          100.0f, 1000.0f, 12, 30, 2.0f });
+
+  bool ok = true;
+  std::cout << "                     per sample (ns)" << '\n'
+            << "   pts   deque  Ring<float>   deque cluster  PointCluster"
+            << '\n' << std::fixed << std::setprecision(1);
+  for (unsigned n : { 4u, 16u, 64u, 256u, 1024u })
+  {
+    ok = ok && agreement(v, n);
+
+    double dq = measure(v.size(), [&]()
+      {
+        std::deque<float> c;
+        return queue_window(v, n, c);
+      });
+    double rq = measure(v.size(), [&]()
+      {
+        eye::Ring<float> c(n + 1);
+        return queue_window(v, n, c);
+      });
+    double dc = measure(v.size(), [&]()
+      {
+        DequeCluster c;
+        return cluster_window(v, n, c);
+      });
+    double pc = measure(v.size(), [&]()
+      {
+        eye::PointCluster c(n + 1);
+        return cluster_window(v, n, c);
+      });
+
+    std::cout << std::setw(6) << n << std::setw(8) << dq
+              << std::setw(13) << rq << std::setw(16) << dc
+              << std::setw(14) << pc << '\n';
+  }
+  std::cout << '\n';
+  eye::debug::verdict("Cluster mean agreement", ok);
+  eye::debug::rule();
+}
+
+} } } // eye::gaze::debug
+//===========================================================================//
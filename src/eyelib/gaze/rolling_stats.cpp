@@ -0,0 +1,194 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib/gaze/rolling_stats.hpp>
+
+#include <algorithm>  // std::min, std::max
+
+namespace {   //-------------------------------------------------------------
+
+// Bucket duration and number of buckets in each window
+constexpr unsigned    window_bucket_ms[]  = { 100, 1000, 10000, 60000 };
+constexpr std::size_t window_buckets[]    = { 10, 10, 6, 10 };
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye {
+
+//---------------------------------------------------------------------------
+
+float
+RollingStats::Stats::mean() const
+{
+  return count ? float(sum / count) : 0.0f;
+}
+
+float
+RollingStats::Stats::rate() const
+{
+  return span_ms ? (count * 60000.0f / span_ms) : 0.0f;
+}
+
+void
+RollingStats::Summary::add(float v)
+{
+  min = count ? std::min(min, v) : v;
+  max = count ? std::max(max, v) : v;
+  sum += v;
+  ++count;
+}
+
+void
+RollingStats::Summary::merge(Summary const& s)
+{
+  if (s.count == 0) { return; }
+  min = count ? std::min(min, s.min) : s.min;
+  max = count ? std::max(max, s.max) : s.max;
+  sum   += s.sum;
+  count += s.count;
+}
+
+//---------------------------------------------------------------------------
+
+RollingStats::RollingStats()
+{
+  for (std::size_t i = 0; i != levels; ++i)
+  {
+    level_[i].bucket_ms = window_bucket_ms[i];
+    level_[i].closed.resize(window_buckets[i] - 1);
+  }
+  clear();
+}
+
+void
+RollingStats::add(unsigned time_ms, float v)
+{
+  advance(time_ms);
+  level_[0].open.add(v);
+}
+
+void
+RollingStats::update(unsigned time_ms)
+{
+  advance(time_ms);
+}
+
+RollingStats::Stats
+RollingStats::stats(Window w) const
+{
+  // Closed buckets of the window, and open buckets of it and finer windows
+  auto const& lv = level_[w];
+  Summary s = lv.summary;
+  for (std::size_t i = 0; i <= w; ++i)
+  {
+    s.merge(level_[i].open);
+  }
+
+  unsigned start = lv.start_ms - unsigned(lv.size * lv.bucket_ms);
+  unsigned span  = (started_ && (time_ms_ > start)) ? (time_ms_ - start) : 0;
+  return Stats{s.count, s.sum, s.min, s.max, span};
+}
+
+void
+RollingStats::clear()
+{
+  for (auto& lv : level_)
+  {
+    lv.head     = 0;
+    lv.size     = 0;
+    lv.summary  = Summary{0, 0.0, 0.0f, 0.0f};
+    lv.open     = Summary{0, 0.0, 0.0f, 0.0f};
+    lv.start_ms = 0;
+  }
+  time_ms_ = 0;
+  started_ = false;
+}
+
+//---------------------------------------------------------------------------
+// private
+
+void
+RollingStats::advance(unsigned time_ms)
+{
+  // Start buckets on bucket boundaries of the first time
+  if (!started_)
+  {
+    for (auto& lv : level_)
+    {
+      lv.start_ms = time_ms - (time_ms % lv.bucket_ms);
+    }
+    started_ = true;
+  }
+  if (time_ms < time_ms_) { return; }   // Out of order time
+  time_ms_ = time_ms;
+
+  // Close buckets from the finest window, so that each closed bucket is
+  // merged into the coarser open bucket before that one closes
+  for (std::size_t i = 0; i != levels; ++i)
+  {
+    auto& lv = level_[i];
+    while (time_ms - lv.start_ms >= lv.bucket_ms)
+    {
+      close(i);
+
+      // After a gap of a whole window, the window is empty
+      if (time_ms - lv.start_ms >= lv.bucket_ms * lv.closed.size())
+      {
+        lv.head     = 0;
+        lv.size     = 0;
+        lv.summary  = Summary{0, 0.0, 0.0f, 0.0f};
+        lv.start_ms = time_ms - (time_ms % lv.bucket_ms);
+      }
+    }
+  }
+}
+
+void
+RollingStats::close(std::size_t level)
+{
+  auto& lv = level_[level];
+  if (level + 1 != levels) { level_[level + 1].open.merge(lv.open); }
+
+  // Add the open bucket to the ring, removing the oldest if full
+  std::size_t const n = lv.closed.size();
+  lv.closed[(lv.head + lv.size) % n] = lv.open;
+  if (lv.size == n) { lv.head = (lv.head + 1) % n; }
+  else              { ++lv.size; }
+
+  // Summary of the closed buckets
+  lv.summary = Summary{0, 0.0, 0.0f, 0.0f};
+  for (std::size_t i = 0; i != lv.size; ++i)
+  {
+    lv.summary.merge(lv.closed[(lv.head + i) % n]);
+  }
+
+  lv.open      = Summary{0, 0.0, 0.0f, 0.0f};
+  lv.start_ms += lv.bucket_ms;
+}
+
+//---------------------------------------------------------------------------
+
+} // eye
+//===========================================================================//
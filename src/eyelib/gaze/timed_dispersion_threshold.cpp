@@ -0,0 +1,212 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib/gaze/timed_dispersion_threshold.hpp>
+
+#include <algorithm>  // std::min, std::max
+
+namespace eye {
+
+
+TimedDispersionThreshold::TimedDispersionThreshold(unsigned duration_ms,
+                                                   float dmax,
+                                                   std::size_t max_pts)
+: duration_ms_(duration_ms)
+, d_max_(dmax)
+, points_(max_pts)
+, x_min_(max_pts)
+, x_max_(max_pts)
+, y_min_(max_pts)
+, y_max_(max_pts)
+{}
+
+
+bool
+TimedDispersionThreshold::fixation(unsigned t, float x, float y)
+{
+  // During a fixation, points are only added to the group,
+  // so its extents are updated by the current point
+  if (is_fix_ && (t >= t1_))
+  {
+    float x_min = std::min(fx_min_, x);
+    float x_max = std::max(fx_max_, x);
+    float y_min = std::min(fy_min_, y);
+    float y_max = std::max(fy_max_, y);
+    d_ = ((x_max - x_min) + (y_max - y_min));
+
+    if ((d_ > 0) && (d_ <= d_max_))
+    {
+      fx_min_ = x_min;
+      fx_max_ = x_max;
+      fy_min_ = y_min;
+      fy_max_ = y_max;
+      sum_x_ += x;
+      sum_y_ += y;
+      t1_     = t;
+      ++n_;
+      return true;  // Continue adding points until threshold is exceeded
+    }
+  }
+
+  // Dispersion threshold was exceeded during a fixation, or a timestamp
+  // is out of order: clear all the points, and start a new window
+  if (is_fix_ || (!points_.empty() && (t < points_.time(points_.size() - 1))))
+  {
+    float d = d_;
+    clear();
+    d_ = d;
+    push(t, x, y);
+    return false;
+  }
+
+  // Add the current point, and remove the oldest points
+  // while the rest span the minimum duration
+  push(t, x, y);
+  while ((points_.size() > 1) && ((t - points_.time(1)) >= duration_ms_))
+  {
+    pop_front();
+  }
+
+  // The duration threshold is the time spanned by the window points
+  if (points_.duration() < duration_ms_)
+  {
+    d_ = 0;
+    return false;   // Continue adding points until the minimum is reached
+  }
+
+  // Compute dispersion of the points
+  d_ = ((x_max_.front().value - x_min_.front().value) +
+        (y_max_.front().value - y_min_.front().value));
+
+  // If points are within dispersion threshold `max_px`,
+  // they are considered to represent a fixation; reject
+  // a value of zero, as it indicates invalid coordinates
+  if ((d_ > 0) && (d_ <= d_max_))
+  {
+    is_fix_ = true;
+    n_      = points_.size();
+    t0_     = points_.time(0);
+    t1_     = t;
+    fx_min_ = x_min_.front().value;
+    fx_max_ = x_max_.front().value;
+    fy_min_ = y_min_.front().value;
+    fy_max_ = y_max_.front().value;
+    sum_x_  = 0.0;
+    sum_y_  = 0.0;
+    for (std::size_t i = 0; i != points_.size(); ++i)
+    {
+      sum_x_ += points_.x(i);
+      sum_y_ += points_.y(i);
+    }
+    return true;    // Continue adding points until threshold is exceeded
+  }
+  return false;
+}
+
+
+void
+TimedDispersionThreshold::centroid(double& x, double& y, unsigned& n) const
+{
+  if (is_fix_)
+  {
+    n = n_;
+    x = sum_x_ / n_;
+    y = sum_y_ / n_;
+  }
+}
+
+
+float
+TimedDispersionThreshold::dispersion() const
+{
+  return d_;
+}
+
+
+unsigned
+TimedDispersionThreshold::duration() const
+{
+  return is_fix_ ? (t1_ - t0_) : points_.duration();
+}
+
+
+void
+TimedDispersionThreshold::clear()
+{
+  d_      = 0;
+  is_fix_ = false;
+  first_  = 0;
+  next_   = 0;
+  n_      = 0;
+  points_.clear();
+  x_min_.clear();
+  x_max_.clear();
+  y_min_.clear();
+  y_max_.clear();
+}
+
+//---------------------------------------------------------------------------
+// private
+
+void
+TimedDispersionThreshold::push(unsigned t, float x, float y)
+{
+  // If the window is full, its oldest point is removed
+  if (points_.full()) { pop_front(); }
+  points_.push_back(t, x, y);
+  push(x_min_, x, true);
+  push(x_max_, x, false);
+  push(y_min_, y, true);
+  push(y_max_, y, false);
+  ++next_;
+}
+
+void
+TimedDispersionThreshold::push(Extents& q, float v, bool is_min)
+{
+  // Points which can no longer be an extent of the window are removed
+  while (!q.empty() && (is_min ? (q.back().value >= v)
+                               : (q.back().value <= v)))
+  {
+    q.pop_back();
+  }
+  q.push_back(Extent{next_, v});
+}
+
+void
+TimedDispersionThreshold::pop_front()
+{
+  points_.pop_front();
+  ++first_;
+  if (x_min_.front().index < first_) { x_min_.pop_front(); }
+  if (x_max_.front().index < first_) { x_max_.pop_front(); }
+  if (y_min_.front().index < first_) { y_min_.pop_front(); }
+  if (y_max_.front().index < first_) { y_max_.pop_front(); }
+}
+
+//---------------------------------------------------------------------------
+
+} // eye
+//===========================================================================//
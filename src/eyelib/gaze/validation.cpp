@@ -0,0 +1,310 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib/gaze/validation.hpp>
+
+#include <eyelib/gaze.hpp>    // eye::Gaze
+
+#include <cmath>      // std::isfinite, std::sqrt
+#include <cstddef>    // std::size_t
+#include <ios>        // std::ios_base, std::streamsize
+#include <iomanip>    // std::setw, std::setfill, std::setprecision
+#include <ostream>    // std::ostream
+
+namespace {   //-------------------------------------------------------------
+
+// Partial sums per summation loop
+constexpr std::size_t lanes = 4;
+
+// Sum of partial sums s
+double
+total_of(double const (&s)[lanes])
+{
+  double t = 0.0;
+  for (std::size_t j = 0; j != lanes; ++j) { t += s[j]; }
+  return t;
+}
+
+// Save stream format flags, precision and fill, restored on destruction
+class format_saver
+{
+public:
+  explicit format_saver(std::ostream& os)
+  : os_(os), flags_(os.flags()), precision_(os.precision()), fill_(os.fill())
+  {}
+  ~format_saver()
+  {
+    os_.flags(flags_);
+    os_.precision(precision_);
+    os_.fill(fill_);
+  }
+  format_saver(format_saver const&)            = delete;
+  format_saver& operator=(format_saver const&) = delete;
+
+private:
+  std::ostream&           os_;
+  std::ios_base::fmtflags flags_;
+  std::streamsize         precision_;
+  char                    fill_;
+};
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye {
+
+//---------------------------------------------------------------------------
+
+Validation::Validation(Screen const& scr, float distance_m,
+                       unsigned settle_ms)
+: angle_(scr, distance_m)
+, settle_ms_(settle_ms)
+{}
+
+//---------------------------------------------------------------------------
+
+void
+Validation::begin(Target const& t)
+{
+  target_     = t;
+  target_deg_ = angle_.degrees({ float(t.x_px), float(t.y_px) });
+  collecting_ = true;
+  started_    = false;
+  lost_       = 0;
+  x_deg_.clear();
+  y_deg_.clear();
+}
+
+void
+Validation::add(Gaze const& g)
+{
+  bool valid = g.tracking.gaze
+            && std::isfinite(g.raw_px.x) && std::isfinite(g.raw_px.y)
+            && ((g.raw_px.x != 0) || (g.raw_px.y != 0));
+  add(g.raw_px.x, g.raw_px.y, g.time_ms, valid);
+}
+
+void
+Validation::add(float x_px, float y_px, unsigned time_ms, bool valid)
+{
+  if (!collecting_) { return; }
+  if (!started_)
+  {
+    started_  = true;
+    start_ms_ = time_ms;
+  }
+  if ((time_ms < start_ms_) || ((time_ms - start_ms_) < settle_ms_))
+  {
+    return;     // Saccade to the target, or out of order
+  }
+  if (!valid)
+  {
+    ++lost_;
+    return;
+  }
+  x_deg_.push_back(angle_.degrees_x(x_px) - target_deg_.x);
+  y_deg_.push_back(angle_.degrees_y(y_px) - target_deg_.y);
+}
+
+bool
+Validation::end()
+{
+  if (!collecting_) { return false; }
+  collecting_ = false;
+
+  std::size_t const n = x_deg_.size();
+  Result r{target_, n, lost_, 0.0f, 0.0f, 0.0f, 0.0f};
+  std::size_t const total = n + lost_;
+  r.data_loss = total ? static_cast<float>(lost_) / total : 0.0f;
+  if (n == 0)
+  {
+    results_.push_back(r);
+    return true;
+  }
+
+  // Sums are accumulated in independent lanes, so each lane adds in a fixed
+  // order and the compiler may vectorize across lanes without reassociating
+  // floating point additions.  The square root of the offsets is in its own
+  // loop, since it vectorizes only without errno (-fno-math-errno).
+  float const* x = x_deg_.data();
+  float const* y = y_deg_.data();
+  double sum_x[lanes]   = {};
+  double sum_y[lanes]   = {};
+  double sum_xx[lanes]  = {};
+  double sum_yy[lanes]  = {};
+  double sum_off[lanes] = {};
+  double sum_s2s[lanes] = {};
+  std::size_t const body = n - n % lanes;
+  for (std::size_t i = 0; i != body; i += lanes)
+  {
+    for (std::size_t j = 0; j != lanes; ++j)
+    {
+      double xi = x[i+j];
+      double yi = y[i+j];
+      sum_x[j]  += xi;
+      sum_y[j]  += yi;
+      sum_xx[j] += xi * xi;
+      sum_yy[j] += yi * yi;
+    }
+  }
+  for (std::size_t i = 0; i != body; i += lanes)
+  {
+    for (std::size_t j = 0; j != lanes; ++j)
+    {
+      double xi = x[i+j];
+      double yi = y[i+j];
+      sum_off[j] += std::sqrt((xi * xi) + (yi * yi));
+    }
+  }
+  for (std::size_t i = body; i != n; ++i)
+  {
+    double xi = x[i];
+    double yi = y[i];
+    sum_x[0]   += xi;
+    sum_y[0]   += yi;
+    sum_xx[0]  += xi * xi;
+    sum_yy[0]  += yi * yi;
+    sum_off[0] += std::sqrt((xi * xi) + (yi * yi));
+  }
+
+  // Differences of successive offsets, read directly from the arrays
+  std::size_t const diffs = n - 1;
+  std::size_t const diff_body = diffs - diffs % lanes;
+  for (std::size_t i = 0; i != diff_body; i += lanes)
+  {
+    for (std::size_t j = 0; j != lanes; ++j)
+    {
+      double dx = double(x[i+j+1]) - x[i+j];
+      double dy = double(y[i+j+1]) - y[i+j];
+      sum_s2s[j] += (dx * dx) + (dy * dy);
+    }
+  }
+  for (std::size_t i = diff_body; i != diffs; ++i)
+  {
+    double dx = double(x[i+1]) - x[i];
+    double dy = double(y[i+1]) - y[i];
+    sum_s2s[0] += (dx * dx) + (dy * dy);
+  }
+
+  double mean_x = total_of(sum_x) / n;
+  double mean_y = total_of(sum_y) / n;
+  double var    = (total_of(sum_xx) / n - mean_x * mean_x)
+                + (total_of(sum_yy) / n - mean_y * mean_y);
+  r.accuracy_deg = static_cast<float>(total_of(sum_off) / n);
+  r.sd_deg       = static_cast<float>(std::sqrt(var > 0.0 ? var : 0.0));
+  r.rms_s2s_deg  = diffs
+                 ? static_cast<float>(std::sqrt(total_of(sum_s2s) / diffs))
+                 : 0.0f;
+  results_.push_back(r);
+  return true;
+}
+
+//---------------------------------------------------------------------------
+
+bool
+Validation::collecting() const
+{
+  return collecting_;
+}
+
+Validation::Results const&
+Validation::results() const
+{
+  return results_;
+}
+
+void
+Validation::clear()
+{
+  collecting_ = false;
+  results_.clear();
+}
+
+//---------------------------------------------------------------------------
+
+Validation::Result
+mean(Validation::Results const& r)
+{
+  Validation::Result m{{0, 0, false}, 0, 0, 0.0f, 0.0f, 0.0f, 0.0f};
+  if (r.empty()) { return m; }
+  for (auto const& t : r)
+  {
+    m.samples      += t.samples;
+    m.lost         += t.lost;
+    m.accuracy_deg += t.accuracy_deg;
+    m.rms_s2s_deg  += t.rms_s2s_deg;
+    m.sd_deg       += t.sd_deg;
+  }
+  float n = static_cast<float>(r.size());
+  m.accuracy_deg /= n;
+  m.rms_s2s_deg  /= n;
+  m.sd_deg       /= n;
+  std::size_t total = m.samples + m.lost;
+  m.data_loss = total ? static_cast<float>(m.lost) / total : 0.0f;
+  return m;
+}
+
+std::ostream&
+operator<<(std::ostream& os, Validation::Result const& r)
+{
+  format_saver saver(os);     // Restore caller's format on return
+  return os << std::setfill('0')
+      << std::setw(4) << r.target.x_px << ','
+      << std::setw(4) << r.target.y_px << std::setfill(' ')
+      << std::setw(9) << r.samples
+      << std::setw(6) << r.lost
+      << std::setprecision(4) << std::fixed
+      << std::setw(12) << r.accuracy_deg
+      << std::setw(10) << r.rms_s2s_deg
+      << std::setw(10) << r.sd_deg;
+}
+
+std::ostream&
+operator<<(std::ostream& os, Validation::Results const& r)
+{
+  format_saver saver(os);     // Restore caller's format on return
+  os <<   "      target      samples  lost    accuracy  rms_s2s   sd"
+     << "\n      (pixel)                      (degree)  (degree)  (degree)"
+     << "\n      ---------------------------------------------------------";
+  for (std::size_t i = 0; i != r.size(); ++i)
+  {
+    os << '\n' << std::setw(4) << i << ": " << r[i];
+  }
+  auto m = mean(r);
+  return os
+     << "\n      ---------------------------------------------------------"
+     << "\nmean:          " << std::setw(9) << m.samples
+     << std::setw(6) << m.lost
+     << std::setprecision(4) << std::fixed
+     << std::setw(12) << m.accuracy_deg
+     << std::setw(10) << m.rms_s2s_deg
+     << std::setw(10) << m.sd_deg
+     << "\ndata loss: " << std::setprecision(1) << (100.0f * m.data_loss)
+     << " %";
+}
+
+//---------------------------------------------------------------------------
+
+} // eye
+//===========================================================================//
@@ -25,7 +25,6 @@ SOFTWARE.
 #include <eyelib/gaze/velocity_threshold.hpp>
 
 #include <cmath>    // std::sqrt
-#include <numeric>  // std::accumulate
 
 namespace {   //-------------------------------------------------------------
 } // anonymous --------------------------------------------------------------
@@ -41,24 +40,24 @@ VelocityThreshold::VelocityThreshold(float dmax)
 bool
 VelocityThreshold::fixation(float x, float y)
 {
-  // Add the current point
-  x_.push_back(x);
-  y_.push_back(y);
-
   // Must collect at least points
-  if (x_.size() < 2)
+  if (n_ == 0)
   {
-    d_sq_ = 0;
+    n_      = 1;
+    x_      = x;
+    y_      = y;
+    sum_x_  = x;
+    sum_y_  = y;
+    d_sq_   = 0;
     return false;
   }
 
-  // Get last point before current point
-  auto xp = x_[x_.size() - 2];
-  auto yp = y_[y_.size() - 2];
-
   // Threshold is implemented as a maximum squared displacement in pixels
-  d_sq_ = ((x - xp) * (x - xp) +
-           (y - yp) * (y - yp));
+  // from the last point before current point
+  d_sq_ = ((x - x_) * (x - x_) +
+           (y - y_) * (y - y_));
+  x_ = x;
+  y_ = y;
 
   // If the displacement squared (proxy for velocity) is within
   // threshold, the points represent a fixation; reject a value
@@ -67,19 +66,19 @@ VelocityThreshold::fixation(float x, float y)
   {
     // Continue adding points until velocity threshold is exceeded
     is_fix_ = true;
+    sum_x_ += x;
+    sum_y_ += y;
+    ++n_;
     return true;
   }
 
   // Velocity threshold was exceeded
   is_fix_ = false;
 
-  // Remove all points
-  x_.clear();
-  y_.clear();
-
-  // Re-add current point
-  x_.push_back(x);
-  y_.push_back(y);
+  // Remove all points, but the current point
+  n_      = 1;
+  sum_x_  = x;
+  sum_y_  = y;
 
   return false;
 }
@@ -90,17 +89,12 @@ VelocityThreshold::centroid(double& x, double& y, unsigned& n) const
 {
   if (is_fix_)
   {
-    if (x_.empty() || y_.empty()) { return; }   // empty vector(s)
-    if (x_.size() != y_.size())   { return; }   // unequal vector sizes
-
     // Number of points in fixation cluster
-    n = x_.size();
+    n = n_;
 
     // Compute centroid of cluster points
-    double sum_x = std::accumulate(x_.begin(), x_.end(), 0.0);
-    x = sum_x / n;
-    double sum_y = std::accumulate(y_.begin(), y_.end(), 0.0);
-    y = sum_y / n;
+    x = sum_x_ / n;
+    y = sum_y_ / n;
   }
 }
 
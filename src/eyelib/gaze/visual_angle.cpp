@@ -0,0 +1,240 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib/gaze/visual_angle.hpp>
+
+#include <eyelib/gaze.hpp>    // eye::Gaze
+
+#include <cmath>      // std::atan, std::tan, std::isfinite, std::sqrt
+#include <cstddef>    // std::size_t
+
+namespace {   //-------------------------------------------------------------
+
+constexpr double pi = 3.14159265358979323846;
+
+// Meters per pixel, or zero if the size or viewing distance is unknown
+float
+m_per_px(unsigned px, float m, float distance_m)
+{
+  return (px && (distance_m > 0)) ? m / px : 0.0f;
+}
+
+// Angle of each pixel from the screen center, for one axis, from
+// coordinate -margin to px + margin
+std::vector<float>
+pixel_degrees(unsigned px, unsigned margin, float m_per_px, float distance_m)
+{
+  std::vector<float> t(px + 2 * margin + 1, 0.0f);
+  if (m_per_px > 0)
+  {
+    double const center = 0.5 * px + margin;
+    for (std::size_t i = 0; i != t.size(); ++i)
+    {
+      double m = (i - center) * m_per_px;
+      t[i] = static_cast<float>(std::atan(m / distance_m) * 180.0 / pi);
+    }
+  }
+  return t;
+}
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye {
+
+//---------------------------------------------------------------------------
+
+VisualAngle::VisualAngle(Screen const& scr, float distance_m)
+: distance_m_(distance_m)
+, m_per_px_x_(m_per_px(scr.w_px, scr.w_m, distance_m))
+, m_per_px_y_(m_per_px(scr.h_px, scr.h_m, distance_m))
+, x_center_(0.5f * scr.w_px)
+, y_center_(0.5f * scr.h_px)
+, x0_(-float(scr.w_px / 2))
+, y0_(-float(scr.h_px / 2))
+, x_deg_(pixel_degrees(scr.w_px, scr.w_px / 2, m_per_px_x_, distance_m))
+, y_deg_(pixel_degrees(scr.h_px, scr.h_px / 2, m_per_px_y_, distance_m))
+{}
+
+float
+VisualAngle::degrees_x(float x_px) const
+{
+  return lookup(x_deg_, x0_, x_px);
+}
+
+float
+VisualAngle::degrees_y(float y_px) const
+{
+  return lookup(y_deg_, y0_, y_px);
+}
+
+PointXY<float>
+VisualAngle::degrees(PointXY<float> pt) const
+{
+  return { lookup(x_deg_, x0_, pt.x), lookup(y_deg_, y0_, pt.y) };
+}
+
+VisualAngle::Direction
+VisualAngle::direction(PointXY<float> pt) const
+{
+  float x = (pt.x - x_center_) * m_per_px_x_;
+  float y = (pt.y - y_center_) * m_per_px_y_;
+  float z = distance_m_;
+  float r = 1.0f / std::sqrt((x * x) + (y * y) + (z * z));
+  return { x * r, y * r, z * r };
+}
+
+float
+VisualAngle::angle(Direction const& a, Direction const& b)
+{
+  // Angle subtended by chord c of the unit sphere, 2 asin(c / 2), by its
+  // series to the term in c^7: within 0.01 degree up to 60 degrees
+  float dx  = a.x - b.x;
+  float dy  = a.y - b.y;
+  float dz  = a.z - b.z;
+  float cc  = (dx * dx) + (dy * dy) + (dz * dz);
+  float c   = std::sqrt(cc);
+  float rad = c * (1.0f + cc * (1.0f / 24 + cc * (3.0f / 640
+                                          + cc * (5.0f / 7168))));
+  return static_cast<float>(rad * (180.0 / pi));
+}
+
+float
+VisualAngle::distance(PointXY<float> a, PointXY<float> b) const
+{
+  return angle(direction(a), direction(b));
+}
+
+float
+VisualAngle::pixels(float deg) const
+{
+  if (m_per_px_x_ <= 0) { return 0.0f; }
+  return static_cast<float>(2.0 * distance_m_ * std::tan(deg * pi / 360.0)
+                            / m_per_px_x_);
+}
+
+float
+VisualAngle::distance_m() const
+{
+  return distance_m_;
+}
+
+//---------------------------------------------------------------------------
+// private
+
+float
+VisualAngle::lookup(std::vector<float> const& t, float v0, float v)
+{
+  // Table has at least one entry, and two for a nonzero screen size
+  std::size_t const last = t.size() - 1;
+  if (last == 0) { return t[0]; }
+
+  // Clamp the interval, so that points beyond the table are extrapolated
+  float const f = std::isfinite(v) ? (v - v0) : 0.0f;
+  std::size_t i = 0;
+  if (f >= last)    { i = last - 1; }
+  else if (f > 0)   { i = static_cast<std::size_t>(f); }
+  return t[i] + (f - float(i)) * (t[i + 1] - t[i]);
+}
+
+//---------------------------------------------------------------------------
+
+AngularVelocity::AngularVelocity(Screen const& scr, float distance_m)
+: angle_(scr, distance_m)
+{}
+
+float
+AngularVelocity::update(Gaze const& g)
+{
+  bool valid = g.tracking.gaze
+            && std::isfinite(g.avg_px.x) && std::isfinite(g.avg_px.y)
+            && ((g.avg_px.x != 0) || (g.avg_px.y != 0));
+  return update(g.time_ms, g.avg_px.x, g.avg_px.y, valid);
+}
+
+float
+AngularVelocity::update(unsigned time_ms, float x_px, float y_px, bool valid)
+{
+  if (!valid)
+  {
+    clear();
+    return 0.0f;
+  }
+
+  // A timestamp out of order restarts from this sample
+  auto const d = angle_.direction({ x_px, y_px });
+  if (has_last_ && (time_ms >= time_ms_))
+  {
+    amplitude_  = VisualAngle::angle(direction_, d);
+    unsigned dt = time_ms - time_ms_;
+    velocity_   = dt ? amplitude_ * 1000.0f / dt : 0.0f;
+  }
+  else
+  {
+    has_last_   = true;
+    amplitude_  = 0.0f;
+    velocity_   = 0.0f;
+  }
+  time_ms_    = time_ms;
+  point_      = { x_px, y_px };
+  direction_  = d;
+  return velocity_;
+}
+
+float
+AngularVelocity::velocity() const
+{
+  return velocity_;
+}
+
+float
+AngularVelocity::amplitude() const
+{
+  return amplitude_;
+}
+
+PointXY<float>
+AngularVelocity::position() const
+{
+  return angle_.degrees(point_);
+}
+
+VisualAngle const&
+AngularVelocity::angle() const
+{
+  return angle_;
+}
+
+void
+AngularVelocity::clear()
+{
+  has_last_   = false;
+  amplitude_  = 0.0f;
+  velocity_   = 0.0f;
+}
+
+//---------------------------------------------------------------------------
+
+} // eye
+//===========================================================================//
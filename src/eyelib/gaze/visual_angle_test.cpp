@@ -0,0 +1,168 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib.hpp>
+
+#include "debug/benchmark.hpp"  // eye::debug::measure, eye::debug::samples
+
+#include <algorithm>  // std::max
+#include <cmath>      // std::atan, std::atan2, std::abs, std::sqrt
+#include <iomanip>    // std::setw
+#include <iostream>   // std::cout
+#include <vector>     // std::vector
+
+namespace {   //-------------------------------------------------------------
+
+using eye::debug::measure;
+using eye::debug::sample_count;
+
+constexpr double    pi            = 3.14159265358979323846;
+constexpr float     distance_m    = 0.6f;     // Viewing distance
+
+// 24 inch 16:9 display
+eye::Screen const display(0, 0, 0, 1920, 1080, 0.5313f, 0.2989f);
+
+// Ray from the eye to a point, in meters
+struct Ray
+{
+  double x, y, z;
+};
+
+Ray
+ray(float x_px, float y_px)
+{
+  return { (x_px - 0.5 * display.w_px) * display.w_m / display.w_px,
+           (y_px - 0.5 * display.h_px) * display.h_m / display.h_px,
+           distance_m };
+}
+
+// Angle in degrees subtended by m meters from the screen center
+double
+degrees(double m)
+{
+  return std::atan(m / distance_m) * 180.0 / pi;
+}
+
+// Angle in degrees between rays from the eye, with atan per sample
+double
+degrees(Ray const& a, Ray const& b)
+{
+  double cx = (a.y * b.z) - (a.z * b.y);
+  double cy = (a.z * b.x) - (a.x * b.z);
+  double cz = (a.x * b.y) - (a.y * b.x);
+  double dot = (a.x * b.x) + (a.y * b.y) + (a.z * b.z);
+  return std::atan2(std::sqrt((cx * cx) + (cy * cy) + (cz * cz)), dot)
+         * 180.0 / pi;
+}
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye { namespace gaze { namespace debug {
+
+void
+angle_benchmark()
+{
+  std::cout <<'\n'<< "eyelib: Visual angle (" << sample_count
+            << " samples per measurement, " << distance_m
+            << " m viewing distance)" <<'\n'<<'\n';
+
+  // Gaze over the screen, with points slightly off screen
+  auto const v = eye::debug::samples({ 5, -50.0f, 1970.0f,
+                                          -50.0f, 1130.0f, 12, 30, 2.0f });
+
+  // Largest errors of angles from the screen center, and of velocities
+  eye::AngularVelocity av(display, distance_m);
+  double pos_err = 0.0, vel_err = 0.0, vel_rel = 0.0, vel_max = 0.0;
+  for (std::size_t i = 0; i != v.size(); ++i)
+  {
+    double a = av.update(v[i].time_ms, v[i].x, v[i].y);
+    Ray const r = ray(v[i].x, v[i].y);
+    auto const p = av.position();
+    pos_err = std::max(pos_err, std::abs(p.x - degrees(r.x)));
+    pos_err = std::max(pos_err, std::abs(p.y - degrees(r.y)));
+    if (i == 0) { continue; }
+
+    double e = degrees(ray(v[i-1].x, v[i-1].y), r) * 1000.0
+             / (v[i].time_ms - v[i-1].time_ms);
+    vel_err = std::max(vel_err, std::abs(a - e));
+    vel_max = std::max(vel_max, e);
+    if (e > 30.0)
+    {
+      vel_rel = std::max(vel_rel, std::abs(a - e) / e);
+    }
+  }
+
+  // A sample earlier than the previous one restarts with zero velocity,
+  // and the next velocity is from that sample
+  eye::AngularVelocity restart(display, distance_m);
+  restart.update(1000, 100.0f, 100.0f);
+  double const out_of_order = restart.update(983, 900.0f, 500.0f);
+  double const next = restart.update(1000, 910.0f, 500.0f);
+  double const expected = degrees(ray(900.0f, 500.0f), ray(910.0f, 500.0f))
+                        * 1000.0 / 17;
+
+  bool const ok = (pos_err < 1e-3) && (vel_rel < 1e-3) && (out_of_order == 0)
+               && (std::abs(next - expected) < 1e-3 * expected);
+  eye::debug::verdict("agreement with atan per sample", ok);
+  std::cout << std::fixed << std::setprecision(5)
+            << "largest error, position     " << std::setw(10) << pos_err
+            << " deg" <<'\n'
+            << "largest error, velocity     " << std::setw(10) << vel_err
+            << " deg/s (of " << std::setprecision(1) << vel_max << ")"
+            <<'\n'
+            << std::setprecision(5)
+            << "  over 30 deg/s             " << std::setw(10)
+            << vel_rel * 100.0 << " %" <<'\n'<<'\n';
+
+  double const atan_ns = measure(v.size(), [&v]()
+    {
+      float sum = 0;
+      for (std::size_t i = 1; i < v.size(); ++i)
+      {
+        double d = degrees(ray(v[i-1].x, v[i-1].y), ray(v[i].x, v[i].y));
+        sum += static_cast<float>(d * 1000.0
+                                  / (v[i].time_ms - v[i-1].time_ms));
+      }
+      return sum;
+    });
+  double const table_ns = measure(v.size(), [&v]()
+    {
+      float sum = 0;
+      eye::AngularVelocity av(display, distance_m);
+      for (auto const& s : v) { sum += av.update(s.time_ms, s.x, s.y); }
+      return sum;
+    });
+
+  std::cout << "angular velocity                per sample" << '\n'
+            << std::setprecision(1)
+            << "atan per sample               " << std::setw(10) << atan_ns
+            << " ns" << '\n'
+            << "AngularVelocity               " << std::setw(10) << table_ns
+            << " ns" << '\n';
+  eye::debug::rule();
+}
+
+} } } // eye::gaze::debug
+//===========================================================================//
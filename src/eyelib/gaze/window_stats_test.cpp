@@ -0,0 +1,171 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib.hpp>
+
+#include "debug/benchmark.hpp"  // eye::debug::measure
+
+#include <algorithm>  // std::max_element, std::min_element
+#include <cmath>      // std::abs
+#include <deque>      // std::deque
+#include <iomanip>    // std::setw
+#include <iostream>   // std::cout
+#include <numeric>    // std::accumulate
+#include <random>     // std::mt19937, std::normal_distribution
+#include <vector>     // std::vector
+
+namespace {   //-------------------------------------------------------------
+
+using eye::debug::measure;
+
+// Fewer samples and measurements than the other benchmarks, since a
+// scan of the largest window takes microseconds per sample
+constexpr unsigned  sample_count  = 100000;   // Samples per measurement
+constexpr unsigned  repeat_count  = 3;        // Best of measurements
+
+// Window of the last N samples, with statistics computed per query
+template<typename T, std::size_t N>
+class ScanWindow
+{
+public:
+  void
+  push(T v)
+  {
+    if (v_.size() == N) { v_.pop_front(); }
+    v_.push_back(v);
+  }
+
+  T sum() const   { return std::accumulate(v_.begin(), v_.end(), T{}); }
+  T mean() const  { return v_.empty() ? T{} : T(sum() / v_.size()); }
+  T max() const   { return *std::max_element(v_.begin(), v_.end()); }
+  T min() const   { return *std::min_element(v_.begin(), v_.end()); }
+
+private:
+  std::deque<T> v_{};
+};
+
+// Synthetic pupil sizes
+std::vector<float>
+samples()
+{
+  std::mt19937 rng(9);
+  std::normal_distribution<float> mm(3.5f, 0.4f);
+
+  std::vector<float> v(sample_count);
+  for (auto& x : v) { x = mm(rng); }
+  return v;
+}
+
+// Mean time per sample of the best of repeated runs, with the
+// queries of the gaze metrics per sample: mean, max and sum
+template<typename W>
+double
+queries(std::vector<float> const& v)
+{
+  return measure(v.size(), [&v]()
+    {
+      W w;
+      float sum = 0;
+      for (auto x : v)
+      {
+        w.push(x);
+        sum += w.mean() + w.max() + w.sum();
+      }
+      return sum;
+    }, repeat_count);
+}
+
+// Compare statistics with a scan of the window, and the variance
+// with a two pass computation
+template<std::size_t N>
+bool
+agreement(std::vector<float> const& v)
+{
+  eye::WindowStats<float, N, true> w;
+  std::deque<float> d;
+  for (auto x : v)
+  {
+    w.push(x);
+    d.push_back(x);
+    if (d.size() > N) { d.pop_front(); }
+
+    double sum = std::accumulate(d.begin(), d.end(), 0.0);
+    double mean = sum / d.size();
+    double m2 = 0;
+    for (auto y : d) { m2 += (y - mean) * (y - mean); }
+    double var = (d.size() < 2) ? 0.0 : (m2 / (d.size() - 1));
+
+    if ((w.max() != *std::max_element(d.begin(), d.end())) ||
+        (w.min() != *std::min_element(d.begin(), d.end())) ||
+        (std::abs(w.sum() - sum) > 1e-6 * sum) ||
+        (std::abs(w.variance() - var) > 1e-6 * var + 1e-9))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+template<std::size_t N>
+void
+compare(std::vector<float> const& v, bool& ok)
+{
+  // Agreement of all samples is slow for large windows
+  if (N <= 1000) { ok = ok && agreement<N>(v); }
+
+  std::cout << std::setw(6) << N
+            << std::setw(12) << queries<ScanWindow<float, N>>(v)
+            << std::setw(14) << queries<eye::WindowStats<float, N>>(v)
+            << std::setw(14) << queries<eye::WindowStats<float, N, true>>(v)
+            << '\n';
+}
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye { namespace gaze { namespace debug {
+
+void
+window_benchmark()
+{
+  std::cout <<'\n'<< "eyelib: Moving window statistics ("
+            << sample_count << " samples per measurement)" <<'\n'<<'\n';
+
+  auto const v = samples();
+
+  bool ok = true;
+  std::cout << "                   per sample (ns)" << '\n'
+            << "     N        scan   WindowStats  and variance" << '\n'
+            << std::fixed << std::setprecision(1);
+  compare<60>(v, ok);
+  compare<300>(v, ok);
+  compare<1000>(v, ok);
+  compare<10000>(v, ok);
+  std::cout << '\n';
+  eye::debug::verdict("Scan agreement", ok);
+  eye::debug::rule();
+}
+
+} } } // eye::gaze::debug
+//===========================================================================//
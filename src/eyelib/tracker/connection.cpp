@@ -0,0 +1,264 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include "tracker/connection.hpp"
+
+#include "debug/debug_out.hpp"  // eye::debug::error
+
+#include <asio.hpp>   // Asio library
+
+#include <algorithm>  // std::min
+#include <chrono>     // std::chrono::milliseconds
+#include <iterator>   // std::next
+#include <string>     // std::string, std::to_string
+#include <utility>    // std::move
+
+namespace {   //-------------------------------------------------------------
+
+constexpr char delimiter = '\n';    // Message delimiter
+
+// Connection attempts before giving up, and delays between them
+constexpr unsigned                  max_connect_attempts = 5;
+constexpr std::chrono::milliseconds first_retry_delay{250};
+constexpr std::chrono::milliseconds max_retry_delay{2000};
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye { namespace tracker {
+
+//---------------------------------------------------------------------------
+
+Connection::Connection(std::string const& host, std::string const& port,
+                       read_handler callback)
+: socket_(io_)
+, retry_timer_(io_)
+, host_(host)
+, port_(port)
+, call_read_handler(callback)
+, call_state_handler([](bool, std::string const&){})  // do-nothing callback
+{}
+
+Connection::~Connection()
+{}
+
+//---------------------------------------------------------------------------
+
+asio::io_context&
+Connection::context()
+{
+  return io_;
+}
+
+void
+Connection::register_handler(state_handler callback)
+{
+  if (callback)
+  {
+    call_state_handler = callback;
+  }
+}
+
+Connection::clock::time_point
+Connection::last_write() const
+{
+  return last_write_;
+}
+
+void
+Connection::run()
+{
+  connect();
+  io_.run();      // Blocks until stopped or out of work
+}
+
+void
+Connection::stop()
+{
+  asio::post(io_, [this](){ close(); io_.stop(); });
+}
+
+void
+Connection::reconnect()
+{
+  asio::post(io_, [this]()
+    {
+      close();
+      attempts_ = 0;
+      connect();
+    });
+}
+
+void
+Connection::write(std::string msg)
+{
+  std::lock_guard<std::mutex> lock(pending_mutex_);
+  pending_.push_back(std::move(msg));
+  if (!flush_posted_)
+  {
+    // One flush per I/O turn sends everything queued until then
+    flush_posted_ = true;
+    asio::post(io_, [this](){ flush(); });
+  }
+}
+
+//---------------------------------------------------------------------------
+// private
+
+void
+Connection::connect()
+{
+  asio::ip::tcp::resolver resolver(io_);
+  asio::error_code ec;
+  auto endpoints = resolver.resolve(host_, port_, ec);
+  if (ec)
+  {
+    retry("resolve failed: " + ec.message());
+    return;
+  }
+  asio::async_connect(socket_, endpoints,
+    [this](asio::error_code const& ec, asio::ip::tcp::endpoint const&)
+    {
+      if (ec == asio::error::operation_aborted) { return; }   // Closed
+      if (ec)
+      {
+        retry("connect failed: " + ec.message());
+        return;
+      }
+      connected_  = true;
+      attempts_   = 0;
+      call_state_handler(true, "");
+      read();
+      flush();          // Send messages queued before connecting
+    });
+}
+
+void
+Connection::retry(std::string const& error)
+{
+  eye::debug::error(__FILE__, __LINE__, error);
+  if (++attempts_ >= max_connect_attempts)
+  {
+    call_state_handler(false, error + " (gave up after "
+                              + std::to_string(attempts_) + " attempts)");
+    return;
+  }
+  call_state_handler(false, error);
+
+  // Double the delay after each failed attempt
+  auto delay = std::min<std::chrono::milliseconds>(
+                 first_retry_delay * (1u << (attempts_ - 1)), max_retry_delay);
+  retry_timer_.expires_after(delay);
+  retry_timer_.async_wait([this](asio::error_code const& ec)
+    {
+      if (!ec) { connect(); }
+    });
+}
+
+void
+Connection::lost(char const* what, asio::error_code const& ec)
+{
+  // Reported once, by whichever of the read and write fails first
+  if (!connected_) { return; }
+  eye::debug::error(__FILE__, __LINE__, what, ec.message());
+  close();
+  call_state_handler(false, std::string(what) + ": " + ec.message());
+  attempts_ = 0;
+  connect();
+}
+
+void
+Connection::read()
+{
+  asio::async_read_until(socket_, read_buffer_, delimiter,
+    [this](asio::error_code const& ec, std::size_t n)
+    {
+      if (ec)
+      {
+        if (ec != asio::error::operation_aborted) { lost("read failed", ec); }
+        return;
+      }
+      // Extract one message, excluding the delimiter
+      auto begin = asio::buffers_begin(read_buffer_.data());
+      std::string msg(begin, std::next(begin, n - 1));
+      read_buffer_.consume(n);
+
+      call_read_handler(msg);
+      read();
+    });
+}
+
+void
+Connection::flush()
+{
+  // Only one write may be outstanding on the socket.  Pending messages stay
+  // queued; the connect or write completion handler flushes them.
+  if (!connected_ || !writing_.empty()) { return; }
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    flush_posted_ = false;
+    writing_.swap(pending_);
+  }
+  if (writing_.empty()) { return; }
+
+  // Gather all messages, each followed by a delimiter, into one write
+  write_buffers_.clear();
+  write_buffers_.reserve(2 * writing_.size());
+  for (auto const& msg : writing_)
+  {
+    write_buffers_.push_back(asio::buffer(msg));
+    write_buffers_.push_back(asio::buffer(&delimiter, 1));
+  }
+  asio::async_write(socket_, write_buffers_,
+    [this](asio::error_code const& ec, std::size_t)
+    {
+      if (ec)
+      {
+        if (ec != asio::error::operation_aborted) { lost("write failed", ec); }
+        return;
+      }
+      last_write_ = clock::now();
+      writing_.clear();
+      flush();          // Send messages queued during the write
+    });
+}
+
+void
+Connection::close()
+{
+  // Pending handlers complete with operation_aborted.  Messages being
+  // written are discarded, so that the next connection can flush.
+  connected_ = false;
+  retry_timer_.cancel();
+  writing_.clear();
+  read_buffer_.consume(read_buffer_.size());
+  asio::error_code ec;
+  socket_.shutdown(asio::ip::tcp::socket::shutdown_both, ec);
+  socket_.close(ec);
+}
+
+//---------------------------------------------------------------------------
+
+} } // eye::tracker
+//===========================================================================//
@@ -0,0 +1,152 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Eye tracker server connection.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_TRACKER_CONNECTION_HPP
+#define EYELIB_TRACKER_CONNECTION_HPP
+
+#include <asio.hpp>   // Asio library
+
+#include <chrono>     // std::chrono::steady_clock
+#include <functional> // std::function
+#include <mutex>      // std::mutex, std::lock_guard
+#include <string>     // std::string
+#include <vector>     // std::vector
+
+namespace eye { namespace tracker {
+
+/// @addtogroup eyelib_tracker
+/// @{
+
+/**
+  @brief  Asynchronous TCP connection to an eye tracker server.
+
+  All socket operations and timers run on a single I/O context, which is
+  driven by the thread that calls `run()`.  Messages are newline delimited
+  in both directions.  Each complete message received from the server is
+  passed to the read handler, without the delimiter, on the I/O thread.
+
+  `write()` may be called from any thread.  Messages are queued, and all
+  messages pending when the I/O thread next runs are coalesced into one
+  scatter/gather write, so bursts of requests cost one system call rather
+  than one each.  Messages written before the connection is established
+  are queued and sent once connected.
+
+  A connection that fails, or is lost on a read or write error, is closed
+  and reopened, with a delay that doubles after each failed attempt, up
+  to a fixed number of attempts.  The state handler is invoked on the I/O
+  thread on each connection and on each error, so that the owner can
+  restart its protocol or report the loss.  Messages being written when
+  the connection is lost are discarded; those still queued are sent once
+  reconnected.
+*/
+class Connection
+{
+public:
+
+  using clock = std::chrono::steady_clock;    ///< Timer clock.
+
+  /// Message received handler alias.
+  using read_handler = std::function<void(std::string const&)>;
+
+  /// @brief  Connection state handler alias.
+  ///
+  /// Invoked with `true` and an empty string when connected, or with
+  /// `false` and a description of the error when a connection attempt
+  /// fails or the connection is lost.
+  using state_handler = std::function<void(bool connected,
+                                           std::string const& error)>;
+
+  /// @brief  Construct a connection.
+  /// @param  [in]  host      TCP address string.
+  /// @param  [in]  port      Port number string.
+  /// @param  [in]  callback  Invoked for each message received.
+  Connection(std::string const& host, std::string const& port,
+             read_handler callback);
+
+  ~Connection();                                    ///< Destructor.
+  Connection(Connection const&)            = delete;  ///< Prohibit copying.
+  Connection& operator=(Connection const&) = delete;  ///< Prohibit assignment.
+
+  /// I/O context on which connection handlers and timers run.
+  asio::io_context& context();
+
+  /// Register to receive connection state changes via @a callback.
+  void register_handler(state_handler callback);
+
+  /// @brief  Time the last outbound message finished sending.
+  /// @note   Only valid when called from the I/O thread.
+  clock::time_point last_write() const;
+
+  /// Connect and process I/O.  Blocks until `stop()` is called.
+  void run();
+
+  /// Close connection and stop processing I/O.
+  void stop();
+
+  /// Close the connection and open a new one.
+  void reconnect();
+
+  /// Send @a msg to the server.
+  void write(std::string msg);
+
+private:
+  void connect();
+  void retry(std::string const& error);
+  void lost(char const* what, asio::error_code const& ec);
+  void read();
+  void flush();
+  void close();
+
+  asio::io_context        io_{};
+  asio::ip::tcp::socket   socket_;
+  asio::steady_timer      retry_timer_;
+  std::string             host_;
+  std::string             port_;
+  read_handler            call_read_handler;
+  state_handler           call_state_handler;
+
+  // Guarded by pending_mutex_
+  std::mutex                pending_mutex_{};
+  std::vector<std::string>  pending_{};         // Messages awaiting flush
+  bool                      flush_posted_{false};
+
+  // Accessed only from the I/O thread
+  asio::streambuf                 read_buffer_{};
+  std::vector<std::string>        writing_{};   // Messages being written
+  std::vector<asio::const_buffer> write_buffers_{};
+  clock::time_point               last_write_{};
+  bool                            connected_{false};
+  unsigned                        attempts_{0};  // Failed connect attempts
+};
+
+/// @}
+
+} } // eye::tracker
+
+#endif // EYELIB_TRACKER_CONNECTION_HPP
+//===========================================================================//
@@ -0,0 +1,137 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include "tracker/heartbeat.hpp"
+
+#include "tracker/message.hpp"  // eye::tracker::message::REQUEST_HEARTBEAT
+
+#include <algorithm>  // std::max
+#include <chrono>     // std::chrono::milliseconds
+
+namespace {   //-------------------------------------------------------------
+
+namespace msg = eye::tracker::message;
+
+// Lower bound on the time to wait for a heartbeat response
+constexpr std::chrono::milliseconds min_response_timeout{50};
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye { namespace tracker {
+
+//---------------------------------------------------------------------------
+
+Heartbeat::Heartbeat(Connection& conn)
+: conn_(conn)
+, timer_(conn.context())
+, call_timeout_handler([](unsigned){})  // do-nothing callback
+{}
+
+void
+Heartbeat::register_handler(timeout_handler callback)
+{
+  if (callback)
+  {
+    call_timeout_handler = callback;
+  }
+}
+
+void
+Heartbeat::start(unsigned interval_ms)
+{
+  asio::post(conn_.context(), [this, interval_ms]()
+    {
+      interval_ = std::chrono::milliseconds(interval_ms);
+      response_timeout_ = std::max<clock::duration>(interval_ / 2,
+                                                    min_response_timeout);
+      if (!running_)
+      {
+        running_  = true;
+        awaiting_ = false;
+        missed_   = 0;
+      }
+      schedule(conn_.last_write() + interval_);
+    });
+}
+
+void
+Heartbeat::stop()
+{
+  asio::post(conn_.context(), [this]()
+    {
+      running_ = false;
+      timer_.cancel();
+    });
+}
+
+void
+Heartbeat::received()
+{
+  awaiting_ = false;
+  missed_   = 0;
+}
+
+//---------------------------------------------------------------------------
+// private
+
+void
+Heartbeat::schedule(clock::time_point when)
+{
+  timer_.expires_at(when);
+  timer_.async_wait([this](asio::error_code const& ec){ on_timer(ec); });
+}
+
+void
+Heartbeat::on_timer(asio::error_code const& ec)
+{
+  // Cancelled by stop() or rescheduled by start()
+  if (ec == asio::error::operation_aborted || !running_) { return; }
+
+  auto now = clock::now();
+
+  // Response deadline passed without a response
+  if (awaiting_)
+  {
+    awaiting_ = false;
+    call_timeout_handler(++missed_);
+  }
+
+  // Suppress heartbeat if other outbound traffic satisfied the interval
+  auto due = conn_.last_write() + interval_;
+  if (due > now)
+  {
+    schedule(due);
+    return;
+  }
+
+  conn_.write(msg::REQUEST_HEARTBEAT);
+  awaiting_ = true;
+  schedule(now + response_timeout_);    // Check for response
+}
+
+//---------------------------------------------------------------------------
+
+} } // eye::tracker
+//===========================================================================//
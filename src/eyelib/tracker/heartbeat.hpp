@@ -0,0 +1,104 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Eye tracker server heartbeat.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_TRACKER_HEARTBEAT_HPP
+#define EYELIB_TRACKER_HEARTBEAT_HPP
+
+#include "tracker/connection.hpp"
+
+#include <asio.hpp>   // Asio library
+
+#include <functional> // std::function
+
+namespace eye { namespace tracker {
+
+/// @addtogroup eyelib_tracker
+/// @{
+
+/**
+  @brief  Periodic heartbeat to maintain the server connection.
+
+  Driven by a timer on the connection's I/O context, so no extra thread
+  is needed and all state is accessed only from the I/O thread.
+
+  A heartbeat is sent when no other message has been sent for the
+  heartbeat interval, since any outbound traffic satisfies the server.
+  After each heartbeat, a response is expected within half the interval;
+  if none arrives, the timeout handler is invoked with the number of
+  consecutive missed responses.
+*/
+class Heartbeat
+{
+public:
+
+  /// Missed response handler alias.
+  using timeout_handler = std::function<void(unsigned missed)>;
+
+  /// Construct a heartbeat for @a conn.  Not started until `start()`.
+  explicit
+  Heartbeat(Connection& conn);
+
+  Heartbeat(Heartbeat const&)            = delete;  ///< Prohibit copying.
+  Heartbeat& operator=(Heartbeat const&) = delete;  ///< Prohibit assignment.
+
+  /// Register to receive missed response notifications via @a callback.
+  void register_handler(timeout_handler callback);
+
+  /// Start, or change the interval of, the heartbeat.
+  void start(unsigned interval_ms);
+
+  /// Stop sending heartbeats.
+  void stop();
+
+  /// @brief  Notify that a heartbeat response was received.
+  /// @note   Must be called from the I/O thread.
+  void received();
+
+private:
+  using clock = Connection::clock;
+
+  void schedule(clock::time_point when);
+  void on_timer(asio::error_code const& ec);
+
+  Connection&         conn_;
+  asio::steady_timer  timer_;
+  timeout_handler     call_timeout_handler;
+
+  clock::duration     interval_{};
+  clock::duration     response_timeout_{};
+  bool                awaiting_{false};   // Heartbeat sent, no response yet
+  bool                running_{false};
+  unsigned            missed_{0};         // Consecutive missed responses
+};
+
+/// @}
+
+} } // eye::tracker
+
+#endif // EYELIB_TRACKER_HEARTBEAT_HPP
+//===========================================================================//
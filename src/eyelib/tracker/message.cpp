@@ -33,7 +33,10 @@ SOFTWARE.
 
 #include <array>      // std::array
 //#include <iostream>   // std::cout
+#include <cstdio>     // std::snprintf
 #include <exception>  // std::exception
+#include <limits>     // std::numeric_limits
+#include <string>     // std::string
 
 namespace {   //-------------------------------------------------------------
 
@@ -88,6 +91,25 @@ pupil(nlohmann::json const& eye_data)
   return {{x, y}, size};
 }
 
+//-----------------------------------------------------------
+// Formatting for serialized requests
+
+void
+append(std::string& str, unsigned val)
+{
+  str += std::to_string(val);
+}
+
+void
+append(std::string& str, double val)
+{
+  // Enough digits to round-trip, matching the value nlohmann::json stores
+  char buf[32];
+  int n = std::snprintf(buf, sizeof(buf), "%.*g",
+                        std::numeric_limits<double>::max_digits10, val);
+  str.append(buf, n);
+}
+
 } // anonymous --------------------------------------------------------------
 
 
@@ -258,6 +280,50 @@ try_update(Message const& msg, Tracker::State& ts)
   return (ts != tmp);
 }
 
+//---------------------------------------------------------------------------
+// Serialized requests
+//
+// Fixed text is spliced with formatted field values.  Capacity is reserved
+// for the template plus the widest values, so each call allocates once.
+
+std::string
+serialized::set(Screen const& scr)
+{
+  std::string str;
+  str.reserve(160);
+  str += "{\"category\":\"tracker\",\"request\":\"set\",\"values\":{"
+         "\"screenindex\":";  append(str, scr.index);
+  str += ",\"screenresw\":";  append(str, scr.w_px);
+  str += ",\"screenresh\":";  append(str, scr.h_px);
+  str += ",\"screenpsyw\":";  append(str, scr.w_m);
+  str += ",\"screenpsyh\":";  append(str, scr.h_m);
+  str += "}}";
+  return str;
+}
+
+std::string
+serialized::calibration_start(unsigned point_count)
+{
+  std::string str;
+  str.reserve(80);
+  str += "{\"category\":\"calibration\",\"request\":\"start\",\"values\":{"
+         "\"pointcount\":";   append(str, point_count);
+  str += "}}";
+  return str;
+}
+
+std::string
+serialized::calibration_point_start(unsigned x, unsigned y)
+{
+  std::string str;
+  str.reserve(96);
+  str += "{\"category\":\"calibration\",\"request\":\"pointstart\","
+         "\"values\":{\"x\":";  append(str, x);
+  str += ",\"y\":";             append(str, y);
+  str += "}}";
+  return str;
+}
+
 //---------------------------------------------------------------------------
 
 } } } // eye::tracker::message
@@ -625,6 +625,25 @@ calibration_state()
             { "iscalibrated", "iscalibrating" }}};
 }
 
+/// @}
+//---------------------------------------------------------------------------
+/// @name Serialized Requests
+/// Requests formatted directly into a string, without building a JSON
+/// object.  Equivalent to the functions above followed by `dump()`.
+/// @{
+namespace serialized {
+
+/// Return serialized message to write screen parameters.
+std::string set(Screen const& scr);
+
+/// Return serialized message to prepare tracker for calibration.
+std::string calibration_start(unsigned point_count);
+
+/// Return serialized message to start calibration point.
+std::string calibration_point_start(unsigned x, unsigned y);
+
+} // serialized
+
 /// @}
 //---------------------------------------------------------------------------
 /// @name Pre-defined Requests
@@ -651,6 +670,12 @@ constexpr auto GET_GAZE_DATA = "{"
       "\"frame\""
     "]}";
 
+/// Request heartbeat interval in milliseconds.
+constexpr auto GET_HEARTBEAT_INTERVAL = "{"
+    "\"category\":\"tracker\",\"request\":\"get\",\"values\":["
+      "\"heartbeatinterval\""
+    "]}";
+
 /// Request screen parameters.
 constexpr auto GET_SCREEN = "{"
     "\"category\":\"tracker\",\"request\":\"get\",\"values\":["
@@ -670,6 +695,21 @@ constexpr auto GET_TRACKER_STATE = "{"
       "\"iscalibrating\""
     "]}";
 
+/// Stop calibration point.
+constexpr auto CALIBRATION_POINT_END = "{"
+    "\"category\":\"calibration\",\"request\":\"pointend\""
+  "}";
+
+/// Cancel ongoing calibration sequence.
+constexpr auto CALIBRATION_ABORT = "{"
+    "\"category\":\"calibration\",\"request\":\"abort\""
+  "}";
+
+/// Remove current calibration from tracker.
+constexpr auto CALIBRATION_CLEAR = "{"
+    "\"category\":\"calibration\",\"request\":\"clear\""
+  "}";
+
 /// Request connection with server.
 constexpr auto REQUEST_CONNECT = "{"
     "\"category\":\"tracker\","
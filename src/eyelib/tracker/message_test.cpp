@@ -25,7 +25,10 @@ SOFTWARE.
 
 #include "tracker/message.hpp"
 
-#include <eyelib/screen.hpp>   // eye::Screen
+#include "debug/benchmark.hpp"   // eye::debug::verdict
+
+#include <eyelib/calibration.hpp> // eye::recalibration_targets
+#include <eyelib/screen.hpp>      // eye::Screen
 
 #include <utl/json.hpp>   // nlohmann::json
 
@@ -52,6 +55,28 @@ calibration()
     <<'\n'<< "calibration_result() : "    << m::calibration_result().dump(2)
     <<'\n'<< "calibration_state() : "     << m::calibration_state().dump(2)
     <<'\n';
+
+  // Nine good points, one of which must be sampled again
+  using R = eye::Calibration::Rating;
+  using S = eye::Calibration::Point::State;
+  eye::Calibration c;
+  for (unsigned i = 0; i != 9; ++i)
+  {
+    eye::Calibration::Point p;
+    p.sample_state = S::ok;
+    p.calibrate_px = { 100 + 200 * (i % 3), 100 + 200 * (i / 3) };
+    p.accuracy_deg = { 0.5f + 0.01f * i, 0.5f, 0.5f };
+    p.accuracy_rating = { R::good, R::good, R::good };
+    c.points.push_back(p);
+  }
+  c.points[4].sample_state = S::resample;
+  auto targets = eye::recalibration_targets(c);
+  std::cout <<'\n'<< "recalibration_targets(c) : " << targets.size()
+            << " of " << c.points.size() << " points" <<'\n';
+  eye::debug::verdict("only the bad point", (targets.size() == 1)
+                      && (targets[0].x_px == 300) && (targets[0].y_px == 300));
+  eye::debug::verdict("padded to nine",
+                      eye::recalibration_targets(c, 9).size() == 9);
 }
 
 void
@@ -80,6 +105,8 @@ predefined()
       <<'\n'<< "GET_CALIBRATION : "  << j::parse(m::GET_CALIBRATION).dump(2)
       <<'\n'<< "GET_DEVICE_STATE : " << j::parse(m::GET_DEVICE_STATE).dump(2)
       <<'\n'<< "GET_GAZE_DATA : "    << j::parse(m::GET_GAZE_DATA).dump(2)
+      <<'\n'<< "GET_HEARTBEAT_INTERVAL : "
+                  << j::parse(m::GET_HEARTBEAT_INTERVAL).dump(2)
       <<'\n'<< "GET_SCREEN : "       << j::parse(m::GET_SCREEN).dump(2)
       <<'\n'<< "REQUEST_CONNECT : "  << j::parse(m::REQUEST_CONNECT).dump(2)
       <<'\n'<< "REQUEST_HEARTBEAT : "<< j::parse(m::REQUEST_HEARTBEAT).dump(2)
@@ -116,6 +143,38 @@ requests()
     <<'\n';
 }
 
+// Compare serialized request to equivalent JSON object.
+void
+compare(std::string const& name, std::string const& str,
+        nlohmann::json const& j)
+{
+  bool same = (nlohmann::json::parse(str) == j);
+  std::cout <<'\n'<< name << " : " << (same ? "OK" : "MISMATCH")
+            <<'\n'<< str <<'\n';
+}
+
+void
+serialized_requests()
+{
+  namespace m = eye::tracker::message;
+  namespace s = eye::tracker::message::serialized;
+
+  eye::Screen scr(1, 1600, 0, 1920, 1200, 0.508, 0.3175);
+
+  std::cout << "----------------------------------------------------"
+      <<'\n'<< "Serialized requests" << '\n';
+  compare("set(Screen{ ... })", s::set(scr), m::set(scr));
+  compare("calibration_start(9)", s::calibration_start(9),
+          m::calibration_start(9));
+  compare("calibration_point_start(100, 200)",
+          s::calibration_point_start(100, 200),
+          m::calibration_point_start(100, 200));
+  compare("CALIBRATION_POINT_END", m::CALIBRATION_POINT_END,
+          m::calibration_point_end());
+  compare("CALIBRATION_ABORT", m::CALIBRATION_ABORT, m::calibration_abort());
+  compare("CALIBRATION_CLEAR", m::CALIBRATION_CLEAR, m::calibration_clear());
+}
+
 } // anonymous --------------------------------------------------------------
 
 namespace eye { namespace tracker { namespace message { namespace debug {
@@ -133,11 +192,13 @@ message_test(TestMessage const& t)
         ostream_string();
         predefined();
         requests();
+        serialized_requests();
         break;
       case TestMessage::calibration:      calibration();      break;
       case TestMessage::ostream_string:   ostream_string();   break;
       case TestMessage::predefined:       predefined();       break;
       case TestMessage::requests:         requests();         break;
+      case TestMessage::serialized:       serialized_requests(); break;
       default:
         break;  // invalid
     }
@@ -25,13 +25,16 @@ SOFTWARE.
 
 #include <eyelib.hpp>
 
+#include "calibration/calibration_store.hpp"
 #include "calibration/calibrator.hpp"
+#include "calibration/validator.hpp"
 #include "debug/debug_out.hpp"
 #include "gaze/gaze_target.hpp"
+#include "tracker/connection.hpp"
+#include "tracker/heartbeat.hpp"
 #include "tracker/message.hpp"
 #include "window/window.hpp"
 
-#include <utl/asio/tcp/client.hpp>  // utl::io::tcp::server
 #include <utl/json.hpp>             // nlohmann::json
 #include <utl/memory.hpp>           // utl::make_unique
 #include <utl/string.hpp>           // utl::parse
@@ -41,6 +44,7 @@ SOFTWARE.
 #include <chrono>     // std::chrono::milliseconds
 #include <exception>  // std::exception
 #include <string>     // std::string
+#include <utility>    // std::move
 #include <vector>     // std::vector
 #include <iostream>   // std::cout
 
@@ -49,11 +53,13 @@ SOFTWARE.
 #include <mutex>      // std::mutex, std::lock_guard
 
 //#define EYELIB_DEBUG
-//#define EYELIB_HEARTBEAT
 
 namespace {   //-------------------------------------------------------------
 namespace msg = eye::tracker::message;
 using     Msg = eye::tracker::Message;
+
+// Consecutive missed heartbeat responses before the connection is lost
+constexpr unsigned max_missed_heartbeats = 2;
 } // anonymous --------------------------------------------------------------
 
 namespace eye {
@@ -67,6 +73,8 @@ struct Tracker::Impl
 {
   Screen          screen_{};          // screen parameters
   Tracker::State  state_{};           // tracker state data
+  Calibration     calib_{};           // last calibration results
+  nlohmann::json  calib_raw_{};       // last raw calibration results
 
   calib_handler   call_calib_handler;   // calibration results callback
   gaze_handler    call_gaze_handler;    // gaze data callback
@@ -74,25 +82,32 @@ struct Tracker::Impl
 
   std::atomic<unsigned> gaze_time_ms_{0};   // timestamp of last gaze data
   mutable std::mutex    mutex_;             // mutual exclusion
- #ifdef EYELIB_HEARTBEAT
-  std::thread           heartbeat_thread_;  // sends periodic heartbeat
- #endif
   std::thread           tcp_thread_;        // asynchronous read and write
-  utl::io::tcp::client  tcp_;               // connection to device server
+  tracker::Connection   tcp_;               // connection to device server
+  tracker::Heartbeat    heartbeat_;         // keeps connection alive
 
   tracker::Calibrator   calibrator_;        // eye tracker calibration
+  tracker::Validator    validator_;         // accuracy and precision
+  tracker::CalibrationStore        store_{};   // calibrations on disk
+  tracker::CalibrationStore::Entry stored_{};  // participant's calibration
+  std::string           participant_{};     // store key, or empty
   GazeTarget            gaze_target_{};     // sequence of targets
 
+  Window*               session_{nullptr};  // open session window, if any
+  Tracker::Mode         mode_{Tracker::Mode::free_view};  // session mode
+
   Impl(std::string const& host, std::string const& port, Screen const& scr);
   ~Impl();
 
- #ifdef EYELIB_HEARTBEAT
-  void start_heartbeat(unsigned interval_ms);
- #endif
+  void set_mode(Window& win, Tracker::Mode m, Targets const& points,
+                TargetDuration const& target_ms);
+
   void calibrate(Window& win, Targets const& points,
                  TargetDuration const& target_ms);
 
   void handle_read(std::string const& str);
+  void handle_connection(bool connected, std::string const& error);
+  void handle_missed_heartbeat(unsigned missed);
   void process_calib_response(tracker::Message const& m);
   void process_tracker_response(tracker::Message const& m);
 };
@@ -106,13 +121,18 @@ Tracker::Impl::Impl(std::string const& host, std::string const& port,
 , call_gaze_handler([](eye::Gaze const&){})             // do-nothing callback
 , call_state_handler([](eye::Tracker::State const&){})  // do-nothing callback
 , mutex_()
-#ifdef EYELIB_HEARTBEAT
-, heartbeat_thread_()
-#endif
 , tcp_thread_()
-, tcp_(host, port, std::bind(&handle_read, this, std::placeholders::_1))
+, tcp_(host, port, std::bind(&Impl::handle_read, this, std::placeholders::_1))
+, heartbeat_(tcp_)
 , calibrator_(tcp_)
-{}
+, validator_(scr)
+{
+  tcp_.register_handler(
+    std::bind(&Impl::handle_connection, this,
+              std::placeholders::_1, std::placeholders::_2));
+  heartbeat_.register_handler(
+    std::bind(&Impl::handle_missed_heartbeat, this, std::placeholders::_1));
+}
 
 Tracker::Impl::~Impl()
 {
@@ -124,12 +144,7 @@ Tracker::Impl::~Impl()
   // Synchronize threads
   try
   {
-   #ifdef EYELIB_HEARTBEAT
-    if (heartbeat_thread_.joinable())
-    {
-      heartbeat_thread_.join();         // Wait for thread to finish
-    }
-   #endif
+    heartbeat_.stop();           // Cancel heartbeat timer
     tcp_.stop();                 // Close connection and stop client
     if (tcp_thread_.joinable())
     {
@@ -148,26 +163,51 @@ Tracker::Impl::~Impl()
 }
 
 //---------------------------------------------------------------------------
-#ifdef EYELIB_HEARTBEAT
+
 void
-Tracker::Impl::start_heartbeat(unsigned interval_ms)
+Tracker::Impl::set_mode(Window& win, Tracker::Mode m, Targets const& points,
+                        TargetDuration const& target_ms)
 {
-  heartbeat_thread_ = std::thread(
-      [this, interval_ms]   // Lambda to send period heartbeat to server
-      {
-        bool loop = true;
-        std::unique_lock<std::mutex> lock(mutex_);
-        while (loop)
-        {
-          tcp_.write(msg::REQUEST_HEARTBEAT);
-          lock.unlock();
-          std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
-          lock.lock();
-          loop = state_.is_started;
-        }
-      });
+  using M = Tracker::Mode;
+
+  // Assumes mutex_ is locked.  Changes below appear in a single frame.
+  win.begin_update();
+  calibrator_.stop();               // Stop previous mode
+  validator_.stop();
+  gaze_target_.set_targets({});
+  switch (m)
+  {
+    case M::targets:
+      win.reset("Eye Tracker Targets");
+      win.show_avg_gaze(false);
+      win.show_raw_gaze(false);
+      gaze_target_.register_window(win);
+      gaze_target_.set_targets(points, target_ms);
+      break;
+    case M::calibration:
+      win.reset("Eye Tracker Calibration");
+      win.show_avg_gaze(false);
+      win.show_raw_gaze(false);
+      calibrator_.setup(win, points, target_ms);
+      break;
+    case M::validation:
+      win.reset("Eye Tracker Validation");
+      win.show_avg_gaze(false);
+      win.show_raw_gaze(false);
+      validator_.setup(win, points, target_ms);
+      break;
+    case M::free_view:
+    default:
+      win.reset("Eye Tracker Gaze");
+      win.show_avg_gaze(true);
+      win.show_raw_gaze(true);
+      win.register_handler([](Window::Event const&){});   // No key handling
+      break;
+  }
+  win.end_update();
+  mode_ = m;
 }
-#endif
+
 //---------------------------------------------------------------------------
 
 // Should we wait for a response after each request?
@@ -229,6 +269,7 @@ Tracker::Impl::handle_read(std::string const& str)
     {
       case Msg::Category::calibration:
         calibrator_.process_response(message);
+        process_calib_response(message);
         continue;
       case Msg::Category::tracker:
         lock.unlock();
@@ -236,7 +277,8 @@ Tracker::Impl::handle_read(std::string const& str)
         lock.lock();
         continue;
       case Msg::Category::heartbeat:
-        continue;  // ignore
+        heartbeat_.received();
+        continue;
       default:
         eye::debug::error(__FILE__, __LINE__,
           "received unknown message category", message.json.dump(2));
@@ -248,6 +290,89 @@ Tracker::Impl::handle_read(std::string const& str)
 
 //---------------------------------------------------------------------------
 
+// Record the results of a completed calibration, and save them for the
+// participant if successful.  Assumes mutex_ is locked.
+void
+Tracker::Impl::process_calib_response(tracker::Message const& m)
+{
+  if (!m.has_value(Msg::Value::calibration_result))
+  {
+    return;
+  }
+  tracker::CalibrationStore::Entry e;
+  if (!msg::parse(m, e.calibration))
+  {
+    return;
+  }
+  e.raw = m.values.at(Msg::Value::calibration_result);
+  calib_     = e.calibration;   // The server now holds these results
+  calib_raw_ = e.raw;
+  if (!participant_.empty() && e.calibration.success
+      && store_.save(participant_, screen_, e.raw))
+  {
+    stored_ = std::move(e);
+  }
+}
+
+//---------------------------------------------------------------------------
+
+// Invoked on the I/O thread when the connection is opened, or when a
+// connection attempt fails or the connection is lost.
+void
+Tracker::Impl::handle_connection(bool connected, std::string const& error)
+{
+  std::unique_lock<std::mutex> lock(mutex_);  // acquire scoped lock on mutex
+
+  if (connected)
+  {
+    // Request a connection with the server on each new socket.  The
+    // server's response is handled in process_tracker_response().
+    if (state_.is_started) { tcp_.write(msg::REQUEST_CONNECT); }
+    if (state_.connection_error.empty()) { return; }
+    state_.connection_error.clear();
+  }
+  else
+  {
+    // Heartbeats resume once the server sends its interval
+    heartbeat_.stop();
+    state_.is_connected     = false;
+    state_.connection_error = error;
+  }
+  auto const state = state_;
+  lock.unlock();
+  call_state_handler(state);    // Invoke tracker state callback
+}
+
+//---------------------------------------------------------------------------
+
+// Invoked on the I/O thread when a heartbeat response is overdue.
+void
+Tracker::Impl::handle_missed_heartbeat(unsigned missed)
+{
+  std::unique_lock<std::mutex> lock(mutex_);  // acquire scoped lock on mutex
+
+  eye::debug::error(__FILE__, __LINE__, "missed heartbeat response",
+                    std::to_string(missed));
+
+  if (!state_.is_started || !state_.is_connected
+      || missed < max_missed_heartbeats)
+  {
+    return;
+  }
+  // Treat the connection as lost, and open a new one.  The connection
+  // handler requests a connection with the server once reconnected.
+  heartbeat_.stop();
+  state_.is_connected     = false;
+  state_.connection_error = "missed " + std::to_string(missed)
+                          + " heartbeat responses";
+  tcp_.reconnect();
+  auto const state = state_;
+  lock.unlock();
+  call_state_handler(state);    // Invoke tracker state callback
+}
+
+//---------------------------------------------------------------------------
+
 void
 Tracker::Impl::process_tracker_response(tracker::Message const& m)
 {
@@ -269,6 +394,8 @@ Tracker::Impl::process_tracker_response(tracker::Message const& m)
         if (msg::parse(m, g))
         {
           gaze_time_ms_ = g.time_ms;
+          calibrator_.handle(g, state_.frame_rate);  // Adaptive point timing
+          validator_.handle(g);                       // Validation samples
           lock.unlock();
           call_gaze_handler(g);   // Invoke gaze data callback
           lock.lock();
@@ -291,12 +418,21 @@ Tracker::Impl::process_tracker_response(tracker::Message const& m)
          #ifdef EYELIB_DEBUG
           std::cout << "eyelib: calibresult:" <<'\n'<< cal <<'\n';
          #endif
+          calib_     = cal;
+          calib_raw_ = m.values.at(Msg::Value::calibration_result);
           lock.unlock();
           call_calib_handler(cal);    // Invoke calibration result callback
           lock.lock();
         }
       }
       //--------------------------------------
+      // Heartbeat interval
+      if (m.has_value(Msg::Value::heartbeat_interval))
+      {
+        heartbeat_.start(
+          m.values.at(Msg::Value::heartbeat_interval).get<unsigned>());
+      }
+      //--------------------------------------
       // Screen parameters
       //if (try_update(m, screen))
       if (m.values.count(Msg::Value::screen_index))
@@ -335,13 +471,14 @@ Tracker::Impl::process_tracker_response(tracker::Message const& m)
         // Request state values.
         tcp_.write(msg::GET_TRACKER_STATE);
         tcp_.write(msg::GET_CALIBRATION);
+        tcp_.write(msg::GET_HEARTBEAT_INTERVAL);
 
         // Request set screen parameters.
-        auto set_screen = msg::set(screen_);
+        auto set_screen = msg::serialized::set(screen_);
        #ifdef EYELIB_DEBUG
-        std::cout << "eyelib: set screen:" <<'\n'<< set_screen.dump(2) <<'\n';
+        std::cout << "eyelib: set screen:" <<'\n'<< set_screen <<'\n';
        #endif
-        tcp_.write(set_screen.dump());
+        tcp_.write(std::move(set_screen));
       }
       break;
     }
@@ -423,6 +560,46 @@ Tracker::state() const
   return pimpl->state_;                             // Return tracker state
 }
 
+bool
+Tracker::calibration_stored() const
+{
+  std::lock_guard<std::mutex> lock(pimpl->mutex_);  // Acquire lock on mutex
+  auto const& stored = pimpl->stored_;
+  // The server still holds the participant's successful calibration
+  return stored.calibration.success && !stored.raw.is_null()
+      && (stored.raw == pimpl->calib_raw_)
+      && (stored.calibration.error_rating.binocular
+          > Calibration::Rating::recalibrate);
+}
+
+StoreTiming
+Tracker::store_timing() const
+{
+  std::lock_guard<std::mutex> lock(pimpl->mutex_);  // Acquire lock on mutex
+  return pimpl->store_.timing();
+}
+
+Calibration
+Tracker::calibration() const
+{
+  std::lock_guard<std::mutex> lock(pimpl->mutex_);  // Acquire lock on mutex
+  return pimpl->calib_;
+}
+
+CalibrationTiming
+Tracker::calibration_timing() const
+{
+  std::lock_guard<std::mutex> lock(pimpl->mutex_);  // Acquire lock on mutex
+  return pimpl->calibrator_.timing();
+}
+
+Tracker::Mode
+Tracker::mode() const
+{
+  std::lock_guard<std::mutex> lock(pimpl->mutex_);  // Acquire lock on mutex
+  return pimpl->mode_;
+}
+
 bool
 Tracker::target(Target& t) const
 {
@@ -439,23 +616,19 @@ Tracker::start(unsigned wait_ms)
 
   if(pimpl->state_.is_started) { return; } // Return if already running
 
+  // Started before connecting, so that the connection handler requests a
+  // connection with the tracker server once the socket is open.
+  pimpl->state_.is_started = true;
+
   // Run pimpl->tcp_ in its own thread so it operates
   // asynchronously with respect to the rest of the program.
   pimpl->tcp_thread_ = std::thread([this](){ pimpl->tcp_.run(); });
+  lock.unlock();
 
   // Wait a little bit for connection.
   std::this_thread::sleep_for(std::chrono::milliseconds(wait_ms));
 
-  // Request connection with tracker server.
-  pimpl->tcp_.write(msg::REQUEST_CONNECT);
-
-  pimpl->state_.is_started = true;
- #ifdef EYELIB_HEARTBEAT
-  //pimpl->start_heartbeat(heartbeat_ms);
-  pimpl->start_heartbeat(200);
- #endif
-  lock.unlock();
-  pimpl->call_state_handler(pimpl->state_);   // Invoke tracker state callback
+  pimpl->call_state_handler(state());   // Invoke tracker state callback
 }
 
 void
@@ -467,6 +640,54 @@ Tracker::calibrate(Targets const& points, TargetDuration const& target_ms,
   pimpl->calibrator_.setup(win, points, target_ms);
   lock.unlock();
   win.run();      // Blocks until window is closed
+ #ifdef EYELIB_DEBUG
+  std::cout << "eyelib: frame stats: " << win.frame_stats() <<'\n';
+ #endif
+}
+
+bool
+Tracker::recalibrate(TargetDuration const& target_ms,
+                     ColorRGB const& background)
+{
+  auto points = recalibration_targets(calibration());
+  if (points.empty())
+  {
+    return false;   // No point needs recalibration
+  }
+  calibrate(points, target_ms, background);
+  return true;
+}
+
+bool
+Tracker::participant(std::string const& id, std::string const& dir)
+{
+  std::lock_guard<std::mutex> lock(pimpl->mutex_);  // Acquire lock on mutex
+  pimpl->participant_ = id;
+  pimpl->store_       = tracker::CalibrationStore(dir);
+  pimpl->stored_      = tracker::CalibrationStore::Entry();
+  return !id.empty()
+      && pimpl->store_.load(id, pimpl->screen_, pimpl->stored_);
+}
+
+void
+Tracker::adaptive_calibration(AdaptiveDuration const& d)
+{
+  std::lock_guard<std::mutex> lock(pimpl->mutex_);  // Acquire lock on mutex
+  pimpl->calibrator_.adaptive(d);
+}
+
+Validation::Results
+Tracker::validate(Targets const& points, TargetDuration const& target_ms,
+                  ColorRGB const& background)
+{
+  std::unique_lock<std::mutex> lock(pimpl->mutex_);
+  Window win(*this, pimpl->screen_, "Eye Tracker Validation", background);
+  pimpl->validator_.setup(win, points, target_ms);
+  lock.unlock();
+  win.run();      // Blocks until window is closed
+  lock.lock();
+  pimpl->validator_.stop();
+  return pimpl->validator_.results();
 }
 
 void
@@ -478,6 +699,9 @@ Tracker::window(ColorRGB const& background)
   win.show_raw_gaze(true);
   lock.unlock();
   win.run();      // Blocks until window is closed
+ #ifdef EYELIB_DEBUG
+  std::cout << "eyelib: frame stats: " << win.frame_stats() <<'\n';
+ #endif
 }
 
 void
@@ -495,6 +719,47 @@ Tracker::window(Targets const& points, TargetDuration const& target_ms,
   pimpl->gaze_target_.set_targets(points, target_ms);
   lock.unlock();
   win.run();      // Blocks until window is closed
+ #ifdef EYELIB_DEBUG
+  std::cout << "eyelib: frame stats: " << win.frame_stats() <<'\n';
+ #endif
+}
+
+void
+Tracker::session(ColorRGB const& background)
+{
+  std::unique_lock<std::mutex> lock(pimpl->mutex_);
+  if (pimpl->session_) { return; }    // Only one session window
+  Window win(*this, pimpl->screen_, "Eye Tracker Session", background);
+  pimpl->session_ = &win;
+  pimpl->set_mode(win, Mode::free_view, {}, {});
+  lock.unlock();
+  win.run();      // Blocks until window is closed
+  lock.lock();
+  pimpl->calibrator_.stop();
+  pimpl->validator_.stop();
+  pimpl->gaze_target_.set_targets({});
+  pimpl->session_ = nullptr;
+  lock.unlock();
+ #ifdef EYELIB_DEBUG
+  std::cout << "eyelib: frame stats: " << win.frame_stats() <<'\n';
+ #endif
+}
+
+bool
+Tracker::set_mode(Mode m, Targets const& points,
+                  TargetDuration const& target_ms)
+{
+  std::lock_guard<std::mutex> lock(pimpl->mutex_);
+  if (!pimpl->session_)
+  {
+    return false;
+  }
+  if (m != Mode::free_view && points.empty())
+  {
+    return false;   // Nothing to show; keep the current mode
+  }
+  pimpl->set_mode(*pimpl->session_, m, points, target_ms);
+  return true;
 }
 
 
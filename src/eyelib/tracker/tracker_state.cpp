@@ -76,6 +76,31 @@ operator<<(std::ostream& os, Tracker::Device const& val)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////
+// Session Mode
+/////////////////////////////////////////////////////////////////////////////
+
+std::string
+to_string(Tracker::Mode const& val)
+{
+  using M = Tracker::Mode;
+  switch (val)
+  {
+    case M::targets:     return "Targets";
+    case M::calibration: return "Calibration";
+    case M::validation:  return "Validation";
+    case M::free_view:
+    default:             return "Free View";
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, Tracker::Mode const& val)
+{
+  return os << eye::to_string(val);
+}
+
+
 /////////////////////////////////////////////////////////////////////////////
 // Tracker State
 /////////////////////////////////////////////////////////////////////////////
@@ -84,9 +109,11 @@ bool
 operator==(Tracker::State const& lhs, Tracker::State const& rhs)
 {
   return std::tie(lhs.device_state, lhs.frame_rate, lhs.is_calibrated,
-                  lhs.is_calibrating, lhs.is_connected, lhs.is_started)
+                  lhs.is_calibrating, lhs.is_connected, lhs.is_started,
+                  lhs.connection_error)
       == std::tie(rhs.device_state, rhs.frame_rate, rhs.is_calibrated,
-                  rhs.is_calibrating, rhs.is_connected, rhs.is_started);
+                  rhs.is_calibrating, rhs.is_connected, rhs.is_started,
+                  rhs.connection_error);
 }
 
 bool
@@ -103,7 +130,9 @@ operator<<(std::ostream& os, Tracker::State const& s)
     << '\n' << "is_calibrated  : " << (s.is_calibrated  ? "true" : "false")
     << '\n' << "is_calibrating : " << (s.is_calibrating ? "true" : "false")
     << '\n' << "is_connected   : " << (s.is_connected   ? "true" : "false")
-    << '\n' << "is_started     : " << (s.is_started     ? "true" : "false");
+    << '\n' << "is_started     : " << (s.is_started     ? "true" : "false")
+    << '\n' << "connection     : " << (s.connection_error.empty()
+                                       ? "ok" : s.connection_error);
 }
 
 
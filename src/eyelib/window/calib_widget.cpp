@@ -28,6 +28,8 @@ SOFTWARE.
 #include <utl/color.hpp>            // utl::color_rgb
 #include <utl/fltk/fltk_draw.hpp>   // utl::fltk::draw_sector
 
+#include <string>   // std::string, std::to_string
+
 namespace {   //-------------------------------------------------------------
 
 static constexpr utl::color_rgb gray   { 127, 127, 127 };  ///< Uncalibrated
@@ -39,6 +41,15 @@ static constexpr utl::color_rgb green  {   0, 160,   0 };  ///< Great
 
 static constexpr int  radius_px { 19 };       ///< Radius in pixels.
 
+// Sprite key for a set of ratings
+std::string
+rating_key(eye::Calibration::Eyes<eye::Calibration::Rating> const& r)
+{
+  return "calib:" + std::to_string(static_cast<unsigned>(r.binocular))
+             + ',' + std::to_string(static_cast<unsigned>(r.left_eye))
+             + ',' + std::to_string(static_cast<unsigned>(r.right_eye));
+}
+
 utl::color_rgb
 rating_color(eye::Calibration::Rating const& r)
 {
@@ -65,12 +76,18 @@ CalibPointWidget::CalibPointWidget(
 , color_right(left)
 {}
 
+CalibPointWidget::CalibPointWidget(
+    int x_px, int y_px, Calibration::Eyes<Calibration::Rating> const& rating)
+: x_(x_px)
+, y_(y_px)
+, color_top( rating_color(rating.binocular) )
+, color_left( rating_color(rating.left_eye) )
+, color_right( rating_color(rating.right_eye) )
+, sprite_( rating_key(rating) )
+{}
+
 CalibPointWidget::CalibPointWidget(Calibration::Point const& p)
-: x_(p.calibrate_px.x)
-, y_(p.calibrate_px.y)
-, color_top( rating_color(p.accuracy_rating.binocular) )
-, color_left( rating_color(p.accuracy_rating.left_eye) )
-, color_right( rating_color(p.accuracy_rating.right_eye) )
+: CalibPointWidget(p.calibrate_px.x, p.calibrate_px.y, p.accuracy_rating)
 {}
 
 void
@@ -83,6 +100,37 @@ CalibPointWidget::draw() const
   c::draw_sector<radius_px, 270, 390>(x_, y_,color_left);
 }
 
+void
+CalibPointWidget::draw(SpriteCache& cache) const
+{
+  if (sprite_.empty())
+  {
+    draw();     // Appearance not identified by a key
+    return;
+  }
+  cache.draw(sprite_, bounds(), [this](int dx, int dy)
+    {
+      CalibPointWidget w(*this);
+      w.x_ += dx;
+      w.y_ += dy;
+      w.draw();
+    });
+}
+
+void
+CalibPointWidget::draw(RasterCanvas& canvas) const
+{
+  canvas.sector(x_, y_, radius_px,  30, 150, color_top);
+  canvas.sector(x_, y_, radius_px, 150, 270, color_right);
+  canvas.sector(x_, y_, radius_px, 270, 390, color_left);
+}
+
+Rect
+CalibPointWidget::bounds() const
+{
+  return circle_bounds(x_, y_, radius_px + 1);
+}
+
 //---------------------------------------------------------------------------
 
 void
@@ -109,6 +157,48 @@ CalibWidget::draw() const
   }
 }
 
+void
+CalibWidget::draw(SpriteCache& cache) const
+{
+  using S = CalibWidget::Show;
+  switch (show_)
+  {
+    case S::average:
+      average_.draw(cache);
+      break;
+    case S::points:
+      for (auto const& p : points_)
+      {
+        p.draw(cache);  // draw calibration point results
+      }
+      break;
+    case S::none:
+    default:
+      break;
+  }
+}
+
+void
+CalibWidget::draw(RasterCanvas& canvas) const
+{
+  using S = CalibWidget::Show;
+  switch (show_)
+  {
+    case S::average:
+      average_.draw(canvas);
+      break;
+    case S::points:
+      for (auto const& p : points_)
+      {
+        p.draw(canvas);
+      }
+      break;
+    case S::none:
+    default:
+      break;
+  }
+}
+
 void
 CalibWidget::set(Calibration const& c)
 {
@@ -120,13 +210,8 @@ CalibWidget::set(Calibration const& c)
   unsigned cy = 0;
   eye::centroid(cx, cy, c.points);
 
-  // Get colors that correspond to the average error ratings
-  auto color_top   = rating_color(c.error_rating.binocular);
-  auto color_left  = rating_color(c.error_rating.left_eye);
-  auto color_right = rating_color(c.error_rating.right_eye);
-
-  // Construct from values
-  average_ = window::CalibPointWidget(cx, cy, color_top, color_left, color_right);
+  // Construct with colors that correspond to the average error ratings
+  average_ = window::CalibPointWidget(cx, cy, c.error_rating);
 }
 
 CalibWidget::Show
@@ -141,6 +226,29 @@ CalibWidget::show(Show const& s)
   show_ = s;
 }
 
+Rect
+CalibWidget::bounds() const
+{
+  using S = CalibWidget::Show;
+  Rect r{};
+  switch (show_)
+  {
+    case S::average:
+      r = average_.bounds();
+      break;
+    case S::points:
+      for (auto const& p : points_)
+      {
+        r = unite(r, p.bounds());
+      }
+      break;
+    case S::none:
+    default:
+      break;
+  }
+  return r;
+}
+
 //---------------------------------------------------------------------------
 } } // eye::window
 //===========================================================================//
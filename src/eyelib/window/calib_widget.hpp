@@ -31,8 +31,13 @@ SOFTWARE.
 
 #include <eyelib/calibration.hpp>
 
+#include "window/raster_canvas.hpp" // eye::window::RasterCanvas
+#include "window/rect.hpp"          // eye::window::Rect
+#include "window/sprite_cache.hpp"  // eye::window::SpriteCache
+
 #include <utl/color.hpp>  // utl::color_rgb
 
+#include <string>   // std::string
 #include <vector>   // std::vector
 
 namespace eye { namespace window {
@@ -55,18 +60,32 @@ public:
               utl::color_rgb const& left,
               utl::color_rgb const& right);
 
+  /// Construct with sector colors for @a rating.
+  CalibPointWidget(int x_px, int y_px,
+                   Calibration::Eyes<Calibration::Rating> const& rating);
+
   CalibPointWidget(Calibration::Point const& p);   ///< Construct from Point.
   CalibPointWidget() = default;                    ///< Default constructor.
 
   /// Draw widget.
   void draw() const;
 
+  /// Draw widget using pre-rendered image from @a cache.
+  void draw(SpriteCache& cache) const;
+
+  /// Draw widget into software canvas.
+  void draw(RasterCanvas& canvas) const;
+
+  /// Bounding box of drawn widget.
+  Rect bounds() const;
+
 private:
   int  x_{0};
   int  y_{0};
   utl::color_rgb  color_top   {127,127,127};    ///< Upper sector.
   utl::color_rgb  color_left  {127,127,127};    ///< Lower-left.
   utl::color_rgb  color_right {127,127,127};    ///< Lower-right.
+  std::string     sprite_{};    // Sprite key; empty if colors not rated
 };
 
 /// Target container.
@@ -86,9 +105,12 @@ public:
   };
 
   void draw() const;                ///< Draw calibration point widget(s).
+  void draw(SpriteCache& c) const;  ///< Draw using pre-rendered images.
+  void draw(RasterCanvas& c) const; ///< Draw into software canvas.
   void set(Calibration const& c);   ///< Set calibration error values.
   Show show() const;                ///< Get results to be drawn.
   void show(Show const& s);         ///< Set results to be drawn.
+  Rect bounds() const;              ///< Bounds of results to be drawn.
 
 private:
   CalibPointWidget   average_{};
@@ -0,0 +1,108 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Gaze-contingent drawing.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_WINDOW_CONTINGENT_HPP
+#define EYELIB_WINDOW_CONTINGENT_HPP
+
+#include <eyelib/gaze.hpp>  // eye::Gaze
+
+#include "window/rect.hpp"  // eye::window::Rect
+
+#include <functional> // std::function
+#include <ostream>    // std::ostream
+
+namespace eye { namespace window {
+
+/// @ingroup    window
+/// @{
+
+//---------------------------------------------------------------------------
+
+/**
+  @brief  Client drawing that follows the gaze.
+
+  For each new gaze sample, `region` returns the window region that
+  depends on it, such as a moving window centered on the gaze point, or
+  the area behind a boundary once the gaze has crossed it.  The previous
+  and current regions are repainted with the scene, then `draw` is
+  called with the same sample, clipped to the current region.  `draw`
+  uses FLTK drawing calls and runs on the UI thread.
+*/
+struct Contingent
+{
+  /// Region depending on gaze sample.  Empty if nothing to draw.
+  using region_handler = std::function<Rect(Gaze const& g)>;
+
+  /// Draw for gaze sample within region @a r.
+  using draw_handler = std::function<void(Gaze const& g, Rect const& r)>;
+
+  region_handler  region{};   ///< Region callback.
+  draw_handler    draw{};     ///< Draw callback.
+};
+
+/// Region of @a w by @a h pixels centered on the smoothed gaze point.
+inline Contingent::region_handler
+centered_region(int w, int h)
+{
+  return [w, h](Gaze const& g)
+    {
+      return Rect{ static_cast<int>(g.avg_px.x) - w/2,
+                   static_cast<int>(g.avg_px.y) - h/2, w, h };
+    };
+}
+
+//---------------------------------------------------------------------------
+
+/// Timing of one gaze-contingent frame.
+struct ContingentFrame
+{
+  unsigned  frame{0};         ///< Contingent frames drawn, including this.
+  unsigned  gaze_time_ms{0};  ///< Tracker timestamp of the sample drawn.
+  double    latency_ms{0.0};  ///< Sample received to frame copied to screen.
+  double    draw_ms{0.0};     ///< Time to draw and copy to screen.
+  Rect      region{};         ///< Region drawn.
+};
+
+/// Insert into output stream.
+inline std::ostream&
+operator<<(std::ostream& os, ContingentFrame const& f)
+{
+  return os << "frame " << f.frame
+            << ", gaze " << f.gaze_time_ms << " ms"
+            << ", latency " << f.latency_ms << " ms"
+            << ", draw " << f.draw_ms << " ms";
+}
+
+//---------------------------------------------------------------------------
+
+/// @}
+
+} } // eye::window
+
+#endif // EYELIB_WINDOW_CONTINGENT_HPP
+//===========================================================================//
@@ -0,0 +1,108 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include "window/frame_scheduler.hpp"
+
+#include <FL/Fl.H>    // Fl::add_timeout, Fl::repeat_timeout
+
+namespace eye { namespace window {
+
+//---------------------------------------------------------------------------
+
+FrameScheduler::FrameScheduler(double refresh_hz, render_handler callback)
+: period_s_(1.0 / refresh_hz)
+, call_render_handler(callback)
+{}
+
+FrameScheduler::~FrameScheduler()
+{
+  stop();
+}
+
+//---------------------------------------------------------------------------
+
+void
+FrameScheduler::start()
+{
+  if (running_) { return; }
+  running_    = true;
+  start_time_ = clock::now();
+  Fl::add_timeout(period_s_, tick, this);
+}
+
+void
+FrameScheduler::stop()
+{
+  if (!running_) { return; }
+  running_ = false;
+  Fl::remove_timeout(tick, this);
+}
+
+void
+FrameScheduler::request()
+{
+  ++requested_;
+  pending_.store(true, std::memory_order_release);
+}
+
+FrameStats
+FrameScheduler::stats() const
+{
+  FrameStats s{};
+  s.requested = requested_;
+  s.rendered  = rendered_;
+  s.wakeups   = wakeups_;
+  s.skipped   = (s.requested > s.rendered) ? (s.requested - s.rendered) : 0;
+  if (running_)
+  {
+    s.seconds = std::chrono::duration<double>(clock::now()
+                                              - start_time_).count();
+  }
+  return s;
+}
+
+//---------------------------------------------------------------------------
+// private
+
+/*static*/ void
+FrameScheduler::tick(void* userdata)
+{
+  FrameScheduler* fs = static_cast<FrameScheduler*>(userdata);
+  ++fs->wakeups_;
+
+  // Render only the latest state; requests since the last frame collapse
+  if (fs->pending_.exchange(false, std::memory_order_acquire))
+  {
+    ++fs->rendered_;
+    fs->call_render_handler();
+  }
+  // Fixed cadence, compensating for callback latency
+  Fl::repeat_timeout(fs->period_s_, tick, userdata);
+}
+
+//---------------------------------------------------------------------------
+
+} } // eye::window
+//===========================================================================//
@@ -0,0 +1,127 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Window frame scheduler.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_WINDOW_FRAME_SCHEDULER_HPP
+#define EYELIB_WINDOW_FRAME_SCHEDULER_HPP
+
+#include <atomic>     // std::atomic
+#include <chrono>     // std::chrono::steady_clock
+#include <functional> // std::function
+#include <ostream>    // std::ostream
+
+namespace eye { namespace window {
+
+/// @ingroup    window
+/// @{
+
+//---------------------------------------------------------------------------
+
+/// Frame scheduler statistics.
+struct FrameStats
+{
+  unsigned  requested{0};   ///< Frames requested.
+  unsigned  rendered{0};    ///< Frames rendered.
+  unsigned  skipped{0};     ///< Requests superseded before being rendered.
+  unsigned  wakeups{0};     ///< Scheduler timer callbacks on the UI thread.
+  double    seconds{0.0};   ///< Time elapsed since scheduler started.
+
+  /// UI thread wakeups per second.
+  double wakeups_per_s() const
+  {
+    return (seconds > 0.0) ? (wakeups / seconds) : 0.0;
+  }
+};
+
+/// Insert into output stream.
+inline std::ostream&
+operator<<(std::ostream& os, FrameStats const& s)
+{
+  return os << "requested " << s.requested
+            << ", rendered " << s.rendered
+            << ", skipped "  << s.skipped
+            << ", wakeups/s " << s.wakeups_per_s();
+}
+
+//---------------------------------------------------------------------------
+
+/**
+  @brief  Paces window redraws to the display refresh rate.
+
+  Producers on any thread call `request()` after updating window state.
+  The request only sets a flag; the UI thread is not woken.  A repeating
+  FLTK timeout on the UI thread checks the flag once per refresh period
+  and, if set, invokes the render callback (typically `redraw()`).  Any
+  number of requests between timeouts collapse into a single frame, so
+  the UI thread is woken at most once per display refresh regardless of
+  the tracker sample rate.
+
+  `start()` and `stop()` must be called from the UI thread.
+*/
+class FrameScheduler
+{
+public:
+
+  /// Render callback alias.
+  using render_handler = std::function<void()>;
+
+  /// Construct scheduler for a display refreshing at @a refresh_hz.
+  FrameScheduler(double refresh_hz, render_handler callback);
+
+  ~FrameScheduler();                                      ///< Destructor.
+  FrameScheduler(FrameScheduler const&)            = delete;  ///< No copy.
+  FrameScheduler& operator=(FrameScheduler const&) = delete;  ///< No assign.
+
+  void start();             ///< Start refresh timeout.  UI thread only.
+  void stop();              ///< Stop refresh timeout.  UI thread only.
+  void request();           ///< Request a frame.  Any thread.
+  FrameStats stats() const; ///< Current statistics.
+
+private:
+  using clock = std::chrono::steady_clock;
+
+  static void tick(void* userdata);   // FLTK timeout callback
+
+  double                  period_s_;
+  render_handler          call_render_handler;
+  clock::time_point       start_time_{};
+  bool                    running_{false};
+
+  std::atomic<bool>       pending_{false};    // Frame requested
+  std::atomic<unsigned>   requested_{0};
+  std::atomic<unsigned>   rendered_{0};
+  std::atomic<unsigned>   wakeups_{0};
+};
+
+//---------------------------------------------------------------------------
+
+/// @}
+
+} } // eye::window
+
+#endif // EYELIB_WINDOW_FRAME_SCHEDULER_HPP
+//===========================================================================//
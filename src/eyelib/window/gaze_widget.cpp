@@ -70,6 +70,35 @@ GazeWidget::draw() const
   }
 }
 
+void
+GazeWidget::draw(RasterCanvas& canvas) const
+{
+  if (show_raw)
+  {
+    canvas.circle(raw_x, raw_y, raw_rad, raw_line, raw_color);
+  }
+  if (show_avg)
+  {
+    canvas.circle(avg_x, avg_y, avg_rad, avg_line,
+                  (fixation ? avg_color_fix : avg_color_def));
+  }
+}
+
+Rect
+GazeWidget::raw_bounds() const
+{
+  // Outer edge of circle, plus one pixel for line rounding
+  return show_raw ? circle_bounds(raw_x, raw_y, raw_rad + raw_line + 1)
+                  : Rect{};
+}
+
+Rect
+GazeWidget::avg_bounds() const
+{
+  return show_avg ? circle_bounds(avg_x, avg_y, avg_rad + avg_line + 1)
+                  : Rect{};
+}
+
 void
 GazeWidget::set(eye::Gaze const& g)
 {
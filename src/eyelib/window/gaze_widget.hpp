@@ -31,6 +31,9 @@ SOFTWARE.
 
 #include <eyelib/gaze.hpp>  // eye::Gaze
 
+#include "window/raster_canvas.hpp"  // eye::window::RasterCanvas
+#include "window/rect.hpp"           // eye::window::Rect
+
 namespace eye { namespace window {
 
 /// @ingroup    window
@@ -53,7 +56,11 @@ struct GazeWidget
   GazeWidget() = default;           ///< Construct with default values.
 
   void draw() const;              ///< Draw gaze raw point and/or smoothed.
+  void draw(RasterCanvas& c) const;   ///< Draw into software canvas.
   void set(eye::Gaze const& g);   ///< Set gaze data.
+
+  Rect raw_bounds() const;  ///< Raw gaze point bounds; empty if not shown.
+  Rect avg_bounds() const;  ///< Smoothed gaze point bounds; empty if hidden.
 };
 
 /// @}
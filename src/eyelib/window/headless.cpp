@@ -0,0 +1,154 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include "window/headless.hpp"
+
+#include <FL/Enumerations.H>  // fl_rgb_color
+
+namespace eye { namespace window {
+
+//---------------------------------------------------------------------------
+
+Headless::Headless(Screen const& scr, std::string const& title,
+                   ColorRGB const& bg)
+: canvas_(static_cast<int>(scr.w_px), static_cast<int>(scr.h_px))
+{
+  scene_.background = fl_rgb_color(bg.r, bg.g, bg.b);
+  scene_.text = TextWidget(scr.w_px/2, scr.h_px/3, title,
+                           RasterCanvas::text_width);
+}
+
+//---------------------------------------------------------------------------
+
+void
+Headless::handle(Input in)
+{
+  machine_.handle(in);
+}
+
+void
+Headless::handle(Gaze const& g)
+{
+  scene_.gaze.set(g);
+}
+
+void
+Headless::handle(Calibration const& c)
+{
+  machine_.apply(c);
+  full_redraw_ = true;
+}
+
+void
+Headless::reset(std::string const& title)
+{
+  scene_.text = TextWidget(canvas_.width()/2, canvas_.height()/3, title,
+                           RasterCanvas::text_width);
+  scene_.targets.clear();
+  machine_.handle(Input::reset);
+  full_redraw_ = true;
+}
+
+void
+Headless::clear_targets()
+{
+  scene_.targets.clear();
+  full_redraw_ = true;
+}
+
+void
+Headless::set(Targets const& ts)
+{
+  scene_.targets.set(ts);
+  full_redraw_ = true;
+}
+
+void
+Headless::set_active(std::size_t index, bool active)
+{
+  scene_.targets.active(index, active);   // Damages target only
+}
+
+void
+Headless::register_handler(Window::state_handler callback)
+{
+  machine_.register_handler(callback);
+}
+
+Window::State
+Headless::state() const
+{
+  return machine_.state();
+}
+
+//---------------------------------------------------------------------------
+
+std::size_t
+Headless::render()
+{
+  Rect const all{ 0, 0, canvas_.width(), canvas_.height() };
+
+  damaged_.clear();
+  scene_.damage(damaged_);    // Previous and current bounds of changes
+  if (full_redraw_)
+  {
+    full_redraw_ = false;
+    scene_.draw(all, canvas_);
+    return static_cast<std::size_t>(all.w) * all.h;
+  }
+
+  std::size_t pixels = 0;
+  for (auto const& r : damaged_)
+  {
+    Rect const d = intersect(all, r);
+    if (d.empty()) { continue; }
+    scene_.draw(d, canvas_);
+    pixels += static_cast<std::size_t>(d.w) * d.h;
+  }
+  return pixels;
+}
+
+void
+Headless::redraw()
+{
+  full_redraw_ = true;
+}
+
+RasterCanvas const&
+Headless::canvas() const
+{
+  return canvas_;
+}
+
+Scene&
+Headless::scene()
+{
+  return scene_;
+}
+
+//---------------------------------------------------------------------------
+
+} } // eye::window
+//===========================================================================//
@@ -0,0 +1,124 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Headless window.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_WINDOW_HEADLESS_HPP
+#define EYELIB_WINDOW_HEADLESS_HPP
+
+#include <eyelib.hpp>
+
+#include "window/raster_canvas.hpp" // eye::window::RasterCanvas
+#include "window/rect.hpp"          // eye::window::Rect
+#include "window/scene.hpp"         // eye::window::Scene
+#include "window/state_machine.hpp" // eye::window::StateMachine
+#include "window/window.hpp"        // eye::Window::State
+
+#include <cstddef>    // std::size_t
+#include <string>     // std::string
+#include <vector>     // std::vector
+
+namespace eye { namespace window {
+
+/// @ingroup    window
+/// @{
+
+//---------------------------------------------------------------------------
+
+/**
+  @brief  Window that draws into memory, for machines without a display.
+
+  Holds the same scene and state machine as `Window`, but draws into a
+  `RasterCanvas` sized by the `Screen` passed in, rather than querying the
+  display.  There is no event loop or tracker: the caller passes gaze,
+  calibration and input, then calls `render()` once per frame to draw the
+  regions that changed.
+
+  Example:
+  ```
+  eye::Screen scr(0, 0, 0, 1920, 1080, 0.53f, 0.30f);  // From configuration
+  eye::window::Headless win(scr, "Eye Tracker Window");
+  win.handle(Input::start);   // init --> ready
+  win.handle(Input::enter);   // ready --> active
+  win.handle(gaze);
+  win.render();               // Draws previous and current gaze bounds
+  ```
+*/
+class Headless
+{
+public:
+  using Input = StateMachine::Input;    ///< Window input alias.
+
+  /// @brief  Construct window.
+  /// @param  [in]  scr     Screen parameters; only the size is used.
+  /// @param  [in]  title   Window title.
+  /// @param  [in]  bg      Background color.
+  Headless(Screen const& scr, std::string const& title,
+           ColorRGB const& bg = {149,149,149});
+
+  Headless(Headless const&)            = delete;  ///< Prohibit copying.
+  Headless& operator=(Headless const&) = delete;  ///< Prohibit assignment.
+
+  void handle(Input in);                ///< Apply scripted input.
+  void handle(Gaze const& g);           ///< Set latest gaze data.
+  void handle(Calibration const& c);    ///< Show calibration results.
+
+  void reset(std::string const& title); ///< Replace content, as `Window`.
+  void clear_targets();                 ///< Remove all targets.
+  void set(Targets const& ts);          ///< %Targets to draw.
+  void set_active(std::size_t index, bool active);  ///< Activate target.
+
+  /// Register state change notification handler.
+  void register_handler(Window::state_handler callback);
+
+  Window::State state() const;          ///< Current state.
+
+  /// @brief  Draw the regions changed since the last render.
+  /// @return Number of pixels drawn.
+  std::size_t render();
+
+  /// Draw everything at the next `render()`.
+  void redraw();
+
+  RasterCanvas const& canvas() const;   ///< Pixels drawn.
+  Scene&              scene();          ///< Widgets to draw.
+
+private:
+  RasterCanvas        canvas_;
+  Scene               scene_{};
+  StateMachine        machine_{scene_};
+  std::vector<Rect>   damaged_{};
+  bool                full_redraw_{true};
+};
+
+//---------------------------------------------------------------------------
+
+/// @}
+
+} } // eye::window
+
+#endif // EYELIB_WINDOW_HEADLESS_HPP
+//===========================================================================//
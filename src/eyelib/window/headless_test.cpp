@@ -0,0 +1,272 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib.hpp>
+
+#include "window/headless.hpp"  // eye::window::Headless
+#include "debug/benchmark.hpp"    // eye::debug::per_frame
+
+#include <cmath>      // std::cos, std::sin
+#include <iomanip>    // std::setw
+#include <iostream>   // std::cout
+#include <vector>     // std::vector
+
+namespace {   //-------------------------------------------------------------
+
+using eye::debug::frame_count;
+using eye::debug::per_frame;
+using Input = eye::window::Headless::Input;
+
+enum class SceneType { gaze, targets, calibration };
+
+struct Result
+{
+  double    full_ms{0.0};       // Mean full redraw time per frame
+  double    damage_ms{0.0};     // Mean damage-region redraw time per frame
+  double    damage_px{0.0};     // Mean damaged pixels per frame
+};
+
+char const*
+to_string(SceneType s)
+{
+  switch (s)
+  {
+    case SceneType::gaze:         return "gaze";
+    case SceneType::targets:      return "targets";
+    case SceneType::calibration:  return "calibration";
+    default:                      return "error";
+  }
+}
+
+// Gaze moving along a circle about the screen center
+eye::Gaze
+gaze_at(int w, int h, unsigned i)
+{
+  double a = 0.05 * i;
+  eye::Gaze g{};
+  g.avg_px = { static_cast<float>(w/2 + (h/4) * std::cos(a)),
+               static_cast<float>(h/2 + (h/4) * std::sin(a)) };
+  g.raw_px = { g.avg_px.x + static_cast<float>(12 * std::sin(3 * a)),
+               g.avg_px.y + static_cast<float>(12 * std::cos(5 * a)) };
+  g.fixation = (i % 60) < 30;
+  g.tracking.gaze = true;
+  return g;
+}
+
+// Nine calibration points, rated from recalibrate to great
+eye::Calibration
+calibration(int w, int h)
+{
+  using R = eye::Calibration::Rating;
+  eye::Calibration c{};
+  c.success = true;
+  c.error_rating = { R::good, R::moderate, R::great };
+  for (unsigned i = 0; i != 9; ++i)
+  {
+    eye::Calibration::Point p{};
+    p.calibrate_px = { (1 + i % 3) * w / 4u, (1 + i / 3) * h / 4u };
+    auto r = static_cast<R>(1 + i % 5);
+    p.accuracy_rating = { r, r, r };
+    c.points.push_back(p);
+  }
+  return c;
+}
+
+// Script the window into scene s
+void
+script(eye::window::Headless& win, SceneType s, int w, int h)
+{
+  win.handle(Input::start);
+  win.handle(Input::toggle_raw);
+  win.handle(Input::toggle_avg);
+  switch (s)
+  {
+    case SceneType::gaze:
+      break;    // Title screen
+    case SceneType::targets:
+    {
+      eye::Targets targets;
+      for (int i = 0; i != 9; ++i)
+      {
+        targets.push_back({ (1 + i % 3) * w / 4, (1 + i / 3) * h / 4,
+                            (i == 0) });
+      }
+      win.set(targets);
+      win.handle(Input::enter);
+      break;
+    }
+    case SceneType::calibration:
+      win.handle(calibration(w, h));
+      win.handle(Input::cycle_calib);   // Show all points
+      break;
+  }
+  win.render();
+}
+
+// Change scene s for frame i
+void
+step(eye::window::Headless& win, SceneType s, int w, int h, unsigned i)
+{
+  win.handle(gaze_at(w, h, i));
+  if ((s == SceneType::targets) && (i % 30 == 0))
+  {
+    win.set_active((i / 30) % 9, false);
+    win.set_active((i / 30 + 1) % 9, true);
+  }
+}
+
+Result
+benchmark(SceneType s, int w, int h)
+{
+  eye::Screen scr(0, 0, 0, w, h, 0.0f, 0.0f);
+  eye::window::Headless win(scr, "Headless Benchmark");
+  script(win, s, w, h);
+
+  Result result{};
+
+  // Full redraw of every frame
+  result.full_ms = per_frame(frame_count, [&](unsigned i)
+    {
+      step(win, s, w, h, i);
+      win.redraw();
+      win.render();
+    });
+
+  // Redraw of damaged regions only
+  double pixels = 0.0;
+  result.damage_ms = per_frame(frame_count, [&](unsigned i)
+    {
+      step(win, s, w, h, i);
+      pixels += static_cast<double>(win.render());
+    });
+  result.damage_px = pixels / frame_count;
+  return result;
+}
+
+// Drive the state machine through a session; return true if as expected
+bool
+state_test()
+{
+  using State = eye::Window::State;
+
+  eye::Screen scr(0, 0, 0, 640, 480, 0.0f, 0.0f);
+  eye::window::Headless win(scr, "Headless State");
+  std::vector<State> states;
+  win.register_handler([&states](State const& s){ states.push_back(s); });
+
+  win.handle(Input::escape);    // Ignored before start
+  win.handle(Input::start);     // init --> ready
+  win.handle(Input::escape);    // Ignored on title screen
+  win.handle(Input::enter);     // ready --> active
+  win.handle(Input::enter);     // Ignored on main screen
+  win.handle(Input::escape);    // active --> ready
+  win.handle(Input::enter);     // ready --> active
+  win.handle(calibration(640, 480));  // active --> ready
+  bool const shown = win.scene().text.show &&
+    (win.scene().calib.show() == eye::window::CalibWidget::Show::average);
+  win.render();
+
+  // Switch content without closing; drawn by the next frame
+  win.handle(Input::enter);     // ready --> active
+  win.reset("Targets");         // active --> ready
+  win.set({ { 320, 240, true } });
+  bool const switched = (win.render() == 640u * 480u) &&
+    (win.canvas().pixel(320, 240).r == 0) && win.scene().text.show &&
+    (win.scene().calib.show() == eye::window::CalibWidget::Show::none);
+  win.handle(Input::close);     // any --> close
+
+  std::vector<State> const expected{ State::ready, State::active,
+    State::ready, State::active, State::ready, State::active, State::ready,
+    State::close };
+
+  std::cout << "states:";
+  for (auto const& s : states) { std::cout << ' ' << s; }
+  std::cout << '\n';
+  return shown && switched && (states == expected);
+}
+
+// Change the fixation color of a gaze point that does not move; return
+// true if it is redrawn
+bool
+fixation_test()
+{
+  eye::Screen scr(0, 0, 0, 640, 480, 0.0f, 0.0f);
+  eye::window::Headless win(scr, "Headless Fixation");
+  win.handle(Input::start);
+  win.handle(Input::toggle_avg);
+
+  eye::Gaze g = gaze_at(640, 480, 0);
+  g.fixation = false;
+  win.handle(g);
+  win.render();
+  auto const& c = win.canvas();
+  int const x = static_cast<int>(g.avg_px.x) + 18;    // On the circle line
+  int const y = static_cast<int>(g.avg_px.y);
+  auto const before = c.pixel(x, y);
+
+  g.fixation = true;
+  win.handle(g);
+  bool const damaged = (win.render() != 0);
+  auto const after = c.pixel(x, y);
+  return damaged && ((before.r != after.r) || (before.g != after.g) ||
+                     (before.b != after.b));
+}
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye { namespace window { namespace debug {
+
+void
+headless_benchmark()
+{
+  std::cout <<'\n'<< "eyelib: Headless window draw ("
+            << frame_count << " frames per measurement)" <<'\n'<<'\n';
+
+  bool const ok = state_test() && fixation_test();
+  std::cout << (ok ? "OK" : "FAIL") <<'\n'<<'\n';
+
+  std::cout << "scene         resolution    full redraw     damage redraw"
+            << "   damaged px" << '\n';
+  struct Size { int w; int h; };
+  for (auto s : { SceneType::gaze, SceneType::targets,
+                  SceneType::calibration })
+  {
+    for (auto const& size : { Size{1920, 1080}, Size{3840, 2160} })
+    {
+      Result r = benchmark(s, size.w, size.h);
+      std::cout << std::left << std::setw(14) << to_string(s) << std::right
+                << std::setw(4) << size.w << " x " << std::setw(4) << size.h
+                << std::fixed << std::setprecision(3)
+                << std::setw(12) << r.full_ms << " ms"
+                << std::setw(14) << r.damage_ms << " ms"
+                << std::setw(13) << std::setprecision(0) << r.damage_px
+                << '\n';
+    }
+  }
+  eye::debug::rule();
+}
+
+} } } // eye::window::debug
+//===========================================================================//
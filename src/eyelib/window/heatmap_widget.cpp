@@ -0,0 +1,108 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include "window/heatmap_widget.hpp"
+
+#include <FL/Fl_RGB_Image.H>  // Fl_RGB_Image
+
+namespace eye { namespace window {
+
+//---------------------------------------------------------------------------
+
+void
+HeatmapColors::set(Heatmap const& h)
+{
+  cols    = static_cast<int>(h.cols());
+  rows    = static_cast<int>(h.rows());
+  cell_px = static_cast<int>(h.cell_px());
+  rgba.resize(static_cast<std::size_t>(cols) * rows * 4);
+  h.colorize(rgba.data());
+}
+
+//---------------------------------------------------------------------------
+
+HeatmapWidget::HeatmapWidget()  = default;
+HeatmapWidget::~HeatmapWidget() = default;
+
+void
+HeatmapWidget::set(HeatmapColors const& c)
+{
+  colors_  = c;
+  changed_ = true;
+  stale_ = true;
+}
+
+void
+HeatmapWidget::draw()
+{
+  if (!show || colors_.rgba.empty()) { return; }
+
+  auto const& c = colors_;
+  if (stale_ || !image_)
+  {
+    // Nearest-neighbor scaling keeps cells as solid blocks
+    Fl_RGB_Image cells(c.rgba.data(), c.cols, c.rows, 4);
+    image_.reset(cells.copy(c.cols * c.cell_px, c.rows * c.cell_px));
+    stale_ = false;
+  }
+  image_->draw(0, 0);
+}
+
+void
+HeatmapWidget::draw(RasterCanvas& canvas) const
+{
+  if (!show || colors_.rgba.empty()) { return; }
+
+  auto const& c = colors_;
+  unsigned char const* px = c.rgba.data();
+  for (int row = 0; row != c.rows; ++row)
+  {
+    for (int col = 0; col != c.cols; ++col, px += 4)
+    {
+      canvas.blend({ col * c.cell_px, row * c.cell_px, c.cell_px, c.cell_px },
+                   px);
+    }
+  }
+}
+
+Rect
+HeatmapWidget::bounds() const
+{
+  if (!show || colors_.rgba.empty()) { return {}; }
+  return { 0, 0, colors_.cols * colors_.cell_px,
+           colors_.rows * colors_.cell_px };
+}
+
+void
+HeatmapWidget::damage(std::vector<Rect>& rects)
+{
+  if (changed_ && show) { rects.push_back(bounds()); }
+  changed_ = false;
+}
+
+//---------------------------------------------------------------------------
+
+} } // eye::window
+//===========================================================================//
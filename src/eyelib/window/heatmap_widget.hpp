@@ -0,0 +1,94 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Window gaze heatmap widget.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_WINDOW_HEATMAP_WIDGET_HPP
+#define EYELIB_WINDOW_HEATMAP_WIDGET_HPP
+
+#include <eyelib/gaze/heatmap.hpp>  // eye::Heatmap
+
+#include "window/raster_canvas.hpp"  // eye::window::RasterCanvas
+#include "window/rect.hpp"           // eye::window::Rect
+
+#include <memory>     // std::unique_ptr
+#include <vector>     // std::vector
+
+class Fl_Image;
+
+namespace eye { namespace window {
+
+/// @ingroup    window
+/// @{
+
+/// Colors of a heatmap, one RGBA pixel per cell.
+struct HeatmapColors
+{
+  std::vector<unsigned char> rgba;  ///< Pixels, row by row.
+  int   cols;                       ///< Number of cell columns.
+  int   rows;                       ///< Number of cell rows.
+  int   cell_px;                    ///< Cell width and height in pixels.
+
+  void set(Heatmap const& h);       ///< Take colors of heatmap @a h.
+};
+
+/**
+  @brief  Gaze heatmap overlay.
+
+  `set()` copies heatmap colors, so the heatmap may be colorized by the
+  thread that accumulates it and handed off.  The image scaled to the
+  screen is built on the next draw.
+*/
+struct HeatmapWidget
+{
+  bool show{false};   ///< `true` to draw heatmap.
+
+  HeatmapWidget();                                            ///< Constructor.
+  ~HeatmapWidget();                                           ///< Destructor.
+  HeatmapWidget(HeatmapWidget const&)            = delete;    ///< No copying.
+  HeatmapWidget& operator=(HeatmapWidget const&) = delete;    ///< No assignment.
+
+  void set(HeatmapColors const& c);   ///< Take heatmap colors @a c.
+  void draw();                  ///< Draw heatmap.
+  void draw(RasterCanvas& c) const;   ///< Draw into software canvas.
+  Rect bounds() const;          ///< Heatmap bounds; empty if not shown.
+
+  /// Append to @a rects the heatmap bounds if set since the last call.
+  void damage(std::vector<Rect>& rects);
+
+private:
+  HeatmapColors               colors_{};
+  std::unique_ptr<Fl_Image>   image_;     // Scaled to screen
+  bool  changed_{false};  // Set since last damage()
+  bool  stale_{false};    // Set since last draw()
+};
+
+/// @}
+
+} } // eye::window
+
+#endif // EYELIB_WINDOW_HEATMAP_WIDGET_HPP
+//===========================================================================//
@@ -0,0 +1,298 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include "window/raster_canvas.hpp"
+
+#include <FL/Fl.H>    // Fl::get_color
+
+#include <algorithm>  // std::fill, std::max, std::min
+#include <cmath>      // std::cos, std::sin, std::sqrt
+#include <cstring>    // std::memcpy
+
+namespace {   //-------------------------------------------------------------
+
+// Approximate Helvetica metrics, as fractions of the font size
+constexpr int advance_20ths = 11;   // Character advance
+constexpr int ascent_10ths  = 7;    // Box height above baseline
+
+constexpr double pi = 3.14159265358979323846;
+
+std::uint32_t
+pack(unsigned char r, unsigned char g, unsigned char b)
+{
+  unsigned char const bytes[4] = { r, g, b, 255 };
+  std::uint32_t px = 0;
+  std::memcpy(&px, bytes, sizeof(px));    // R, G, B, A in memory order
+  return px;
+}
+
+std::uint32_t
+pack(utl::color_rgb const& c)
+{
+  return pack(c.r, c.g, c.b);
+}
+
+// Half width of row dy of a disk of radius r; negative if outside
+int
+half_width(int r, int dy)
+{
+  double rr = (r + 0.5) * (r + 0.5) - static_cast<double>(dy) * dy;
+  return (rr < 0.0) ? -1 : static_cast<int>(std::sqrt(rr));
+}
+
+// Number of UTF-8 code points in str
+int
+char_count(std::string const& str)
+{
+  int n = 0;
+  for (unsigned char c : str)
+  {
+    if ((c & 0xC0) != 0x80) { ++n; }
+  }
+  return n;
+}
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye { namespace window {
+
+//---------------------------------------------------------------------------
+
+RasterCanvas::RasterCanvas(int w, int h)
+: w_(std::max(w, 0))
+, h_(std::max(h, 0))
+, pixels_(static_cast<std::size_t>(w_) * h_, pack(0, 0, 0))
+, clips_{{ 0, 0, w_, h_ }}
+{}
+
+int
+RasterCanvas::width() const
+{
+  return w_;
+}
+
+int
+RasterCanvas::height() const
+{
+  return h_;
+}
+
+unsigned char const*
+RasterCanvas::data() const
+{
+  return reinterpret_cast<unsigned char const*>(pixels_.data());
+}
+
+RasterCanvas::Color
+RasterCanvas::pixel(int x, int y) const
+{
+  if (!contains({ 0, 0, w_, h_ }, x, y)) { return { 0, 0, 0 }; }
+  unsigned char const* p = data() + 4 * (static_cast<std::size_t>(y) * w_ + x);
+  return { p[0], p[1], p[2] };
+}
+
+//---------------------------------------------------------------------------
+
+void
+RasterCanvas::push_clip(Rect const& r)
+{
+  clips_.push_back(intersect(clips_.back(), r));
+}
+
+void
+RasterCanvas::pop_clip()
+{
+  if (clips_.size() > 1) { clips_.pop_back(); }
+}
+
+//---------------------------------------------------------------------------
+
+void
+RasterCanvas::fill(Rect const& r, Color const& c)
+{
+  Rect const b = intersect(clips_.back(), r);
+  if (b.empty()) { return; }
+  std::uint32_t const px = pack(c);
+  for (int y = b.y; y != b.y + b.h; ++y)
+  {
+    auto row = pixels_.begin() + static_cast<std::size_t>(y) * w_;
+    std::fill(row + b.x, row + b.x + b.w, px);
+  }
+}
+
+void
+RasterCanvas::blend(Rect const& r, unsigned char const* rgba)
+{
+  Rect const b = intersect(clips_.back(), r);
+  if (b.empty() || (rgba[3] == 0)) { return; }
+  unsigned const a = rgba[3];
+  for (int y = b.y; y != b.y + b.h; ++y)
+  {
+    unsigned char* p = reinterpret_cast<unsigned char*>(pixels_.data())
+                     + 4 * (static_cast<std::size_t>(y) * w_ + b.x);
+    for (int x = 0; x != b.w; ++x, p += 4)
+    {
+      for (int k = 0; k != 3; ++k)
+      {
+        p[k] = static_cast<unsigned char>((rgba[k] * a + p[k] * (255 - a)
+                                           + 127) / 255);
+      }
+    }
+  }
+}
+
+void
+RasterCanvas::disk(int cx, int cy, int r, Color const& c)
+{
+  if (!visible(cx, cy, r)) { return; }
+  std::uint32_t const px = pack(c);
+  for (int dy = -r; dy <= r; ++dy)
+  {
+    int const hw = half_width(r, dy);
+    span(cx - hw, cx + hw, cy + dy, px);
+  }
+}
+
+void
+RasterCanvas::circle(int cx, int cy, int r, int line, Color const& c)
+{
+  if (!visible(cx, cy, r + line)) { return; }
+  // Line centered on the radius, at least one pixel wide
+  int const lw    = std::max(line, 1);
+  int const outer = r + lw/2;
+  int const inner = outer - lw;
+  std::uint32_t const px = pack(c);
+  for (int dy = -outer; dy <= outer; ++dy)
+  {
+    int const ho = half_width(outer, dy);
+    int const hi = (inner < 0) ? -1 : half_width(inner, dy);
+    span(cx - ho, cx - hi - 1, cy + dy, px);    // Left of the hole
+    span(cx + hi + 1, cx + ho, cy + dy, px);    // Right of the hole
+  }
+}
+
+void
+RasterCanvas::sector(int cx, int cy, int r, int a0, int a1, Color const& c)
+{
+  if (!visible(cx, cy, r)) { return; }
+  int const sweep = a1 - a0;
+  if (sweep <= 0) { return; }
+  if (sweep >= 360)
+  {
+    disk(cx, cy, r, c);
+    return;
+  }
+
+  // Edge directions, with y up as for the angles
+  double const u0x = std::cos(a0 * pi / 180.0);
+  double const u0y = std::sin(a0 * pi / 180.0);
+  double const u1x = std::cos(a1 * pi / 180.0);
+  double const u1y = std::sin(a1 * pi / 180.0);
+
+  // Inside the convex sector from a0 to a1, or outside the one from a1 to a0
+  bool const convex = (sweep <= 180);
+  auto inside = [&](double px, double py)
+    {
+      return convex
+        ?  ((u0x * py - u0y * px >= 0.0) && (px * u1y - py * u1x >= 0.0))
+        : !((u1x * py - u1y * px >  0.0) && (px * u0y - py * u0x >  0.0));
+    };
+
+  std::uint32_t const px = pack(c);
+  for (int dy = -r; dy <= r; ++dy)
+  {
+    int const hw = half_width(r, dy);
+    int run = 0;    // Start of the current run of pixels inside
+    bool in = false;
+    for (int dx = -hw; dx <= hw + 1; ++dx)
+    {
+      bool const i = (dx <= hw) && inside(dx, -dy);
+      if (i && !in)  { run = dx; }
+      if (!i && in)  { span(cx + run, cx + dx - 1, cy + dy, px); }
+      in = i;
+    }
+  }
+}
+
+void
+RasterCanvas::text(std::string const& str, int x, int y, int size,
+                   Color const& c)
+{
+  int const advance = (size * advance_20ths + 10) / 20;
+  int const ascent  = (size * ascent_10ths + 5) / 10;
+  int n = 0;
+  for (std::size_t i = 0; i != str.size(); ++i)
+  {
+    unsigned char const ch = static_cast<unsigned char>(str[i]);
+    if ((ch & 0xC0) == 0x80) { continue; }  // Continuation byte
+    if (ch != ' ')
+    {
+      fill({ x + n * advance + 1, y - ascent, advance - 2, ascent }, c);
+    }
+    ++n;
+  }
+}
+
+/*static*/ int
+RasterCanvas::text_width(std::string const& str, int size)
+{
+  return char_count(str) * ((size * advance_20ths + 10) / 20);
+}
+
+/*static*/ RasterCanvas::Color
+RasterCanvas::rgb(Fl_Color c)
+{
+  unsigned char r = 0;
+  unsigned char g = 0;
+  unsigned char b = 0;
+  Fl::get_color(c, r, g, b);
+  return { r, g, b };
+}
+
+//---------------------------------------------------------------------------
+// private
+
+bool
+RasterCanvas::visible(int cx, int cy, int r) const
+{
+  return intersects(clips_.back(), circle_bounds(cx, cy, r + 1));
+}
+
+void
+RasterCanvas::span(int x0, int x1, int y, std::uint32_t px)
+{
+  Rect const& clip = clips_.back();
+  if ((y < clip.y) || (y >= clip.y + clip.h)) { return; }
+  x0 = std::max(x0, clip.x);
+  x1 = std::min(x1, clip.x + clip.w - 1);
+  if (x0 > x1) { return; }
+  auto row = pixels_.begin() + static_cast<std::size_t>(y) * w_;
+  std::fill(row + x0, row + x1 + 1, px);
+}
+
+//---------------------------------------------------------------------------
+
+} } // eye::window
+//===========================================================================//
@@ -0,0 +1,125 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Window software raster canvas.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_WINDOW_RASTER_CANVAS_HPP
+#define EYELIB_WINDOW_RASTER_CANVAS_HPP
+
+#include "window/rect.hpp"  // eye::window::Rect
+
+#include <utl/color.hpp>    // utl::color_rgb
+
+#include <FL/Enumerations.H>  // Fl_Color
+
+#include <cstdint>    // std::uint32_t
+#include <string>     // std::string
+#include <vector>     // std::vector
+
+namespace eye { namespace window {
+
+/// @ingroup    window
+/// @{
+
+//---------------------------------------------------------------------------
+
+/**
+  @brief  In-memory RGBA image that widgets draw into without a display.
+
+  Provides the shapes the window widgets are made of, rasterized in
+  software as horizontal spans, so a scene can be drawn and measured on a
+  machine without an X server.  No font rasterizer is available, so text
+  is drawn as one box per character using approximate Helvetica metrics;
+  layout and bounds match, glyph shapes do not.
+
+  Pixels are stored row by row, four bytes per pixel in R, G, B, A order,
+  and are always opaque.  Drawing is clipped to the canvas and to the
+  innermost rectangle pushed by `push_clip()`.
+*/
+class RasterCanvas
+{
+public:
+  using Color = utl::color_rgb;   ///< Color alias.
+
+  /// Construct @a w by @a h pixel canvas filled with black.
+  RasterCanvas(int w, int h);
+
+  int width() const;                    ///< Width in pixels.
+  int height() const;                   ///< Height in pixels.
+  unsigned char const* data() const;    ///< RGBA pixels, row by row.
+  Color pixel(int x, int y) const;      ///< Color at (@a x, @a y).
+
+  void push_clip(Rect const& r);  ///< Clip drawing to @a r within current.
+  void pop_clip();                ///< Restore previous clip rectangle.
+
+  /// Fill rectangle @a r.
+  void fill(Rect const& r, Color const& c);
+
+  /// @brief  Blend rectangle @a r with @a rgba color.
+  /// @note   The alpha of @a rgba weights its color over the canvas.
+  void blend(Rect const& r, unsigned char const* rgba);
+
+  /// Fill circle of radius @a r centered on (@a cx, @a cy).
+  void disk(int cx, int cy, int r, Color const& c);
+
+  /// @brief  Draw circle of radius @a r and line width @a line.
+  /// @note   A line width of `0` draws the thinnest line, as for FLTK.
+  void circle(int cx, int cy, int r, int line, Color const& c);
+
+  /// @brief  Fill circular sector from @a a0 to @a a1 degrees.
+  /// @note   Angles are counterclockwise from 3 o'clock, as for `fl_pie()`.
+  void sector(int cx, int cy, int r, int a0, int a1, Color const& c);
+
+  /// Draw text @a str of @a size pixels with its baseline at @a y.
+  void text(std::string const& str, int x, int y, int size, Color const& c);
+
+  /// Width in pixels of text @a str of @a size pixels.
+  static int text_width(std::string const& str, int size);
+
+  /// Convert FLTK color @a c to RGB.
+  static Color rgb(Fl_Color c);
+
+private:
+  // true if circle of radius r may overlap the clip rectangle
+  bool visible(int cx, int cy, int r) const;
+
+  // Fill pixels x0 to x1 inclusive of row y, clipped
+  void span(int x0, int x1, int y, std::uint32_t px);
+
+  int                         w_;
+  int                         h_;
+  std::vector<std::uint32_t>  pixels_;
+  std::vector<Rect>           clips_;   // Clip stack; back() is current
+};
+
+//---------------------------------------------------------------------------
+
+/// @}
+
+} } // eye::window
+
+#endif // EYELIB_WINDOW_RASTER_CANVAS_HPP
+//===========================================================================//
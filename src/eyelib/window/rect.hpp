@@ -0,0 +1,128 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Window rectangle.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_WINDOW_RECT_HPP
+#define EYELIB_WINDOW_RECT_HPP
+
+#include <algorithm>  // std::min, std::max
+
+namespace eye { namespace window {
+
+/// @ingroup    window
+/// @{
+
+//---------------------------------------------------------------------------
+
+/// @brief  Axis-aligned rectangle in window pixel coordinates.
+/// @note   An aggregate; value-initialize (`Rect{}`) for an empty rectangle.
+struct Rect
+{
+  int x;      ///< Left edge.
+  int y;      ///< Top edge.
+  int w;      ///< Width; empty if not positive.
+  int h;      ///< Height; empty if not positive.
+
+  /// `true` if rectangle contains no pixels.
+  bool empty() const { return (w <= 0) || (h <= 0); }
+};
+
+/// Return bounding box of a circle of radius @a r centered on (@a cx, @a cy).
+inline Rect
+circle_bounds(int cx, int cy, int r)
+{
+  return { cx - r, cy - r, 2*r + 1, 2*r + 1 };
+}
+
+/// Return smallest rectangle containing @a a and @a b.
+inline Rect
+unite(Rect const& a, Rect const& b)
+{
+  if (a.empty()) { return b; }
+  if (b.empty()) { return a; }
+  int x0 = std::min(a.x, b.x);
+  int y0 = std::min(a.y, b.y);
+  int x1 = std::max(a.x + a.w, b.x + b.w);
+  int y1 = std::max(a.y + a.h, b.y + b.h);
+  return { x0, y0, x1 - x0, y1 - y0 };
+}
+
+/// Return rectangle of the pixels in both @a a and @a b; empty if none.
+inline Rect
+intersect(Rect const& a, Rect const& b)
+{
+  int x0 = std::max(a.x, b.x);
+  int y0 = std::max(a.y, b.y);
+  int x1 = std::min(a.x + a.w, b.x + b.w);
+  int y1 = std::min(a.y + a.h, b.y + b.h);
+  return { x0, y0, x1 - x0, y1 - y0 };
+}
+
+/// `true` if @a a and @a b share at least one pixel.
+inline bool
+intersects(Rect const& a, Rect const& b)
+{
+  return !a.empty() && !b.empty()
+      && (a.x < b.x + b.w) && (b.x < a.x + a.w)
+      && (a.y < b.y + b.h) && (b.y < a.y + a.h);
+}
+
+/// `true` if @a r contains pixel (@a x, @a y).
+inline bool
+contains(Rect const& r, int x, int y)
+{
+  return (x >= r.x) && (x < r.x + r.w) && (y >= r.y) && (y < r.y + r.h);
+}
+
+/// @name     Non-member function overloads
+/// @relates  Rect
+/// @{
+
+/// Equal to operator.
+inline bool
+operator==(Rect const& a, Rect const& b)
+{
+  return (a.x == b.x) && (a.y == b.y) && (a.w == b.w) && (a.h == b.h);
+}
+
+/// Not equal to operator.
+inline bool
+operator!=(Rect const& a, Rect const& b)
+{
+  return !(a == b);
+}
+
+/// @}
+
+//---------------------------------------------------------------------------
+
+/// @}
+
+} } // eye::window
+
+#endif // EYELIB_WINDOW_RECT_HPP
+//===========================================================================//
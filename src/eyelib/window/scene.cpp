@@ -0,0 +1,138 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include "window/scene.hpp"
+
+#include <FL/fl_draw.H>   // fl_push_clip, fl_pop_clip
+
+namespace eye { namespace window {
+
+//---------------------------------------------------------------------------
+
+void
+Scene::draw(int w, int h)
+{
+  sprites_.background(background);
+  targets.draw(w, h, background, sprites_);  // Background and target(s)
+  heatmap.draw();         // Draw gaze heatmap
+  calib.draw(sprites_);   // Draw overall calibration or point results
+  text.draw(sprites_);    // Draw text
+  gaze.draw();            // Draw gaze point(s)
+  mark_drawn();
+}
+
+void
+Scene::draw(Rect const& r)
+{
+  if (r.empty()) { return; }
+
+  sprites_.background(background);
+  fl_push_clip(r.x, r.y, r.w, r.h);
+
+  // Draw only widgets overlapping r, in the same order as a full draw
+  targets.draw(r, background, sprites_);  // Background and target(s)
+  if (intersects(r, heatmap.bounds())) { heatmap.draw(); }
+  if (intersects(r, calib.bounds())) { calib.draw(sprites_); }
+  if (intersects(r, text.bounds()))  { text.draw(sprites_); }
+  if (intersects(r, gaze.raw_bounds()) || intersects(r, gaze.avg_bounds()))
+  {
+    gaze.draw();
+  }
+  fl_pop_clip();
+}
+
+void
+Scene::draw(Rect const& r, RasterCanvas& canvas)
+{
+  if (r.empty()) { return; }
+
+  canvas.push_clip(r);
+  targets.draw(r, background, canvas);  // Background and target(s)
+  if (intersects(r, heatmap.bounds())) { heatmap.draw(canvas); }
+  if (intersects(r, calib.bounds())) { calib.draw(canvas); }
+  if (intersects(r, text.bounds()))  { text.draw(canvas); }
+  if (intersects(r, gaze.raw_bounds()) || intersects(r, gaze.avg_bounds()))
+  {
+    gaze.draw(canvas);
+  }
+  canvas.pop_clip();
+}
+
+void
+Scene::damage(std::vector<Rect>& rects)
+{
+  auto check = [&rects](Rect& drawn, Rect const& current, bool restyled)
+    {
+      if (drawn != current)
+      {
+        if (!drawn.empty())   { rects.push_back(drawn); }
+        if (!current.empty()) { rects.push_back(current); }
+        drawn = current;
+      }
+      else if (restyled && !current.empty())
+      {
+        rects.push_back(current);   // Same place, different appearance
+      }
+    };
+  check(drawn_heatmap_, heatmap.bounds(), false);
+  check(drawn_calib_,   calib.bounds(),   false);
+  check(drawn_text_,    text.bounds(),    false);
+  check(drawn_raw_,     gaze.raw_bounds(), gaze.show_raw != drawn_show_raw_);
+  check(drawn_avg_,     gaze.avg_bounds(),
+        (gaze.show_avg != drawn_show_avg_) ||
+        (gaze.fixation != drawn_fixation_));
+  drawn_fixation_ = gaze.fixation;
+  drawn_show_raw_ = gaze.show_raw;
+  drawn_show_avg_ = gaze.show_avg;
+  targets.damage(rects);    // Targets set, activated or deactivated
+  heatmap.damage(rects);    // Heatmap colors changed
+}
+
+void
+Scene::invalidate()
+{
+  sprites_.clear();
+}
+
+//---------------------------------------------------------------------------
+// private
+
+void
+Scene::mark_drawn()
+{
+  drawn_heatmap_ = heatmap.bounds();
+  drawn_calib_   = calib.bounds();
+  drawn_text_    = text.bounds();
+  drawn_raw_     = gaze.raw_bounds();
+  drawn_avg_     = gaze.avg_bounds();
+  drawn_fixation_ = gaze.fixation;
+  drawn_show_raw_ = gaze.show_raw;
+  drawn_show_avg_ = gaze.show_avg;
+}
+
+//---------------------------------------------------------------------------
+
+} } // eye::window
+//===========================================================================//
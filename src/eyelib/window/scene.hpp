@@ -0,0 +1,118 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Window scene.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_WINDOW_SCENE_HPP
+#define EYELIB_WINDOW_SCENE_HPP
+
+#include "window/calib_widget.hpp"  // eye::window::CalibWidget
+#include "window/gaze_widget.hpp"   // eye::window::GazeWidget
+#include "window/heatmap_widget.hpp" // eye::window::HeatmapWidget
+#include "window/raster_canvas.hpp" // eye::window::RasterCanvas
+#include "window/rect.hpp"          // eye::window::Rect
+#include "window/sprite_cache.hpp"  // eye::window::SpriteCache
+#include "window/target_layer.hpp"  // eye::window::TargetLayer
+#include "window/text_widget.hpp"   // eye::window::TextWidget
+
+#include <FL/Enumerations.H>  // Fl_Color
+
+#include <vector>     // std::vector
+
+namespace eye { namespace window {
+
+/// @ingroup    window
+/// @{
+
+//---------------------------------------------------------------------------
+
+/**
+  @brief  Widgets drawn in a window, and the regions they occupy.
+
+  Tracks the bounding box each widget occupied when last drawn, so that a
+  change can be redrawn by repainting only the previous and current
+  bounding boxes of the widgets that moved.  Targets, calibration results
+  and text are drawn from a sprite cache.  Must only be used from the
+  thread that draws.
+*/
+struct Scene
+{
+  CalibWidget   calib{};      ///< Calibration results.
+  TargetLayer   targets{};    ///< Visual targets.
+  HeatmapWidget heatmap{};    ///< Gaze heatmap.
+  GazeWidget    gaze{};       ///< Gaze point.
+  TextWidget    text{};       ///< Text overlay.
+  Fl_Color      background{FL_GRAY};  ///< Background color.
+
+  /// Draw all widgets over a background filling @a w by @a h pixels.
+  void draw(int w, int h);
+
+  /// @brief  Draw background and widgets within rectangle @a r only.
+  /// @note   Drawing is clipped to @a r.
+  void draw(Rect const& r);
+
+  /// @brief  Draw background and widgets within rectangle @a r only, into
+  ///         software canvas @a canvas.
+  /// @note   Drawing is clipped to @a r.  Sprites are not used.
+  void draw(Rect const& r, RasterCanvas& canvas);
+
+  /// @brief  Append to @a rects the regions changed since the last draw.
+  ///
+  /// For each widget whose bounding box changed, both the previous and
+  /// current bounding boxes are damaged.  The gaze points are also damaged
+  /// when they are shown or hidden, or the fixation color changes, in
+  /// place.  The current boxes and appearance are then recorded as drawn.
+  void damage(std::vector<Rect>& rects);
+
+  /// Discard pre-rendered images.  Call when calibration or targets change.
+  void invalidate();
+
+private:
+  SpriteCache sprites_{};     // Pre-rendered widget images
+
+  // Bounding boxes when last drawn
+  Rect drawn_heatmap_{};
+  Rect drawn_calib_{};
+  Rect drawn_raw_{};
+  Rect drawn_avg_{};
+  Rect drawn_text_{};
+
+  // Gaze point appearance when last drawn
+  bool drawn_fixation_{false};
+  bool drawn_show_raw_{false};
+  bool drawn_show_avg_{false};
+
+  void mark_drawn();
+};
+
+//---------------------------------------------------------------------------
+
+/// @}
+
+} } // eye::window
+
+#endif // EYELIB_WINDOW_SCENE_HPP
+//===========================================================================//
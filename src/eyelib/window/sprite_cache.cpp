@@ -0,0 +1,127 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include "window/sprite_cache.hpp"
+
+#include <FL/Fl.H>            // Fl::get_color
+#include <FL/Fl_RGB_Image.H>  // Fl_RGB_Image
+#include <FL/fl_draw.H>       // fl_rectf, fl_read_image, fl_push_no_clip
+#include <FL/x.H>             // Fl_Offscreen
+
+#include <vector>     // std::vector
+
+namespace eye { namespace window {
+
+//---------------------------------------------------------------------------
+
+SpriteCache::SpriteCache()                               = default;
+SpriteCache::~SpriteCache()                              = default;
+SpriteCache::SpriteCache(SpriteCache&&)                  = default;
+SpriteCache& SpriteCache::operator=(SpriteCache&&)       = default;
+
+//---------------------------------------------------------------------------
+
+void
+SpriteCache::background(Fl_Color color)
+{
+  if (color != background_)
+  {
+    background_ = color;
+    clear();    // Transparency was keyed to the old background
+  }
+}
+
+void
+SpriteCache::draw(std::string const& key, Rect const& bounds,
+                  painter const& paint)
+{
+  if (bounds.empty()) { return; }
+
+  auto it = sprites_.find(key);
+  if (it == sprites_.end())
+  {
+    it = sprites_.emplace(key, render(bounds, paint)).first;
+  }
+  it->second->draw(bounds.x, bounds.y);
+}
+
+void
+SpriteCache::clear()
+{
+  sprites_.clear();
+}
+
+std::size_t
+SpriteCache::size() const
+{
+  return sprites_.size();
+}
+
+//---------------------------------------------------------------------------
+// private
+
+SpriteCache::image_ptr
+SpriteCache::render(Rect const& bounds, painter const& paint) const
+{
+  int const w = bounds.w;
+  int const h = bounds.h;
+
+  // Rasterize over the background, outside any clip region of the caller
+  std::vector<unsigned char> rgb(w * h * 3);
+  Fl_Offscreen buffer = fl_create_offscreen(w, h);
+  fl_begin_offscreen(buffer);
+  fl_push_no_clip();
+  fl_rectf(0, 0, w, h, background_);
+  paint(-bounds.x, -bounds.y);
+  fl_read_image(rgb.data(), 0, 0, w, h);
+  fl_pop_clip();
+  fl_end_offscreen();
+  fl_delete_offscreen(buffer);
+
+  // Background pixels become transparent
+  unsigned char bg_r = 0;
+  unsigned char bg_g = 0;
+  unsigned char bg_b = 0;
+  Fl::get_color(background_, bg_r, bg_g, bg_b);
+
+  unsigned char* rgba = new unsigned char[w * h * 4];
+  for (int i = 0; i != w * h; ++i)
+  {
+    unsigned char const* src = &rgb[3 * i];
+    unsigned char*       dst = &rgba[4 * i];
+    dst[0] = src[0];
+    dst[1] = src[1];
+    dst[2] = src[2];
+    dst[3] = (src[0] == bg_r && src[1] == bg_g && src[2] == bg_b) ? 0 : 255;
+  }
+  image_ptr image(new Fl_RGB_Image(rgba, w, h, 4));
+  image->alloc_array = 1;     // Image owns and deletes pixel data
+  return image;
+}
+
+//---------------------------------------------------------------------------
+
+} } // eye::window
+//===========================================================================//
@@ -0,0 +1,106 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Window sprite cache.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_WINDOW_SPRITE_CACHE_HPP
+#define EYELIB_WINDOW_SPRITE_CACHE_HPP
+
+#include "window/rect.hpp"  // eye::window::Rect
+
+#include <FL/Enumerations.H>  // Fl_Color
+
+#include <functional>     // std::function
+#include <memory>         // std::unique_ptr
+#include <string>         // std::string
+#include <unordered_map>  // std::unordered_map
+
+class Fl_RGB_Image;
+
+namespace eye { namespace window {
+
+/// @ingroup    window
+/// @{
+
+//---------------------------------------------------------------------------
+
+/**
+  @brief  Pre-rendered widget images.
+
+  Each distinct widget appearance is identified by a key, rasterized once
+  into an offscreen buffer, and kept as an image with an alpha channel.
+  Later draws of the same appearance are image blits.
+
+  Sprites are rendered over the background color, and pixels left at the
+  background color become transparent, so sprites may overlap other
+  widgets.  Changing the background clears the cache.  Must only be used
+  from the thread that draws.
+*/
+class SpriteCache
+{
+public:
+
+  /// @brief  Sprite paint callback alias.
+  ///
+  /// Draws the widget offset by (`dx`, `dy`) so that its bounding box is
+  /// at the origin of the sprite.
+  using painter = std::function<void(int dx, int dy)>;
+
+  SpriteCache();                                          ///< Constructor.
+  ~SpriteCache();                                         ///< Destructor.
+  SpriteCache(SpriteCache const&)            = delete;    ///< No copying.
+  SpriteCache& operator=(SpriteCache const&) = delete;    ///< No assignment.
+  SpriteCache(SpriteCache&&);                             ///< Move.
+  SpriteCache& operator=(SpriteCache&&);                  ///< Move assign.
+
+  /// Set background color.  Clears the cache if changed.
+  void background(Fl_Color color);
+
+  /// @brief  Draw sprite identified by @a key at @a bounds.
+  ///
+  /// If not cached, @a paint is first called to render it.
+  void draw(std::string const& key, Rect const& bounds, painter const& paint);
+
+  void clear();               ///< Remove all sprites.
+  std::size_t size() const;   ///< Number of cached sprites.
+
+private:
+  using image_ptr = std::unique_ptr<Fl_RGB_Image>;
+
+  image_ptr render(Rect const& bounds, painter const& paint) const;
+
+  std::unordered_map<std::string, image_ptr> sprites_;
+  Fl_Color background_{FL_GRAY};
+};
+
+//---------------------------------------------------------------------------
+
+/// @}
+
+} } // eye::window
+
+#endif // EYELIB_WINDOW_SPRITE_CACHE_HPP
+//===========================================================================//
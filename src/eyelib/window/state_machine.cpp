@@ -0,0 +1,150 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include "window/state_machine.hpp"
+
+namespace eye { namespace window {
+
+//---------------------------------------------------------------------------
+
+StateMachine::StateMachine(Scene& scene)
+: scene_(scene)
+{}
+
+void
+StateMachine::handle(Input in)
+{
+  using I     = StateMachine::Input;
+  using S     = CalibWidget::Show;
+  using State = Window::State;
+
+  // Input handled in any window state
+  switch (in)
+  {
+    case I::toggle_raw:
+      scene_.gaze.show_raw = !scene_.gaze.show_raw;
+      return;
+    case I::toggle_avg:
+      scene_.gaze.show_avg = !scene_.gaze.show_avg;
+      return;
+    case I::toggle_heatmap:
+      scene_.heatmap.show = !scene_.heatmap.show;
+      return;
+    case I::cycle_calib:
+      switch (scene_.calib.show())
+      {
+        case S::average:  scene_.calib.show(S::points);   break;
+        case S::points:   scene_.calib.show(S::none);     break;
+        case S::none:     scene_.calib.show(S::average);  break;
+        default:  break;  // Invalid
+      }
+      return;
+    case I::close:
+      set(State::close);
+      return;
+    case I::reset:
+      if ((state_ == State::ready) || (state_ == State::active))
+      {
+        scene_.text.show = true;
+        scene_.calib.show(S::none);   // Results of previous content
+        set(State::ready);
+      }
+      return;
+    default:
+      break;
+  }
+
+  // Input handled based on window state
+  //    init --> ready --> active --> close
+  switch (state_)
+  {
+    case State::init:
+      if (in == I::start)
+      {
+        set(State::ready);
+      }
+      break;
+    case State::ready:
+      if (in == I::enter)
+      {
+        scene_.text.show = false;
+        set(State::active);
+        scene_.calib.show(S::none);   // Hide calibration results
+      }
+      break;
+    case State::active:
+      if (in == I::escape)
+      {
+        scene_.text.show = true;
+        set(State::ready);
+      }
+      break;
+    case State::close:  // Window is closing
+    default:  break;    // Do nothing
+  }
+}
+
+void
+StateMachine::apply(Calibration const& c)
+{
+  scene_.calib.set(c);  // Set calibration results
+  scene_.invalidate();  // Discard sprites of previous results
+
+  // Show results when drawing
+  scene_.calib.show(CalibWidget::Show::average);
+
+  scene_.text.show = true;
+  set(Window::State::ready);
+}
+
+Window::State
+StateMachine::state() const
+{
+  return state_;
+}
+
+void
+StateMachine::register_handler(Window::state_handler callback)
+{
+  if (callback)
+  {
+    callback_ = callback;
+  }
+}
+
+//---------------------------------------------------------------------------
+// private
+
+void
+StateMachine::set(Window::State s)
+{
+  state_ = s;
+  callback_(state_);      // Invoke callback
+}
+
+//---------------------------------------------------------------------------
+
+} } // eye::window
+//===========================================================================//
@@ -0,0 +1,104 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Window state machine.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_WINDOW_STATE_MACHINE_HPP
+#define EYELIB_WINDOW_STATE_MACHINE_HPP
+
+#include <eyelib/calibration.hpp>   // eye::Calibration
+
+#include "window/scene.hpp"   // eye::window::Scene
+#include "window/window.hpp"  // eye::Window::State
+
+namespace eye { namespace window {
+
+/// @ingroup    window
+/// @{
+
+//---------------------------------------------------------------------------
+
+/**
+  @brief  Window state and the scene changes made by user input.
+
+  Independent of FLTK, so the same transitions are driven by key presses
+  in a `Window` and by scripted input to a headless window.
+
+  ```
+  init --start--> ready --enter--> active --escape--> ready
+                    ^                 |
+                    +---calibration---+       any --close--> close
+                    +------reset------+
+  ```
+*/
+class StateMachine
+{
+public:
+
+  /// Input to the window.
+  enum class Input
+  {
+    start,          ///< Window shown.
+    enter,          ///< Enter key; start main screen.
+    escape,         ///< Esc key; return to title screen.
+    close,          ///< Window closing.
+    reset,          ///< Content replaced; return to title screen.
+    toggle_raw,     ///< Show or hide raw gaze point.
+    toggle_avg,     ///< Show or hide smoothed gaze point.
+    toggle_heatmap, ///< Show or hide gaze heatmap.
+    cycle_calib,    ///< Show calibration average, then points, then none.
+  };
+
+  /// Construct in `init` state, changing widgets of @a scene.
+  explicit StateMachine(Scene& scene);
+
+  /// Apply input @a in.
+  void handle(Input in);
+
+  /// Show calibration results @a c and return to the title screen.
+  void apply(Calibration const& c);
+
+  Window::State state() const;    ///< Current state.
+
+  /// Register state change notification handler.
+  void register_handler(Window::state_handler callback);
+
+private:
+  void set(Window::State s);      // Change state and notify
+
+  Scene&                  scene_;
+  Window::State           state_{Window::State::init};
+  Window::state_handler   callback_{[](Window::State const&){}};
+};
+
+//---------------------------------------------------------------------------
+
+/// @}
+
+} } // eye::window
+
+#endif // EYELIB_WINDOW_STATE_MACHINE_HPP
+//===========================================================================//
@@ -0,0 +1,326 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include "window/target_layer.hpp"
+
+#include <FL/fl_draw.H>   // fl_rectf, fl_push_clip, fl_copy_offscreen
+#include <FL/x.H>         // Fl_Offscreen
+
+#include <algorithm>  // std::find, std::max, std::min
+
+namespace {   //-------------------------------------------------------------
+
+constexpr int cell_px = 64;   // Grid cell width and height
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye { namespace window {
+
+//---------------------------------------------------------------------------
+
+struct TargetLayer::Offscreen
+{
+  Offscreen(int w, int h, Fl_Color bg)
+  : buffer(fl_create_offscreen(w, h))
+  , w(w)
+  , h(h)
+  , bg(bg)
+  {}
+
+  ~Offscreen() { fl_delete_offscreen(buffer); }
+
+  Fl_Offscreen  buffer;
+  int           w;
+  int           h;
+  Fl_Color      bg;
+};
+
+//---------------------------------------------------------------------------
+
+constexpr std::size_t TargetLayer::npos;
+
+TargetLayer::TargetLayer()  = default;
+TargetLayer::~TargetLayer() = default;
+
+void
+TargetLayer::set(Targets const& ts)
+{
+  if (!extent_.empty()) { damaged_.push_back(extent_); }
+
+  targets_.assign(ts.cbegin(), ts.cend());
+  bounds_.clear();
+  active_.clear();
+  extent_ = {};
+  for (std::size_t i = 0; i != targets_.size(); ++i)
+  {
+    bounds_.push_back(targets_[i].bounds());
+    extent_ = unite(extent_, bounds_.back());
+    if (targets_[i].active()) { active_.push_back(i); }
+  }
+  index();
+
+  if (!extent_.empty()) { damaged_.push_back(extent_); }
+  stale_.clear();
+  rebuild_ = true;
+}
+
+void
+TargetLayer::clear()
+{
+  set({});
+}
+
+bool
+TargetLayer::active(std::size_t index, bool a)
+{
+  if ((index >= targets_.size()) || (targets_[index].active() == a))
+  {
+    return false;
+  }
+  targets_[index].active(a);
+  if (a)
+  {
+    active_.push_back(index);
+  }
+  else
+  {
+    active_.erase(std::find(active_.begin(), active_.end(), index));
+  }
+  stale_.push_back(bounds_[index]);     // Add or remove from static layer
+  damaged_.push_back(bounds_[index]);
+  return true;
+}
+
+std::size_t
+TargetLayer::size() const
+{
+  return targets_.size();
+}
+
+bool
+TargetLayer::empty() const
+{
+  return targets_.empty();
+}
+
+TargetWidget const&
+TargetLayer::operator[](std::size_t index) const
+{
+  return targets_[index];
+}
+
+std::size_t
+TargetLayer::find(int x, int y) const
+{
+  std::size_t found = npos;
+  bool found_active = false;
+  query({ x, y, 1, 1 }, [&](std::size_t i)
+    {
+      bool a = targets_[i].active();
+      if ((found == npos) || (a && !found_active) ||
+          ((a == found_active) && (i > found)))
+      {
+        found = i;
+        found_active = a;
+      }
+    });
+  return found;
+}
+
+void
+TargetLayer::draw(int w, int h, Fl_Color bg, SpriteCache& cache)
+{
+  damaged_.clear();
+  if (targets_.empty())
+  {
+    fl_rectf(0, 0, w, h, bg);   // Draw background
+    return;
+  }
+  update(w, h, bg);
+  fl_copy_offscreen(0, 0, w, h, layer_->buffer, 0, 0);
+  for (auto i : active_)
+  {
+    targets_[i].draw(cache);    // Draw active target(s)
+  }
+}
+
+void
+TargetLayer::draw(Rect const& r, Fl_Color bg, SpriteCache& cache)
+{
+  if (targets_.empty() || !layer_)
+  {
+    fl_rectf(r.x, r.y, r.w, r.h, bg);   // Erase previous content
+    return;
+  }
+  update(layer_->w, layer_->h, bg);
+  fl_copy_offscreen(r.x, r.y, r.w, r.h, layer_->buffer, r.x, r.y);
+  for (auto i : active_)
+  {
+    if (intersects(r, bounds_[i])) { targets_[i].draw(cache); }
+  }
+}
+
+void
+TargetLayer::draw(Rect const& r, Fl_Color bg, RasterCanvas& canvas)
+{
+  canvas.fill(r, RasterCanvas::rgb(bg));
+  query(r, [&](std::size_t i)
+    {
+      if (!targets_[i].active()) { targets_[i].draw(canvas); }
+    });
+  for (auto i : active_)
+  {
+    if (intersects(r, bounds_[i])) { targets_[i].draw(canvas); }
+  }
+  stale_.clear();
+  rebuild_ = true;
+}
+
+void
+TargetLayer::damage(std::vector<Rect>& rects)
+{
+  rects.insert(rects.end(), damaged_.cbegin(), damaged_.cend());
+  damaged_.clear();
+}
+
+//---------------------------------------------------------------------------
+// private
+
+template<typename F>
+void
+TargetLayer::query(Rect const& r, F f) const
+{
+  if (targets_.empty() || r.empty()) { return; }
+
+  // Cells whose targets' bounds may reach r
+  int c0 = std::max((r.x - margin_ - origin_x_) / cell_px, 0);
+  int r0 = std::max((r.y - margin_ - origin_y_) / cell_px, 0);
+  int c1 = std::min((r.x + r.w + margin_ - origin_x_) / cell_px, cols_ - 1);
+  int r1 = std::min((r.y + r.h + margin_ - origin_y_) / cell_px, rows_ - 1);
+
+  for (int row = r0; row <= r1; ++row)
+  {
+    for (int col = c0; col <= c1; ++col)
+    {
+      std::size_t c = static_cast<std::size_t>(row * cols_ + col);
+      for (std::size_t k = cell_start_[c]; k != cell_start_[c+1]; ++k)
+      {
+        std::size_t i = cell_items_[k];
+        if (intersects(r, bounds_[i])) { f(i); }
+      }
+    }
+  }
+}
+
+void
+TargetLayer::index()
+{
+  cell_start_.clear();
+  cell_items_.clear();
+  cols_ = rows_ = margin_ = 0;
+  if (targets_.empty()) { return; }
+
+  origin_x_ = extent_.x;
+  origin_y_ = extent_.y;
+  cols_ = extent_.w / cell_px + 1;
+  rows_ = extent_.h / cell_px + 1;
+
+  // Counting sort of targets into cells by the center of their bounds
+  std::vector<std::size_t> cell(targets_.size());
+  cell_start_.assign(static_cast<std::size_t>(cols_ * rows_) + 1, 0);
+  for (std::size_t i = 0; i != targets_.size(); ++i)
+  {
+    Rect const& b = bounds_[i];
+    int cx = b.x + b.w/2;
+    int cy = b.y + b.h/2;
+    margin_ = std::max({ margin_, cx - b.x, b.x + b.w - cx,
+                                  cy - b.y, b.y + b.h - cy });
+    cell[i] = static_cast<std::size_t>(((cy - origin_y_) / cell_px) * cols_
+                                      + (cx - origin_x_) / cell_px);
+    ++cell_start_[cell[i] + 1];
+  }
+  for (std::size_t c = 1; c != cell_start_.size(); ++c)
+  {
+    cell_start_[c] += cell_start_[c-1];
+  }
+  cell_items_.resize(targets_.size());
+  std::vector<std::size_t> next(cell_start_.cbegin(), cell_start_.cend() - 1);
+  for (std::size_t i = 0; i != targets_.size(); ++i)
+  {
+    cell_items_[next[cell[i]]++] = i;
+  }
+}
+
+void
+TargetLayer::update(int w, int h, Fl_Color bg)
+{
+  if (!layer_ || (layer_->w != w) || (layer_->h != h))
+  {
+    layer_.reset(new Offscreen(w, h, bg));
+    rebuild_ = true;
+  }
+  else if (layer_->bg != bg)
+  {
+    layer_->bg = bg;
+    rebuild_ = true;
+  }
+  if (!rebuild_ && stale_.empty()) { return; }
+
+  fl_begin_offscreen(layer_->buffer);
+  fl_push_no_clip();
+  if (rebuild_)
+  {
+    paint({ 0, 0, w, h });
+  }
+  else
+  {
+    for (auto const& r : stale_) { paint(r); }
+  }
+  fl_pop_clip();
+  fl_end_offscreen();
+  stale_.clear();
+  rebuild_ = false;
+}
+
+void
+TargetLayer::paint(Rect const& r) const
+{
+  fl_push_clip(r.x, r.y, r.w, r.h);
+  fl_rectf(r.x, r.y, r.w, r.h, layer_->bg);
+  query(r, [this](std::size_t i)
+    {
+      if (!targets_[i].active())
+      {
+        TargetWidget t(targets_[i]);  // Inactive targets are not animated
+        t.draw();
+      }
+    });
+  fl_pop_clip();
+}
+
+//---------------------------------------------------------------------------
+
+} } // eye::window
+//===========================================================================//
@@ -0,0 +1,157 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Window target layer.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_WINDOW_TARGET_LAYER_HPP
+#define EYELIB_WINDOW_TARGET_LAYER_HPP
+
+#include <eyelib.hpp>
+
+#include "window/rect.hpp"          // eye::window::Rect
+#include "window/sprite_cache.hpp"  // eye::window::SpriteCache
+#include "window/target_widget.hpp" // eye::window::TargetWidget
+
+#include <FL/Enumerations.H>  // Fl_Color
+
+#include <cstddef>    // std::size_t
+#include <memory>     // std::unique_ptr
+#include <vector>     // std::vector
+
+namespace eye { namespace window {
+
+/// @ingroup    window
+/// @{
+
+//---------------------------------------------------------------------------
+
+/**
+  @brief  Retained set of targets, scalable to thousands of targets.
+
+  Inactive targets are drawn once into an offscreen static layer along
+  with the background.  A draw copies the static layer and draws only the
+  active targets over it.  When a single target is activated or
+  deactivated, only its bounding box in the static layer is repainted and
+  reported as damaged, so the cost per frame depends on the number of
+  targets changed rather than the number of targets.
+
+  Targets are indexed by a uniform grid of screen cells, which finds the
+  targets within a region, or under a pixel, without visiting the others.
+  Active targets are drawn above inactive targets.  Must only be used from
+  the thread that draws.
+*/
+class TargetLayer
+{
+public:
+
+  /// Index returned by `find()` if no target is found.
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  TargetLayer();                                          ///< Constructor.
+  ~TargetLayer();                                         ///< Destructor.
+  TargetLayer(TargetLayer const&)            = delete;    ///< No copying.
+  TargetLayer& operator=(TargetLayer const&) = delete;    ///< No assignment.
+
+  void set(Targets const& ts);  ///< Replace all targets.
+  void clear();                 ///< Remove all targets.
+
+  /// @brief  Activate or deactivate target @a index.
+  /// @return `true` if the target changed.
+  bool active(std::size_t index, bool a);
+
+  std::size_t size() const;     ///< Number of targets.
+  bool        empty() const;    ///< `true` if there are no targets.
+
+  /// Target at @a index.
+  TargetWidget const& operator[](std::size_t index) const;
+
+  /// @brief  Return index of the target whose bounding box contains pixel
+  ///         (@a x, @a y), or `npos` if none does.
+  ///
+  /// If targets overlap, an active target is preferred over an inactive
+  /// one, then the target set last.
+  std::size_t find(int x, int y) const;
+
+  /// Draw @a bg background filling @a w by @a h pixels, and all targets.
+  void draw(int w, int h, Fl_Color bg, SpriteCache& cache);
+
+  /// @brief  Draw @a bg background and targets within rectangle @a r only.
+  /// @note   The caller clips drawing to @a r.
+  void draw(Rect const& r, Fl_Color bg, SpriteCache& cache);
+
+  /// @brief  Draw @a bg background and targets within rectangle @a r
+  ///         into software canvas @a canvas.
+  /// @note   The caller clips drawing to @a r.  The static layer is not
+  ///         used, and is rebuilt by the next draw to the display.
+  void draw(Rect const& r, Fl_Color bg, RasterCanvas& canvas);
+
+  /// @brief  Append to @a rects the regions changed since the last draw.
+  ///
+  /// After `set()` or `clear()`, these are the regions of the previous
+  /// and current targets; otherwise the bounding boxes of the targets
+  /// activated or deactivated.
+  void damage(std::vector<Rect>& rects);
+
+private:
+  struct Offscreen;   // Static layer image
+
+  // Call f(i) for each target i whose bounding box intersects r
+  template<typename F>
+  void query(Rect const& r, F f) const;
+
+  void index();                                     // Build grid
+  void update(int w, int h, Fl_Color bg);           // Refresh static layer
+  void paint(Rect const& r) const;                  // Paint static layer
+
+  std::vector<TargetWidget>   targets_{};
+  std::vector<Rect>           bounds_{};    // Bounding box of each target
+  std::vector<std::size_t>    active_{};    // Indices of active targets
+  Rect                        extent_{};    // Bounds of all targets
+
+  // Uniform grid: targets of cell c are cell_items_[cell_start_[c]] up to
+  // cell_items_[cell_start_[c+1]], binned by the center of their bounds
+  int                         origin_x_{0};
+  int                         origin_y_{0};
+  int                         cols_{0};
+  int                         rows_{0};
+  int                         margin_{0};   // Bounds extent beyond center
+  std::vector<std::size_t>    cell_start_{};
+  std::vector<std::size_t>    cell_items_{};
+
+  std::unique_ptr<Offscreen>  layer_;       // Background, inactive targets
+  std::vector<Rect>           stale_{};     // Static layer regions to paint
+  std::vector<Rect>           damaged_{};   // Regions to report as damaged
+  bool                        rebuild_{true};   // Paint entire static layer
+};
+
+//---------------------------------------------------------------------------
+
+/// @}
+
+} } // eye::window
+
+#endif // EYELIB_WINDOW_TARGET_LAYER_HPP
+//===========================================================================//
@@ -69,6 +69,51 @@ TargetWidget::active(bool a)
   active_ = a;
 }
 
+bool
+TargetWidget::active() const
+{
+  return active_;
+}
+
+#ifdef DYNAMIC_TARGET_WIDGET
+void
+TargetWidget::draw(SpriteCache&)
+{
+  draw();     // Animated; appearance changes every draw
+}
+#else
+void
+TargetWidget::draw(SpriteCache& cache) const
+{
+  cache.draw(active_ ? "target:1" : "target:0", bounds(),
+    [this](int dx, int dy)
+    {
+      TargetWidget t(*this);
+      t.x_ += dx;
+      t.y_ += dy;
+      t.draw();
+    });
+}
+#endif
+
+void
+TargetWidget::draw(RasterCanvas& canvas) const
+{
+  canvas.disk(x_, y_, disk_radius_px, active_ ? disk_active : disk_inactive);
+  canvas.disk(x_, y_, dot_radius_px,  active_ ? dot_active  : dot_inactive);
+}
+
+Rect
+TargetWidget::bounds() const
+{
+ #ifdef DYNAMIC_TARGET_WIDGET
+  return circle_bounds(x_, y_, std::max(disk_radius_px,
+                                        dyn_circle_radius_max + 1));
+ #else
+  return circle_bounds(x_, y_, disk_radius_px);
+ #endif
+}
+
 
 void
 #ifdef DYNAMIC_TARGET_WIDGET
@@ -31,6 +31,10 @@ SOFTWARE.
 
 #include <eyelib.hpp>
 
+#include "window/raster_canvas.hpp" // eye::window::RasterCanvas
+#include "window/rect.hpp"          // eye::window::Rect
+#include "window/sprite_cache.hpp"  // eye::window::SpriteCache
+
 #include <vector>   // std::vector
 
 namespace eye { namespace window {
@@ -48,6 +52,8 @@ struct TargetWidget
   TargetWidget() = default;             ///< Construct with default values.
 
   void active(bool a);    ///< `true` for active, `false` for inactive.
+  bool active() const;    ///< `true` if active.
+  Rect bounds() const;    ///< Bounding box of drawn target.
 
  //#define DYNAMIC_TARGET_WIDGET
  #ifdef DYNAMIC_TARGET_WIDGET
@@ -56,6 +62,15 @@ struct TargetWidget
   void draw() const;      ///< Draw target.
   #endif
 
+ #ifdef DYNAMIC_TARGET_WIDGET
+  void draw(SpriteCache& cache);        ///< Draw target; not cached.
+ #else
+  void draw(SpriteCache& cache) const;  ///< Draw pre-rendered target.
+ #endif
+
+  /// Draw into software canvas; not animated.
+  void draw(RasterCanvas& canvas) const;
+
 private:
   int  x_{0};
   int  y_{0};
@@ -44,13 +44,13 @@ constexpr auto line3 = " •  Press Esc to cancel";
 constexpr auto line4 = " •  Press Alt + F4 to exit";
 
 int
-width_px(std::string const& str)
+width_px(std::string const& str, int size_px)
 {
   int dx = 0; // Offset of first "colored in" pixel of str, from draw origin.
   int dy = 0;
   int w = 0;  // Dimensions of the bounding box around the text.
   int h = 0;
-  fl_font(font_face, font_size);  // Set text font prior to getting dimensions
+  fl_font(font_face, size_px);    // Set text font prior to getting dimensions
   fl_text_extents(str.c_str(), dx, dy, w, h); // Min pixel dimensions of str
   return w;     // Return text width in pixels
 }
@@ -71,6 +71,11 @@ TextLine::TextLine(std::string const& str, int x_px, int y_px)
 // x_px: (scr.w_px/2)
 // y_px: (scr.h_px/3)
 TextWidget::TextWidget(int x_px, int y_px, std::string const& intro)
+: TextWidget(x_px, y_px, intro, width_px)
+{}
+
+TextWidget::TextWidget(int x_px, int y_px, std::string const& intro,
+                       measure width_px)
 : cx_(x_px)
 , lines_{{
           { intro.c_str(), x_px, y_px - 2*y_offset  },
@@ -82,7 +87,7 @@ TextWidget::TextWidget(int x_px, int y_px, std::string const& intro)
   int max_width_px = 0;
   for (auto const& l : lines_)
   {
-    max_width_px = std::max(width_px(l.str), max_width_px);
+    max_width_px = std::max(width_px(l.str, font_size), max_width_px);
   }
   // Determine horizontal position of the beginning of the text to center-align.
   int w = (max_width_px / 2);
@@ -90,6 +95,16 @@ TextWidget::TextWidget(int x_px, int y_px, std::string const& intro)
   {
     l.x_px -= w;
   }
+  // Text is drawn above its baseline, with descenders below
+  int top    = lines_.front().y_px - font_size;
+  int bottom = lines_.back().y_px + (font_size / 2);
+  bounds_ = { x_px - w, top, max_width_px + 1, bottom - top };
+
+  sprite_ = "text:";
+  for (auto const& l : lines_)
+  {
+    sprite_ += l.str + '\n';
+  }
 }
 
 void
@@ -105,7 +120,43 @@ TextWidget::draw() const
     }
   }
 }
-
+
+void
+TextWidget::draw(SpriteCache& cache) const
+{
+  if (show)
+  {
+    cache.draw(sprite_, bounds_, [this](int dx, int dy)
+      {
+        fl_color(text_color);
+        fl_font(font_face, font_size);
+        for (auto const& t : lines_)
+        {
+          fl_draw(t.str.c_str(), t.x_px + dx, t.y_px + dy);
+        }
+      });
+  }
+}
+
+void
+TextWidget::draw(RasterCanvas& canvas) const
+{
+  if (show)
+  {
+    auto const color = RasterCanvas::rgb(text_color);
+    for (auto const& t : lines_)
+    {
+      canvas.text(t.str, t.x_px, t.y_px, font_size, color);
+    }
+  }
+}
+
+Rect
+TextWidget::bounds() const
+{
+  return show ? bounds_ : Rect{};
+}
+
 //-----------------------------------------------------------
 
 } } // eye::window
@@ -29,6 +29,10 @@ SOFTWARE.
 #ifndef EYLIB_WINDOW_TEXT_HPP
 #define EYLIB_WINDOW_TEXT_HPP
 
+#include "window/raster_canvas.hpp" // eye::window::RasterCanvas
+#include "window/rect.hpp"          // eye::window::Rect
+#include "window/sprite_cache.hpp"  // eye::window::SpriteCache
+
 #include <array>      // std::array
 #include <string>     // std::string
 
@@ -55,6 +59,9 @@ struct TextWidget     ///< Three lines of text.
 {
   bool show{true};    ///< `true` to draw on screen.
 
+  /// Text width function alias; returns width of @a str in pixels.
+  using measure = int (*)(std::string const& str, int size_px);
+
   /** @brief  Construct text lines.
 
     Example:
@@ -64,13 +71,23 @@ struct TextWidget     ///< Three lines of text.
   */
   TextWidget(int x_px, int y_px, std::string const& intro);
 
+  /// @brief  Construct text lines measured by @a width_px.
+  ///
+  /// For drawing without a display, pass `RasterCanvas::text_width`.
+  TextWidget(int x_px, int y_px, std::string const& intro, measure width_px);
+
   TextWidget() = default;   ///< Default constructor.
-  void draw() const;        ///< Draw lines of text.
+  void draw() const;        ///< Draw lines of text.
+  void draw(SpriteCache& cache) const;  ///< Draw pre-rendered text.
+  void draw(RasterCanvas& canvas) const;  ///< Draw into software canvas.
+  Rect bounds() const;      ///< Bounding box of text; empty if not shown.
 
 private:
   static constexpr std::size_t size_ = 5;
   int cx_{0};     // center of screen
   std::array<TextLine, size_> lines_{};
+  Rect bounds_{};           // Bounding box of all lines
+  std::string sprite_{};    // Sprite key
 };
 
 //---------------------------------------------------------------------------
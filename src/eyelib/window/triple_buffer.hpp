@@ -0,0 +1,114 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Lock-free triple buffer.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_WINDOW_TRIPLE_BUFFER_HPP
+#define EYELIB_WINDOW_TRIPLE_BUFFER_HPP
+
+#include <array>      // std::array
+#include <atomic>     // std::atomic
+
+namespace eye { namespace window {
+
+/// @ingroup    window
+/// @{
+
+//---------------------------------------------------------------------------
+
+/**
+  @brief  Wait-free handoff of the latest value from one thread to another.
+
+  Three buffers rotate between a single producer and a single consumer.
+  The producer fills its back buffer and publishes it by swapping it with
+  the middle buffer.  The consumer takes the middle buffer, if newer than
+  its front buffer, by swapping it with the front buffer.  Neither side
+  ever waits for the other, and the consumer always reads a complete
+  value.  Values published faster than they are consumed are overwritten,
+  so the consumer sees only the latest.
+
+  Example:
+  ```
+  // Producer thread
+  buffer.back() = value;
+  buffer.publish();
+
+  // Consumer thread
+  if (buffer.update()) { use(buffer.front()); }
+  ```
+*/
+template<typename T>
+class TripleBuffer
+{
+public:
+
+  TripleBuffer() = default;                           ///< Default constructor.
+  TripleBuffer(TripleBuffer const&)            = delete;  ///< No copying.
+  TripleBuffer& operator=(TripleBuffer const&) = delete;  ///< No assignment.
+
+  /// Producer buffer to fill before `publish()`.
+  T& back()             { return buffers_[back_]; }
+
+  /// Make the producer buffer available to the consumer.
+  void publish()
+  {
+    // Release the written buffer, acquire the one the consumer released
+    back_ = middle_.exchange(back_ | fresh, std::memory_order_acq_rel)
+          & index;
+  }
+
+  /// Take the latest published buffer.  Return `true` if it is new.
+  bool update()
+  {
+    if (!(middle_.load(std::memory_order_relaxed) & fresh))
+    {
+      return false;
+    }
+    front_ = middle_.exchange(front_, std::memory_order_acq_rel) & index;
+    return true;
+  }
+
+  /// Consumer buffer, valid until the next `update()`.
+  T const& front() const { return buffers_[front_]; }
+
+private:
+  static constexpr unsigned char index = 0x03;  // Buffer index bits
+  static constexpr unsigned char fresh = 0x04;  // Middle buffer not consumed
+
+  std::array<T,3>             buffers_{};
+  std::atomic<unsigned char>  middle_{2};   // Shared: index and fresh bit
+  unsigned char               back_{0};     // Producer only
+  unsigned char               front_{1};    // Consumer only
+};
+
+//---------------------------------------------------------------------------
+
+/// @}
+
+} } // eye::window
+
+#endif // EYELIB_WINDOW_TRIPLE_BUFFER_HPP
+//===========================================================================//
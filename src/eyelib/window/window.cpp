@@ -29,11 +29,15 @@ SOFTWARE.
 
 #include "debug/debug_out.hpp"      // eye::debug
 #include "window/calib_widget.hpp"  // eye::window::CalibWidget
+#include "window/frame_scheduler.hpp" // eye::window::FrameScheduler
 #include "window/gaze_widget.hpp"   // eye::window::GazeWidget
+#include "window/heatmap_widget.hpp" // eye::window::HeatmapColors
+#include "window/rect.hpp"          // eye::window::Rect
+#include "window/scene.hpp"         // eye::window::Scene
+#include "window/state_machine.hpp" // eye::window::StateMachine
 #include "window/target_widget.hpp" // eye::window::TargetWidget
 #include "window/text_widget.hpp"   // eye::window::Text
-
-#include <utl/fltk/fltk_lock.hpp>   // utl::fltk::scoped_lock
+#include "window/triple_buffer.hpp" // eye::window::TripleBuffer
 
 #include <FL/Fl.H>          // FLTK GUI libraries
 #include <FL/fl_ask.H>      // fl_choice
@@ -45,12 +49,25 @@ SOFTWARE.
 
 #include <utl/memory.hpp>   // utl::make_unique
 
+#include <atomic>       // std::atomic
+#include <chrono>       // std::chrono::steady_clock
 #include <iostream>     // std::cout
+#include <mutex>        // std::mutex, std::lock_guard
 #include <string>       // std::to_string
+#include <utility>      // std::move, std::pair
+#include <vector>       // std::vector
 
 namespace {   //-------------------------------------------------------------
 
-using window_lock = utl::fltk::scoped_lock;
+using steady_clock = std::chrono::steady_clock;
+
+// FLTK does not report the display refresh rate; assume the common rate.
+constexpr double refresh_hz = 60.0;
+
+// Gaze heatmap
+constexpr unsigned  heatmap_cell_px      = 8;       // Cell size
+constexpr float     heatmap_sigma_px     = 24.0f;   // Splat radius
+constexpr unsigned  heatmap_half_life_ms = 10000;   // Decay
 
 // Confirm user intent and close window.
 // Invoked by main thread.  Do not call Fl::lock() and Fl::unlock().
@@ -86,6 +103,12 @@ struct Window::Impl
 
   int  run();               // Run until window is closed
   void draw() override;     // Draw the window
+  void flush() override;    // Draw and copy to screen
+  void render();            // Apply new state and mark damaged regions
+  void invalidate();        // Request redraw of entire window
+  void set_targets(Targets&& ts);   // Queue replacement targets
+  void apply_content();     // Apply target and gaze display changes
+  void apply_contingent(bool new_gaze);   // Damage gaze-contingent region
 
   // @brief  Process a window event.
   // @param  [in] event_code   FLTK event code.
@@ -98,10 +121,13 @@ struct Window::Impl
   void handle(Calibration const& c);      // Calibration results
   void handle(Gaze const& g);             // Gaze data handler
   void handle(Tracker::State const& s);   // Tracker state change handler
+  void apply(Calibration const& c);       // Show calibration results
 
   // Event callbacks
+  static void contingent_frame(void *userdata);
   static void toggle_raw_gaze(Fl_Widget*, void *userdata);
   static void toggle_avg_gaze(Fl_Widget*, void *userdata);
+  static void toggle_heatmap(Fl_Widget*, void *userdata);
   static void show_calib_average(Fl_Widget*, void *userdata);
   static void show_calib_points(Fl_Widget*, void *userdata);
   static void show_calib_none(Fl_Widget*, void *userdata);
@@ -109,8 +135,13 @@ struct Window::Impl
   //---------------------------------------------------------------
   // Callbacks
 
+  // Registered by client threads and invoked by the main thread, which
+  // copies each handler under the lock before invoking it
+  std::mutex            handlers_mutex_{};
   Window::event_handler event_callback_{[](Event const&){}};
   Window::state_handler state_callback_{[](State const&){}};
+  Window::contingent_handler contingent_callback_{
+    [](window::ContingentFrame const&){}};
 
   // Window::Impl::run() saves tracker_'s current calibration and gaze
   // handlers before registering the associated Window::Impl::handle()
@@ -122,11 +153,58 @@ struct Window::Impl
 
   //---------------------------------------------------------------
 
-  Window::State         state_{State::init};  // Window state
-  window::CalibWidget   calib_{};             // Calibration results
-  window::TargetWidgets targets_{};           // Visual targets
-  window::GazeWidget    gaze_{};              // Gaze point
-  window::TextWidget    text_{};              // Text overlay
+  window::Scene         scene_{};             // Widgets to draw
+  window::StateMachine  machine_{scene_};     // Window state
+  std::vector<window::Rect> damaged_{};       // Regions to redraw
+  std::atomic<bool>     full_redraw_{true};   // Redraw entire window
+
+  // Content changes from client threads, applied by the main thread
+  // unless deferred by begin_update()
+  using active_change = std::pair<std::size_t, bool>;
+  std::mutex                  targets_mutex_{};
+  std::unique_ptr<std::string> new_title_{};    // Title screen reset
+  std::unique_ptr<Targets>    new_targets_{};   // Replacement targets
+  std::vector<active_change>  new_active_{};    // Then activate/deactivate
+  std::atomic<int>            new_show_raw_{-1};  // Gaze shown, -1 if same
+  std::atomic<int>            new_show_avg_{-1};
+  std::atomic<int>            new_show_heatmap_{-1};
+  std::atomic<unsigned>       updating_{0};     // Changes deferred
+
+  // Gaze sample and the time it was received from the tracker
+  struct GazeSample
+  {
+    Gaze                      gaze;
+    steady_clock::time_point  received;
+  };
+
+  // Latest tracker data, handed off from the tracker thread without locks
+  window::TripleBuffer<GazeSample>  gaze_buffer_{};
+  window::TripleBuffer<Calibration> calib_buffer_{};
+  GazeSample                        gaze_{};    // Latest taken
+
+  // Gaze-contingent drawing.  Changes from client threads are applied by
+  // the main thread.  While enabled, each gaze sample wakes the main
+  // thread, collapsing samples that arrive while a frame is drawn.
+  std::mutex                  contingent_mutex_{};
+  std::unique_ptr<window::Contingent> new_contingent_{};
+  std::atomic<bool>           contingent_on_{false};
+  std::atomic<bool>           contingent_pending_{false};   // Wake queued
+  window::Contingent          contingent_{};
+  window::Rect                contingent_region_{};   // Current region
+  bool                        contingent_fresh_{false};   // New sample
+  bool                        contingent_drawn_{false};   // In this flush
+  unsigned                    contingent_frames_{0};
+
+  // Gaze heatmap, accumulated by the tracker thread at the gaze rate.  While
+  // shown, the main thread asks for colors once per frame, and the tracker
+  // thread colorizes and hands them off if points were added since.
+  Heatmap               heatmap_;                 // Tracker thread only
+  bool                  heatmap_changed_{true};   // Since colorized
+  std::atomic<bool>     heatmap_wanted_{false};   // Colors requested
+  std::atomic<bool>     heatmap_clear_{false};    // Clear requested
+  window::TripleBuffer<window::HeatmapColors> heatmap_buffer_{};
+
+  window::FrameScheduler frames_;             // Paces redraw to display
   Tracker&              tracker_;             // Eye tracker
 };
 
@@ -135,12 +213,24 @@ struct Window::Impl
 Window::Impl::Impl(Tracker& tracker, Screen const& scr,
                    std::string const& title, ColorRGB const& bg)
 : Fl_Double_Window(scr.x_px, scr.y_px, scr.w_px, scr.h_px, title.c_str())
-, text_(scr.w_px/2, scr.h_px/3, title)
+, heatmap_(scr.w_px, scr.h_px, heatmap_cell_px,
+           heatmap_sigma_px, heatmap_half_life_ms)
+, frames_(refresh_hz, [this](){ render(); })
 , tracker_(tracker)
 {
   // Convert RGB components to single color value, and set window background
   unsigned bg_color = ((bg.r << 24) | (bg.g << 16) | (bg.b << 8));
   color(bg_color);
+  scene_.background = bg_color;
+  scene_.text = window::TextWidget(scr.w_px/2, scr.h_px/3, title);
+  machine_.register_handler([this](State const& s){
+    Window::state_handler callback;
+    {
+      std::lock_guard<std::mutex> lock(handlers_mutex_);
+      callback = state_callback_;
+    }
+    callback(s);
+  });
 
   callback(exit_callback);            // Callback to confirm program exit
   fullscreen();                       // Fill screen, no window manager border
@@ -184,8 +274,6 @@ Window::Impl::Impl(Tracker& tracker, Screen const& scr,
 
 Window::Impl::~Impl()
 {
-  window_lock lock();     // Acquire scoped lock
-
   // Unregister handlers call handler methods
   //tracker_.register_handler([this](Gaze        const& g){ /* do-nothing */ });
   //tracker_.register_handler([this](Calibration const& c){ /* do-nothing */ });
@@ -194,8 +282,10 @@ Window::Impl::~Impl()
   tracker_.register_handler(calib_callback_);
   tracker_.register_handler(gaze_callback_);
 
-  state_ = Window::State::close;
-  state_callback_(state_);
+  frames_.stop();         // Remove refresh timeout
+  contingent_on_ = false; // Stop waking the main thread
+
+  machine_.handle(window::StateMachine::Input::close);
 }
 
 //---------------------------------------------------------------------------
@@ -203,10 +293,10 @@ Window::Impl::~Impl()
 int
 Window::Impl::run()
 {
-  // Enable multi-thread support by locking from the main
-  // thread.  Fl::wait() and Fl::run() call Fl::unlock() and
-  // Fl::lock() as needed to release control to the child threads
-  // when it is safe to do so...
+  // Enable multi-thread support by locking from the main
+  // thread.  Fl::wait() and Fl::run() call Fl::unlock() and
+  // Fl::lock() as needed to release control to the child threads
+  // when it is safe to do so...
   if (Fl::lock())
   {
     eye::debug::error(__FILE__, __LINE__, "multi-thread not supported");
@@ -216,6 +306,7 @@ Window::Impl::run()
 
   //make_current();
   show();   // Can only be called by the main thread
+  frames_.start();  // Refresh timeout runs on the main thread
 
   handle(FL_ENTER);
   handle(FL_PUSH);
@@ -234,8 +325,7 @@ Window::Impl::run()
   tracker_.register_handler([this](Calibration const& c){ handle(c); });
 
   redraw();                       // Mark window as needing draw() called
-  state_ = Window::State::ready;  // Update state
-  state_callback_(state_);        // Invoke callback
+  machine_.handle(window::StateMachine::Input::start);  // Update state
   tracker_.start();               // Start tracker if it's not already started
   //std::this_thread::sleep_for(std::chrono::milliseconds(1000));
   return Fl::run();               // Run until window is closed
@@ -247,11 +337,185 @@ Window::Impl::run()
 void
 Window::Impl::draw()  // override
 {
-  Fl_Double_Window::draw();   // Draw base window
-  window::draw(targets_);     // Draw target(s)
-  calib_.draw();          // Draw overall calibration or point results
-  text_.draw();           // Draw text      ... to hide:  text_.show = false
-  gaze_.draw();           // Draw gaze point(s)
+  // Redraw everything on expose, resize or redraw(); otherwise only the
+  // regions damaged by render().  Fl_Double_Window clips drawing to the
+  // damaged region and copies only that region to the screen.
+  if ((damage() & ~FL_DAMAGE_USER1) || damaged_.empty())
+  {
+    scene_.draw(w(), h());    // Background and all widgets
+  }
+  else
+  {
+    for (auto const& r : damaged_)
+    {
+      scene_.draw(r);         // Background and widgets within r
+    }
+  }
+  damaged_.clear();
+
+  // Client drawing that follows the gaze, over the scene
+  if (contingent_.draw && !contingent_region_.empty())
+  {
+    auto const& r = contingent_region_;
+    fl_push_clip(r.x, r.y, r.w, r.h);
+    contingent_.draw(gaze_.gaze, r);
+    fl_pop_clip();
+    contingent_drawn_ = true;
+  }
+}
+
+// flush() is called by FLTK (main thread), or by contingent_frame().
+void
+Window::Impl::flush()  // override
+{
+  auto start = steady_clock::now();
+  Fl_Double_Window::flush();  // Draw back buffer and copy to screen
+  auto end = steady_clock::now();
+
+  // Report only frames showing a sample not reported before
+  if (contingent_drawn_ && contingent_fresh_)
+  {
+    using ms = std::chrono::duration<double, std::milli>;
+    window::ContingentFrame f{};
+    f.frame        = ++contingent_frames_;
+    f.gaze_time_ms = gaze_.gaze.time_ms;
+    f.latency_ms   = ms(end - gaze_.received).count();
+    f.draw_ms      = ms(end - start).count();
+    f.region       = contingent_region_;
+    contingent_fresh_ = false;
+    Window::contingent_handler callback;
+    {
+      std::lock_guard<std::mutex> lock(handlers_mutex_);
+      callback = contingent_callback_;
+    }
+    callback(f);
+  }
+  contingent_drawn_ = false;
+}
+
+// render() is called by the frame scheduler (main thread).
+void
+Window::Impl::render()
+{
+  // Take the latest data published by the tracker thread
+  bool const new_gaze = gaze_buffer_.update();
+  if (new_gaze)
+  {
+    gaze_ = gaze_buffer_.front();
+    scene_.gaze.set(gaze_.gaze);
+  }
+  if (calib_buffer_.update())
+  {
+    apply(calib_buffer_.front());
+  }
+  if (updating_ == 0)
+  {
+    apply_content();
+  }
+  if (heatmap_buffer_.update())
+  {
+    scene_.heatmap.set(heatmap_buffer_.front());  // Scaled when drawn
+  }
+  heatmap_wanted_ = scene_.heatmap.show;    // Colors for the next frame
+
+  std::size_t n = damaged_.size();
+  apply_contingent(new_gaze); // Previous and current contingent regions
+  if (full_redraw_.exchange(false))
+  {
+    redraw();     // Mark entire window as needing draw() called
+    return;
+  }
+  scene_.damage(damaged_);    // Previous and current bounds of changes
+  for (std::size_t i = n; i != damaged_.size(); ++i)
+  {
+    auto const& r = damaged_[i];
+    damage(FL_DAMAGE_USER1, r.x, r.y, r.w, r.h);
+  }
+}
+
+// May be called from any thread.
+void
+Window::Impl::invalidate()
+{
+  full_redraw_ = true;
+  frames_.request();
+}
+
+// May be called from any thread.
+void
+Window::Impl::set_targets(Targets&& ts)
+{
+  {
+    std::lock_guard<std::mutex> lock(targets_mutex_);
+    new_targets_ = utl::make_unique<Targets>(std::move(ts));
+    new_active_.clear();      // Superseded by new targets
+  }
+  invalidate();               // Redraw at next display refresh
+}
+
+// Invoked by the main thread.
+void
+Window::Impl::apply_content()
+{
+  std::unique_ptr<std::string> title;
+  std::unique_ptr<Targets> targets;
+  std::vector<active_change> active;
+  {
+    std::lock_guard<std::mutex> lock(targets_mutex_);
+    title.swap(new_title_);
+    targets.swap(new_targets_);
+    active.swap(new_active_);
+  }
+  if (title)
+  {
+    scene_.text = window::TextWidget(w()/2, h()/3, *title);
+    machine_.handle(window::StateMachine::Input::reset);
+    full_redraw_ = true;
+  }
+  if (targets)
+  {
+    scene_.targets.set(*targets);   // Rebuilds the static layer
+  }
+  for (auto const& a : active)
+  {
+    scene_.targets.active(a.first, a.second);   // Damages target only
+  }
+  int const raw  = new_show_raw_.exchange(-1);
+  int const avg  = new_show_avg_.exchange(-1);
+  int const heat = new_show_heatmap_.exchange(-1);
+  if (raw >= 0)  { scene_.gaze.show_raw = (raw != 0); }
+  if (avg >= 0)  { scene_.gaze.show_avg = (avg != 0); }
+  if (heat >= 0) { scene_.heatmap.show  = (heat != 0); }
+}
+
+// Invoked by the main thread.
+void
+Window::Impl::apply_contingent(bool new_gaze)
+{
+  std::unique_ptr<window::Contingent> c;
+  {
+    std::lock_guard<std::mutex> lock(contingent_mutex_);
+    c.swap(new_contingent_);
+  }
+  if (c)
+  {
+    contingent_ = std::move(*c);
+    new_gaze = true;          // Region of the new callback
+  }
+  if (!new_gaze) { return; }
+
+  window::Rect r{};
+  if (contingent_.region) { r = contingent_.region(gaze_.gaze); }
+  if ((r != contingent_region_) && !contingent_region_.empty())
+  {
+    damaged_.push_back(contingent_region_);   // Erase previous region
+  }
+  if (!r.empty())
+  {
+    damaged_.push_back(r);    // Redrawn for every sample
+  }
+  contingent_region_ = r;
+  contingent_fresh_  = !r.empty();
 }
 
 //---------------------------------------------------------------------------
@@ -262,13 +526,14 @@ Window::Impl::draw()  // override
 int
 Window::Impl::handle(int event_code)  // override
 {
-  // 2016-09-25 Lucas:  Notwithstanding comment above, added
-  //  scoped lock to address crashes during use of the popup menu.
-  window_lock lock();   // Acquire scoped lock
-
   eye::Window::Event event(tracker_.gaze_time_ms(), event_code);  // Event data
   bool handled = false;                   // true if event is handled
-  event_callback_(event);                 // Event notification callback
+  Window::event_handler callback;
+  {
+    std::lock_guard<std::mutex> lock(handlers_mutex_);
+    callback = event_callback_;
+  }
+  callback(event);                        // Event notification callback
 
   if (event.is_focus())
   {
@@ -299,20 +564,23 @@ Window::Impl::handle(int event_code)  // override
 bool
 Window::Impl::handle_key_press(Event const& event)
 {
-  using State   = eye::Window::State;
+  using Input   = eye::window::StateMachine::Input;
   using Special = eye::Window::Event::Key::Special;
 
   // Handle key press for any window state
   if (event.key.to_string() == "1")
   {
     toggle_raw_gaze(0, (void*)this);
-    //gaze_.show_raw = !gaze_.show_raw;   // Toggle raw gaze widget
     return true;
   }
   if (event.key.to_string() == "2")
   {
     toggle_avg_gaze(0, (void*)this);
-    //gaze_.show_avg = !gaze_.show_avg;   // Toggle smoothed gaze widget
+    return true;
+  }
+  if (event.key.to_string() == "3")
+  {
+    toggle_heatmap(0, (void*)this);
     return true;
   }
   if ((event.key.to_string() == "c") ||
@@ -320,14 +588,7 @@ Window::Impl::handle_key_press(Event const& event)
   {
     // Change which calibration results to show
     //  average --> all points --> none
-    using S = eye::window::CalibWidget::Show;
-    switch (calib_.show())
-    {
-      case S::average:  calib_.show(S::points);   break;
-      case S::points:   calib_.show(S::none);     break;
-      case S::none:     calib_.show(S::average);  break;
-      default:  break;  // Invalid
-    }
+    machine_.handle(Input::cycle_calib);
     return true;
   }
   // Alt+F4 or Ctrl+F4 to close window
@@ -340,33 +601,13 @@ Window::Impl::handle_key_press(Event const& event)
 
   // Handle key press based on window state
   //    init --> ready --> active --> close
-  switch (state_)
-  {
-    case State::ready:
-      if (event.key.special() == Special::escape)   // Esc key
-      {
-        //return false;   // Pass to window
-        return true;   // Consume
-      }
-      else if (event.key.is_enter())   // Enter key
-      {
-        text_.show = false;
-        state_ = State::active;
-        state_callback_(state_);      // Invoke callback
-        // Hide calibration results
-        calib_.show(eye::window::CalibWidget::Show::none);
-      }
-      break;
-    case State::active:
-      if (event.key.special() == Special::escape)   // Esc key
-      {
-        text_.show = true;
-        state_ = State::ready;
-        state_callback_(state_);      // Invoke callback
-      }
-    case State::init:   // Window not running yet
-    case State::close:  // Window is closing
-    default:  break;    // Do nothing
+  if (event.key.special() == Special::escape)   // Esc key
+  {
+    machine_.handle(Input::escape);
+  }
+  else if (event.key.is_enter())                // Enter key
+  {
+    machine_.handle(Input::enter);
   }
   return true;    // Consume event
 }
@@ -374,11 +615,14 @@ Window::Impl::handle_key_press(Event const& event)
 void
 Window::Impl::handle_right_click()
 {
-  int raw_gaze_flags = (FL_MENU_TOGGLE | (gaze_.show_raw ? FL_MENU_VALUE : 0));
-  int avg_gaze_flags = (FL_MENU_TOGGLE | (gaze_.show_avg ? FL_MENU_VALUE : 0));
+  auto const& g = scene_.gaze;
+  int raw_gaze_flags = (FL_MENU_TOGGLE | (g.show_raw ? FL_MENU_VALUE : 0));
+  int avg_gaze_flags = (FL_MENU_TOGGLE | (g.show_avg ? FL_MENU_VALUE : 0));
+  int heatmap_flags  = (FL_MENU_TOGGLE |
+                        (scene_.heatmap.show ? FL_MENU_VALUE : 0));
 
   using S = eye::window::CalibWidget::Show;
-  auto s = calib_.show();
+  auto s = scene_.calib.show();
   int calib_avg_flags = (FL_MENU_RADIO | (s==S::average ? FL_MENU_VALUE : 0));
   int calib_pts_flags = (FL_MENU_RADIO | (s==S::points  ? FL_MENU_VALUE : 0));
   int calib_non_flags = (FL_MENU_RADIO | (s==S::none    ? FL_MENU_VALUE : 0));
@@ -407,7 +651,8 @@ Window::Impl::handle_right_click()
                                                             FL_MENU_DIVIDER },
     { "Gaze:",        0, 0, 0, FL_MENU_INACTIVE },
     { "&Raw",         '1',  toggle_raw_gaze, (void*)this, raw_gaze_flags },
-    { "&Smoothed",    '2',  toggle_avg_gaze, (void*)this, avg_gaze_flags |
+    { "&Smoothed",    '2',  toggle_avg_gaze, (void*)this, avg_gaze_flags },
+    { "&Heatmap",     '3',  toggle_heatmap,  (void*)this, heatmap_flags |
                                                             FL_MENU_DIVIDER },
     { "E&xit",        FL_ALT + FL_F + 4, exit_callback },
     { 0 }
@@ -423,80 +668,126 @@ Window::Impl::handle_right_click()
 
 //---------------------------------------------------------------------------
 
+// Invoked by the tracker thread.
 void
 Window::Impl::handle(Calibration const& c)
 {
-  window_lock lock();   // Acquire scoped lock
-  calib_.set(c);        // Set calibration results
   calib_callback_(c);   // Invoke saved callback
 
-  // Show results when drawing
-  calib_.show(eye::window::CalibWidget::Show::average);
-
-  text_.show  = true;
-  state_      = State::ready;
-  state_callback_(state_);      // Invoke callback
-  redraw();       // Mark window as needing draw() called
-  Fl::awake();    // Tell main thread to redraw
+  // Hand off to main thread, which applies results in render()
+  calib_buffer_.back() = c;
+  calib_buffer_.publish();
+  frames_.request();    // Redraw at next display refresh
 }
 
+// Invoked by the tracker thread.
 void
 Window::Impl::handle(eye::Gaze const& g)
 {
   //-------------------------------------------------------
-  // Fl::flush() causes all windows that need it to be
-  // redrawn and graphics forced out through the pipes.
-  // This is what wait() does before looking for events.
-  // Note:  In multi-threaded applications you should only
-  //   call Fl::flush() from the main thread.  If a child
-  //   thread needs to trigger a redraw event, it should
-  //   instead call Fl::awake() to get the main thread to
-  //   process the event queue.
+  // Gaze data arrives at the tracker rate, which may exceed
+  // the display refresh rate.  Rather than waking the main
+  // thread with Fl::awake() for every sample, latch the
+  // newest sample and let the frame scheduler redraw once
+  // per display refresh.  The sample is handed off through
+  // a triple buffer, so neither thread blocks, and draw()
+  // always sees a complete sample.
   //-------------------------------------------------------
-  window_lock lock();   // Acquire scoped lock
-  gaze_.set(g);         // Set gaze point coordinates and fixation flag
+  gaze_buffer_.back() = { g, steady_clock::now() };
+  gaze_buffer_.publish();
+  if (heatmap_clear_.exchange(false))
+  {
+    heatmap_.clear();
+    heatmap_changed_ = true;
+  }
+  if (g.tracking.gaze)
+  {
+    heatmap_.add(g.avg_px.x, g.avg_px.y, g.time_ms);
+    heatmap_changed_ = true;
+  }
+  // Colors are relative to the maximum, so change only with new points
+  if (heatmap_changed_ && heatmap_wanted_.exchange(false))
+  {
+    heatmap_buffer_.back().set(heatmap_);
+    heatmap_buffer_.publish();
+    heatmap_changed_ = false;
+  }
  #if 1
   gaze_callback_(g);    // Invoke saved callback
  #endif
-  redraw();             // Mark window as needing draw() called
-  Fl::awake();          // Tell main thread to redraw
+  if (contingent_on_)
+  {
+    // Wake the main thread now, unless a wake is already queued
+    if (!contingent_pending_.exchange(true))
+    {
+      Fl::awake(contingent_frame, this);
+    }
+    return;
+  }
+  frames_.request();    // Redraw at next display refresh
+}
+
+// Invoked by the main thread.
+void
+Window::Impl::apply(Calibration const& c)
+{
+  machine_.apply(c);    // Show results on title screen
+  full_redraw_ = true;
 }
 
 //---------------------------------------------------------------------------
 
+// Invoked by the main thread, woken by handle(Gaze).
+/*static*/ void
+Window::Impl::contingent_frame(void *userdata)
+{
+  Window::Impl *w = (Window::Impl*)userdata;
+  w->contingent_pending_ = false;   // Later samples queue another frame
+  w->render();    // Take freshest sample and damage contingent region
+  Fl::flush();    // Draw and copy to screen without waiting for the loop
+}
+
 /*static*/ void
 Window::Impl::toggle_raw_gaze(Fl_Widget*, void *userdata)
 {
   Window::Impl *w = (Window::Impl*)userdata;
-  w->gaze_.show_raw = !w->gaze_.show_raw;   // Toggle raw gaze widget
+  w->machine_.handle(window::StateMachine::Input::toggle_raw);
 }
 
 /*static*/ void
 Window::Impl::toggle_avg_gaze(Fl_Widget*, void *userdata)
 {
   Window::Impl *w = (Window::Impl*)userdata;
-  w->gaze_.show_avg = !w->gaze_.show_avg;   // Toggle smoothed gaze widget
+  w->machine_.handle(window::StateMachine::Input::toggle_avg);
+}
+
+/*static*/ void
+Window::Impl::toggle_heatmap(Fl_Widget*, void *userdata)
+{
+  Window::Impl *w = (Window::Impl*)userdata;
+  w->machine_.handle(window::StateMachine::Input::toggle_heatmap);
+  w->frames_.request();       // Colorize at next display refresh
 }
 
 /*static*/ void
 Window::Impl::show_calib_average(Fl_Widget*, void *userdata)
 {
   Window::Impl *w = (Window::Impl*)userdata;
-  w->calib_.show(eye::window::CalibWidget::Show::average);
+  w->scene_.calib.show(eye::window::CalibWidget::Show::average);
 }
 
 /*static*/ void
 Window::Impl::show_calib_points(Fl_Widget*, void *userdata)
 {
   Window::Impl *w = (Window::Impl*)userdata;
-  w->calib_.show(eye::window::CalibWidget::Show::points);
+  w->scene_.calib.show(eye::window::CalibWidget::Show::points);
 }
 
 /*static*/ void
 Window::Impl::show_calib_none(Fl_Widget*, void *userdata)
 {
   Window::Impl *w = (Window::Impl*)userdata;
-  w->calib_.show(eye::window::CalibWidget::Show::none);
+  w->scene_.calib.show(eye::window::CalibWidget::Show::none);
 }
 
 
@@ -526,22 +817,16 @@ Window::run()
 void
 Window::clear_targets()
 {
-  window_lock lock();       // Acquire scoped lock
   std::cout << (std::to_string(pimpl->tracker_.gaze_time_ms()) +
                 ",clear_targets\n");
-  pimpl->targets_.clear();  // Clear content of container
-  pimpl->redraw();          // Mark window as needing draw() called
-  Fl::awake();              // Tell main thread to redraw
+  pimpl->set_targets(Targets{});
 }
 
 void
 Window::set(Target const& t)
 {
-  window_lock lock();       // Acquire scoped lock
   std::cout << pimpl->tracker_.gaze_time_ms() << ",target," << t << '\n';
-  pimpl->targets_ = {t};    // Single target in container
-  pimpl->redraw();          // Mark window as needing draw() called
-  Fl::awake();              // Tell main thread to redraw
+  pimpl->set_targets(Targets{t});   // Single target in container
 }
 
 void
@@ -552,70 +837,155 @@ Window::set(Targets const& ts)
     clear_targets();
     return;
   }
-  window_lock lock();   // Acquire scoped lock
+  pimpl->set_targets(Targets(ts));  // Copy handed to main thread
+}
 
-  // Range construct from content of t
-  pimpl->targets_ = window::TargetWidgets(ts.cbegin(), ts.cend());
+void
+Window::set(Targets&& ts)
+{
+  if (ts.empty())
+  {
+    clear_targets();
+    return;
+  }
+  pimpl->set_targets(std::move(ts));
+}
 
-  pimpl->redraw();      // Mark window as needing draw() called
-  Fl::awake();          // Tell main thread to redraw
+void
+Window::reset(std::string const& title)
+{
+  {
+    std::lock_guard<std::mutex> lock(pimpl->targets_mutex_);
+    pimpl->new_title_   = utl::make_unique<std::string>(title);
+    pimpl->new_targets_ = utl::make_unique<Targets>();  // Remove targets
+    pimpl->new_active_.clear();
+  }
+  pimpl->invalidate();      // Redraw at next display refresh
+}
+
+void
+Window::begin_update()
+{
+  ++pimpl->updating_;
+}
+
+void
+Window::end_update()
+{
+  unsigned n = pimpl->updating_.load();
+  while ((n != 0) && !pimpl->updating_.compare_exchange_weak(n, n - 1)) {}
+  if (n == 1)
+  {
+    pimpl->invalidate();    // Apply changes at next display refresh
+  }
+}
+
+void
+Window::set_active(std::size_t index, bool active)
+{
+  {
+    std::lock_guard<std::mutex> lock(pimpl->targets_mutex_);
+    pimpl->new_active_.emplace_back(index, active);
+  }
+  pimpl->frames_.request(); // Redraw damaged target at next refresh
+}
+
+void
+Window::set(window::Contingent const& c)
+{
+  {
+    std::lock_guard<std::mutex> lock(pimpl->contingent_mutex_);
+    pimpl->new_contingent_ = utl::make_unique<window::Contingent>(c);
+  }
+  pimpl->contingent_on_ = static_cast<bool>(c.region);
+  pimpl->frames_.request(); // Applied at next display refresh
+}
+
+void
+Window::clear_contingent()
+{
+  set(window::Contingent{});
 }
 
 //void
 //Window::show_calib(bool val)
 //{
-//  window_lock lock();   // Acquire scoped lock
 //  pimpl->show_calib_ = val;
 //  pimpl->redraw();      // Mark window as needing draw() called
 //  Fl::awake();          // Tell main thread to redraw
 //}
 
+// Applied by the main thread in render(), with any deferred target changes.
 void
 Window::show_avg_gaze(bool val)
 {
-  window_lock lock();   // Acquire scoped lock
-  pimpl->gaze_.show_avg = val;
-  pimpl->redraw();      // Mark window as needing draw() called
-  Fl::awake();          // Tell main thread to redraw
+  pimpl->new_show_avg_ = val ? 1 : 0;
+  pimpl->frames_.request(); // Redraw at next display refresh
 }
 
 void
 Window::show_raw_gaze(bool val)
 {
-  window_lock lock();   // Acquire scoped lock
-  pimpl->gaze_.show_raw = val;
-  pimpl->redraw();      // Mark window as needing draw() called
-  Fl::awake();          // Tell main thread to redraw
+  pimpl->new_show_raw_ = val ? 1 : 0;
+  pimpl->frames_.request(); // Redraw at next display refresh
+}
+
+void
+Window::show_heatmap(bool val)
+{
+  pimpl->new_show_heatmap_ = val ? 1 : 0;
+  pimpl->frames_.request(); // Redraw at next display refresh
+}
+
+// Applied by the tracker thread with the next gaze sample.
+void
+Window::clear_heatmap()
+{
+  pimpl->heatmap_clear_ = true;
 }
 
 //-------------------------------------------------------------
 // Operations
 //-------------------------------------------------------------
 
+window::FrameStats
+Window::frame_stats() const
+{
+  return pimpl->frames_.stats();
+}
+
 void
 Window::redraw() const
 {
-  window_lock lock();   // Acquire scoped lock
-  pimpl->redraw();      // Mark window as needing draw() called
-  Fl::awake();          // Tell main thread to redraw
+  pimpl->invalidate();      // Redraw at next display refresh
 }
 
 void
 Window::register_handler(event_handler callback)
 {
-  window_lock lock();   // Acquire scoped lock
   if (callback)
   {
+    std::lock_guard<std::mutex> lock(pimpl->handlers_mutex_);
     pimpl->event_callback_ = callback;
   }
 }
 
+void
+Window::register_handler(contingent_handler callback)
+{
+  if (callback)
+  {
+    std::lock_guard<std::mutex> lock(pimpl->handlers_mutex_);
+    pimpl->contingent_callback_ = callback;
+  }
+}
+
 void
 Window::register_handler(state_handler callback)
 {
-  window_lock lock();   // Acquire scoped lock
   if (callback)
   {
+    std::lock_guard<std::mutex> lock(pimpl->handlers_mutex_);
     pimpl->state_callback_ = callback;
   }
 }
@@ -31,8 +31,11 @@ SOFTWARE.
 
 #include <eyelib.hpp>
 
+#include "window/contingent.hpp"
 #include "window/event.hpp"
+#include "window/frame_scheduler.hpp"
 
+#include <cstddef>    // std::size_t
 #include <vector>     // std::vector
 #include <string>     // std::string
 #include <ostream>    // std::ostream
@@ -98,6 +101,11 @@ class Tracker;
     };
   win.set(targets);
 
+  // Activate the second target and deactivate the first, redrawing only
+  // those two targets
+  win.set_active(1, true);
+  win.set_active(0, false);
+
   // Remove all targets from the screen
   win.clear_targets();
   ```
@@ -110,6 +118,32 @@ class Tracker;
   win.show_raw_gaze(true);    // Display raw gaze point on the screen
   ```
 
+  A heatmap of smoothed gaze points, decaying with a 10 second half-life,
+  is accumulated while the window runs.  Call `show_heatmap()` to overlay
+  it, or press `3` in the window to toggle it.
+  ```
+  win.show_heatmap(true);     // Display gaze heatmap on the screen
+  ```
+
+### Gaze-Contingent Drawing
+  For gaze-contingent paradigms, a client draw callback can follow the
+  gaze with lower latency than the rest of the window.  Each new sample
+  wakes the UI thread at once, rather than at the next display refresh,
+  and only the region returned for the sample is repainted.  The latency
+  from sample receipt to the frame reaching the screen is reported for
+  every frame.
+  ```
+  eye::window::Contingent c;
+  c.region = eye::window::centered_region(200, 200);  // Moving window
+  c.draw = [](eye::Gaze const& g, eye::window::Rect const& r){
+        fl_rectf(r.x, r.y, r.w, r.h, FL_BLACK);  // FLTK drawing calls
+      };
+  win.set(c);
+  win.register_handler([](eye::window::ContingentFrame const& f){
+        std::cout << f << '\n';
+      });
+  ```
+
 ### Run %Window
   The last step to create a window is to call `run()`.  The window registers
   itself to receive calibration results and streaming gaze data from the
@@ -146,6 +180,10 @@ public:
   /// State change notification handler alias.
   using state_handler = std::function<void(State const&)>;
 
+  /// Gaze-contingent frame handler alias.
+  using contingent_handler =
+    std::function<void(window::ContingentFrame const&)>;
+
   //-----------------------------------------------------------
 
   /// @brief  Construct window.
@@ -170,6 +208,9 @@ public:
   /// Mark window as needing to be redrawn.
   void redraw() const;
 
+  /// Frames rendered and skipped, and UI wakeups per second.
+  window::FrameStats frame_stats() const;
+
   //-----------------------------------------------------------
   /// @name Handler registration
   /// @{
@@ -177,6 +218,9 @@ public:
   void register_handler(event_handler callback);  ///< %Window event handler.
   void register_handler(state_handler callback);  ///< %Window state handler.
 
+  /// Gaze-contingent frame handler.  Invoked by the UI thread.
+  void register_handler(contingent_handler callback);
+
   /// @}
   //-----------------------------------------------------------
   /// @name Set properties
@@ -185,10 +229,45 @@ public:
   void clear_targets();           ///< Remove all targets from screen.
   void set(Target const& t);      ///< %Target to draw on screen.
   void set(Targets const& ts);    ///< %Targets to draw on screen.
+  void set(Targets&& ts);         ///< %Targets to draw on screen.
+
+  /// @brief  Activate or deactivate the target at @a index.
+  ///
+  /// Redraws only that target, so it is inexpensive however many
+  /// targets are on the screen.
+  void set_active(std::size_t index, bool active);
 
   //void show_calib(bool val);      ///< `true` to draw calibration results.
   void show_avg_gaze(bool val);   ///< `true` to draw raw gaze point.
   void show_raw_gaze(bool val);   ///< `true` to draw smoothed gaze point.
+  void show_heatmap(bool val);    ///< `true` to draw gaze heatmap.
+  void clear_heatmap();           ///< Discard accumulated gaze heatmap.
+
+  /// @brief  Replace content and return to the title screen.
+  ///
+  /// Removes all targets and calibration results, and shows @a title.
+  /// The window stays open, so no fullscreen mode switch or change of
+  /// focus occurs.
+  void reset(std::string const& title);
+
+  /// @brief  Defer changes to targets and content until `end_update()`.
+  ///
+  /// Changes made between `begin_update()` and `end_update()` are applied
+  /// together at the next display refresh, so they appear in one frame.
+  /// Calls may be nested.
+  void begin_update();
+
+  void end_update();              ///< Apply deferred changes.
+
+  /// @brief  Draw @a c for each gaze sample as soon as it arrives.
+  ///
+  /// Each sample wakes the UI thread, which takes the freshest sample,
+  /// repaints only the previous and current regions of @a c, and copies
+  /// them to the screen.  Samples arriving while a frame is drawn
+  /// collapse into the next frame.
+  void set(window::Contingent const& c);
+
+  void clear_contingent();        ///< Stop gaze-contingent drawing.
 
   /// @}
   //-----------------------------------------------------------
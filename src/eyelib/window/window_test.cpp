@@ -0,0 +1,369 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+
+#include <eyelib.hpp>
+
+#include "window/rect.hpp"    // eye::window::Rect
+#include "window/scene.hpp"   // eye::window::Scene
+#include "window/target_layer.hpp"  // eye::window::TargetLayer
+#include "window/target_widget.hpp" // eye::window::TargetWidgets
+#include "window/triple_buffer.hpp" // eye::window::TripleBuffer
+#include "debug/benchmark.hpp"  // eye::debug::per_frame
+
+#include <FL/Fl.H>          // FLTK GUI libraries
+#include <FL/fl_draw.H>     // fl_create_offscreen, fl_read_image
+#include <FL/x.H>           // Fl_Offscreen
+
+#include <cmath>      // std::ceil, std::cos, std::sin, std::sqrt
+#include <iomanip>    // std::setw
+#include <iostream>   // std::cout
+#include <random>     // std::mt19937
+#include <thread>     // std::thread
+#include <utility>    // std::pair
+#include <vector>     // std::vector
+
+namespace {   //-------------------------------------------------------------
+
+using eye::debug::elapsed_ms;
+using eye::debug::elapsed_ns;
+using eye::debug::frame_count;
+using eye::debug::per_frame;
+using eye::debug::steady_clock;
+
+struct Result
+{
+  double    full_ms{0.0};       // Mean full redraw time per frame
+  double    damage_ms{0.0};     // Mean damage-region redraw time per frame
+  double    damage_px{0.0};     // Mean damaged pixels per frame
+};
+
+// Wait for the display server to finish drawing
+void
+sync_display()
+{
+  unsigned char px[3];
+  fl_read_image(px, 0, 0, 1, 1);
+}
+
+// Move gaze along a circle about the screen center
+void
+move_gaze(eye::window::Scene& scene, int w, int h, unsigned i)
+{
+  double a = 0.05 * i;
+  eye::Gaze g{};
+  g.avg_px = { static_cast<float>(w/2 + (h/4) * std::cos(a)),
+               static_cast<float>(h/2 + (h/4) * std::sin(a)) };
+  g.raw_px = { g.avg_px.x + static_cast<float>(12 * std::sin(3 * a)),
+               g.avg_px.y + static_cast<float>(12 * std::cos(5 * a)) };
+  g.fixation = (i % 60) < 30;
+  scene.gaze.set(g);
+}
+
+Result
+benchmark(int w, int h)
+{
+  namespace ew = eye::window;
+
+  ew::Scene scene{};
+  scene.background = fl_rgb_color(149, 149, 149);
+  scene.text = ew::TextWidget(w/2, h/3, "Draw Benchmark");
+  eye::Targets targets;
+  for (int row = 1; row <= 3; ++row)
+  {
+    for (int col = 1; col <= 3; ++col)
+    {
+      targets.push_back({ col * w/4, row * h/4, (row == col) });
+    }
+  }
+  scene.targets.set(targets);
+  scene.gaze.show_raw = true;
+  scene.gaze.show_avg = true;
+
+  Result result{};
+  Fl_Offscreen buffer = fl_create_offscreen(w, h);
+  fl_begin_offscreen(buffer);
+
+  // Full redraw of every frame
+  result.full_ms = per_frame(frame_count, [&](unsigned i)
+    {
+      move_gaze(scene, w, h, i);
+      scene.draw(w, h);
+      sync_display();
+    });
+
+  // Redraw of damaged regions only
+  std::vector<ew::Rect> damaged;
+  double pixels = 0.0;
+  result.damage_ms = per_frame(frame_count, [&](unsigned i)
+    {
+      move_gaze(scene, w, h, i);
+      damaged.clear();
+      scene.damage(damaged);
+      for (auto const& r : damaged)
+      {
+        scene.draw(r);
+        pixels += static_cast<double>(r.w) * r.h;
+      }
+      sync_display();
+    });
+  result.damage_px = pixels / frame_count;
+
+  fl_end_offscreen();
+  fl_delete_offscreen(buffer);
+  return result;
+}
+
+//-----------------------------------------------------------
+
+constexpr unsigned  query_count = 100000;   // Hit tests per measurement
+
+struct TargetResult
+{
+  double    set_ms{0.0};        // Time to set targets and build grid
+  double    naive_ms{0.0};      // Mean redraw of every target per frame
+  double    first_ms{0.0};      // First draw, including static layer
+  double    change_ms{0.0};     // Mean redraw of changed targets per frame
+  double    naive_hit_ns{0.0};  // Mean linear search hit test
+  double    hit_ns{0.0};        // Mean grid hit test
+  bool      hits_match{false};  // Both hit tests found the same targets
+};
+
+// Return n targets in a grid filling w by h pixels
+eye::Targets
+target_grid(int w, int h, unsigned n)
+{
+  int cols = static_cast<int>(std::ceil(std::sqrt(double(n) * w / h)));
+  int rows = (static_cast<int>(n) + cols - 1) / cols;
+  eye::Targets targets;
+  for (unsigned i = 0; i != n; ++i)
+  {
+    int col = static_cast<int>(i) % cols;
+    int row = static_cast<int>(i) / cols;
+    targets.push_back({ (2*col + 1) * w / (2*cols),
+                        (2*row + 1) * h / (2*rows), (i == 0) });
+  }
+  return targets;
+}
+
+TargetResult
+benchmark_targets(int w, int h, unsigned n)
+{
+  namespace ew = eye::window;
+
+  TargetResult result{};
+  eye::Targets targets = target_grid(w, h, n);
+  Fl_Color const bg = fl_rgb_color(149, 149, 149);
+  std::mt19937 rng(n);
+
+  Fl_Offscreen buffer = fl_create_offscreen(w, h);
+  fl_begin_offscreen(buffer);
+
+  // Every target drawn every frame
+  ew::TargetWidgets widgets(targets.cbegin(), targets.cend());
+  result.naive_ms = per_frame(frame_count, [&](unsigned)
+    {
+      std::size_t k = rng() % n;
+      widgets[k].active(!widgets[k].active());
+      fl_rectf(0, 0, w, h, bg);
+      ew::draw(widgets);
+      sync_display();
+    });
+
+  // Retained layer: one target activated and one deactivated per frame
+  ew::TargetLayer layer;
+  ew::SpriteCache cache;
+  cache.background(bg);
+  auto start = steady_clock::now();
+  layer.set(targets);
+  result.set_ms = elapsed_ms(start);
+
+  start = steady_clock::now();
+  layer.draw(w, h, bg, cache);
+  sync_display();
+  result.first_ms = elapsed_ms(start);
+
+  std::vector<ew::Rect> damaged;
+  std::size_t active = 0;
+  result.change_ms = per_frame(frame_count, [&](unsigned)
+    {
+      std::size_t k = rng() % n;
+      layer.active(active, false);
+      layer.active(k, true);
+      active = k;
+      damaged.clear();
+      layer.damage(damaged);
+      for (auto const& r : damaged)
+      {
+        fl_push_clip(r.x, r.y, r.w, r.h);
+        layer.draw(r, bg, cache);
+        fl_pop_clip();
+      }
+      sync_display();
+    });
+
+  fl_end_offscreen();
+  fl_delete_offscreen(buffer);
+
+  // Hit tests at random pixels
+  std::vector<std::pair<int,int>> points;
+  for (unsigned i = 0; i != query_count; ++i)
+  {
+    points.emplace_back(static_cast<int>(rng() % w),
+                        static_cast<int>(rng() % h));
+  }
+  std::size_t naive_hits = 0;
+  std::size_t hits = 0;
+  start = steady_clock::now();
+  for (auto const& p : points)
+  {
+    for (auto const& t : widgets)
+    {
+      if (ew::contains(t.bounds(), p.first, p.second))
+      {
+        ++naive_hits;
+        break;
+      }
+    }
+  }
+  result.naive_hit_ns = elapsed_ns(start) / query_count;
+
+  start = steady_clock::now();
+  for (auto const& p : points)
+  {
+    if (layer.find(p.first, p.second) != ew::TargetLayer::npos)
+    {
+      ++hits;
+    }
+  }
+  result.hit_ns = elapsed_ns(start) / query_count;
+  result.hits_match = (hits == naive_hits);
+  return result;
+}
+
+//-----------------------------------------------------------
+
+constexpr unsigned  publish_count = 1000000;  // Values published per test
+
+// Value whose fields must all match if it was handed off intact
+struct Sample
+{
+  unsigned  seq{0};
+  unsigned  fields[15]{};
+};
+
+} // anonymous --------------------------------------------------------------
+
+namespace eye { namespace window { namespace debug {
+
+void
+draw_benchmark()
+{
+  std::cout <<'\n'<< "eyelib: Window draw benchmark ("
+            << frame_count << " frames)" <<'\n'<<'\n';
+  fl_open_display();
+
+  struct Size { char const* name; int w; int h; };
+  Size const sizes[] = {{ "1080p", 1920, 1080 }, { "4K", 3840, 2160 }};
+
+  for (auto const& s : sizes)
+  {
+    Result r = benchmark(s.w, s.h);
+    std::cout << std::setw(6) << s.name
+              << "  full: "    << r.full_ms   << " ms/frame"
+              << "  damaged: " << r.damage_ms << " ms/frame, "
+              << r.damage_px << " of " << (s.w * s.h) << " px" <<'\n';
+  }
+  eye::debug::rule();
+}
+
+void
+target_benchmark()
+{
+  std::cout <<'\n'<< "eyelib: Window target benchmark (1080p, "
+            << frame_count << " frames, " << query_count << " hit tests)"
+            <<'\n'<<'\n';
+  fl_open_display();
+
+  std::cout << "targets     set   first    all/frame    changed/frame"
+            << "    hit: linear    grid" << '\n';
+  for (unsigned n : { 10u, 100u, 1000u, 2000u, 5000u, 10000u })
+  {
+    TargetResult r = benchmark_targets(1920, 1080, n);
+    std::cout << std::setw(7) << n
+              << std::setw(8) << r.set_ms << " ms"
+              << std::setw(8) << r.first_ms << " ms"
+              << std::setw(10) << r.naive_ms << " ms"
+              << std::setw(14) << r.change_ms << " ms"
+              << std::setw(12) << r.naive_hit_ns << " ns"
+              << std::setw(8) << r.hit_ns << " ns"
+              << (r.hits_match ? "" : "  FAIL") << '\n';
+  }
+  eye::debug::rule();
+}
+
+void
+triple_buffer_test()
+{
+  std::cout <<'\n'<< "eyelib: Triple buffer handoff ("
+            << publish_count << " values)" <<'\n'<<'\n';
+
+  TripleBuffer<Sample> buffer;
+
+  std::thread producer([&buffer]()
+    {
+      for (unsigned i = 1; i <= publish_count; ++i)
+      {
+        Sample& s = buffer.back();
+        s.seq = i;
+        for (auto& f : s.fields) { f = i; }
+        buffer.publish();
+      }
+    });
+
+  // Consume until the last value is seen; every value must be complete
+  // and newer than the one before
+  unsigned last = 0;
+  unsigned received = 0;
+  unsigned errors = 0;
+  while (last != publish_count)
+  {
+    if (buffer.update())
+    {
+      Sample const& s = buffer.front();
+      for (auto f : s.fields) { if (f != s.seq) { ++errors; } }
+      if (s.seq <= last) { ++errors; }
+      last = s.seq;
+      ++received;
+    }
+  }
+  producer.join();
+
+  std::cout << "received " << received << ", errors " << errors <<'\n';
+  eye::debug::verdict("Complete values in order", errors == 0);
+  eye::debug::rule();
+}
+
+} } } // eye::window::debug
+//===========================================================================//
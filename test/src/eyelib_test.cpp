@@ -23,12 +23,14 @@ SOFTWARE.
 */
 //===========================================================================//
 
-#include "test_fixation.hpp"    // eye::test::fixation
+#include "test_fixation.hpp"    // eye::test::fixation, fixation_sweep, ...
 #include "test_gaze.hpp"        // eye::test::gaze_handler
+#include "test_heatmap.hpp"     // eye::test::heatmap
 #include "test_message.hpp"     // eye::test::message
-#include "test_metrics.hpp"     // eye::test::metrics
+#include "test_metrics.hpp"     // eye::test::metrics, metrics_benchmark, ...
 #include "test_screen.hpp"      // eye::test::screen
 #include "test_tracker.hpp"     // eye::test::tracker
+#include "test_window.hpp"      // eye::test::window_draw, window_targets
 
 #include <eyelib.hpp>   // eye::tracker::message::debug::TestMessage
 
@@ -52,9 +54,19 @@ print_usage(std::string const& name)
     << "\n    test:"
     << '\n'
     << "\n      -e    eye gaze metrics"
+    << "\n      -e:b  eye gaze event classifier benchmark"
+    << "\n      -e:q  eye gaze metrics quantile benchmark"
+    << "\n      -e:w  eye gaze metrics window benchmark"
     << "\n      -f    fixation algorithms"
+    << "\n      -f:a  fixation areas of interest benchmark"
+    << "\n      -f:p  fixation algorithms, then parameter sweep"
+    << "\n      -f:r  fixation point ring benchmark"
+    << "\n      -f:s  fixation parameter sweep benchmark"
+    << "\n      -f:v  fixation visual angle benchmark"
+    << "\n      -f:w  fixation point window benchmark"
     << '\n'
     << "\n      -g:f  gaze data function handler"
+    << "\n      -g:h  gaze heatmap"
     << "\n      -g:l  gaze data lambda handler"
     << "\n      -g:m  gaze data member handler"
     << '\n'
@@ -63,6 +75,7 @@ print_usage(std::string const& name)
     << "\n      -m:o    ostream string"
     << "\n      -m:p    predefined"
     << "\n      -m:r    requests"
+    << "\n      -m:s    serialized requests"
     << '\n'
     << "\n      -s    screen data structure and list"
     << "\n      -s:c    color"
@@ -71,6 +84,10 @@ print_usage(std::string const& name)
     << "\n      -s:td   target duration"
     << '\n'
     << "\n      -t    tracker"
+    << "\n      -w:b  window triple buffer"
+    << "\n      -w:d  window draw benchmark"
+    << "\n      -w:h  window headless benchmark"
+    << "\n      -w:t  window target benchmark"
     << "\n      -x    code snippet"
     << '\n'
     << "\n    option:"
@@ -117,9 +134,19 @@ eyelib_test(std::string const& arg, unsigned scr)
   using TestMessage = eye::tracker::message::debug::TestMessage;
 
        if (arg == "-e")     { metrics(scr); }
+  else if (arg == "-e:b")   { metrics_benchmark(); }
+  else if (arg == "-e:q")   { metrics_quantile(); }
+  else if (arg == "-e:w")   { metrics_window(); }
   else if (arg == "-f")     { fixation(scr); }
+  else if (arg == "-f:a")   { fixation_aoi(); }
+  else if (arg == "-f:p")   { fixation(scr, true); }
+  else if (arg == "-f:r")   { fixation_ring(); }
+  else if (arg == "-f:s")   { fixation_sweep(); }
+  else if (arg == "-f:v")   { fixation_angle(); }
+  else if (arg == "-f:w")   { fixation_window(); }
 
   else if (arg == "-g:f")   { gaze_handler(scr, Handler::function); }
+  else if (arg == "-g:h")   { heatmap(); }
   else if (arg == "-g:l")   { gaze_handler(scr, Handler::lambda); }
   else if (arg == "-g:m")   { gaze_handler(scr, Handler::member); }
 
@@ -128,6 +155,7 @@ eyelib_test(std::string const& arg, unsigned scr)
   else if (arg == "-m:o")   { message(TestMessage::ostream_string); }
   else if (arg == "-m:p")   { message(TestMessage::predefined); }
   else if (arg == "-m:r")   { message(TestMessage::requests); }
+  else if (arg == "-m:s")   { message(TestMessage::serialized); }
 
   else if (arg == "-s")     { screen(scr, Screen::screen); }
   else if (arg == "-s:c")   { screen(scr, Screen::color); }
@@ -136,6 +164,10 @@ eyelib_test(std::string const& arg, unsigned scr)
   else if (arg == "-s:td")  { screen(scr, Screen::target_duration); }
 
   else if (arg == "-t")     { tracker(scr); }
+  else if (arg == "-w:b")   { window_handoff(); }
+  else if (arg == "-w:d")   { window_draw(); }
+  else if (arg == "-w:h")   { window_headless(); }
+  else if (arg == "-w:t")   { window_targets(); }
   else if (arg == "-x")     { code_snippet(); }
   else
   {
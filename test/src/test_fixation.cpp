@@ -66,7 +66,7 @@ fixation_error(eye::Target const& target, eye::PointXY<float> const& gaze)
 
 void
 write_fixations(utl::file::file_writer& log_file,
-                std::vector<eye::Fixation> const& fixations,
+                eye::AreasOfInterest const& areas,
                 std::string const& fixation_method)
 {
   // csv_writer accumulates values in comma separated value (CSV)
@@ -88,18 +88,17 @@ write_fixations(utl::file::file_writer& log_file,
           << "interval (ms)"            // [T]
     <<'\n';
 
-  unsigned t = 0;
-  for (auto const& f : fixations)
+  for (std::size_t t = 0; t != areas.size(); ++t)
   {
     utl::file::csv_writer(log_file)
-      << ""<<""                 // [A-B]
-      << t++ << f.x() << f.y()  // [C-E]  target
-      << ",,,,,,,,,,"           // [F-P]
-      << f.count()              // [Q]    count of fixations on target
-      << f.duration()           // [R]    sum duration of fixations on target
-      <<(f.count() ?            // [S]    avg duration of fixations on target
-         std::to_string(f.duration() / f.count()) : "")
-      << f.interval()           // [T]    time interval between fixations
+      << ""<<""                       // [A-B]
+      << t << areas.x(t) << areas.y(t)  // [C-E]  target
+      << ",,,,,,,,,,"                 // [F-P]
+      << areas.count(t)               // [Q]    count of fixations on target
+      << areas.duration(t)            // [R]    sum duration of fixations
+      <<(areas.count(t) ?             // [S]    avg duration of fixations
+         std::to_string(areas.duration(t) / areas.count(t)) : "")
+      << areas.interval(t)            // [T]    time interval between fixations
       <<'\n';
   }
   utl::file::csv_writer(log_file) << '\n';  // blank line
@@ -110,9 +109,17 @@ write_fixations(utl::file::file_writer& log_file,
 
 namespace eye { namespace test {
 
-FixationTest::FixationTest(eye::Targets const& targets,
+FixationTest::FixationTest(eye::Screen const& scr,
+                           eye::Targets const& targets,
                            std::string const& datetime_basic,
-                           std::string const& datetime_extended)
+                           std::string const& datetime_extended,
+                           bool sweep)
+: et_areas_(scr.w_px, scr.h_px)
+, dt_areas_(scr.w_px, scr.h_px)
+, td_areas_(scr.w_px, scr.h_px)
+, vt_areas_(scr.w_px, scr.h_px)
+, record_(sweep)
+, sweep_(targets, RADIUS)
 {
   data_log_.open("log/" + datetime_basic + "-fixation.csv");
 
@@ -170,22 +177,47 @@ FixationTest::FixationTest(eye::Targets const& targets,
 
   for (auto const& t : targets)
   {
-    et_fixations_.push_back(56);
-    et_fixations_.back().position(t.x_px, t.y_px);
-
-    dt_fixations_.push_back(56);
-    dt_fixations_.back().position(t.x_px, t.y_px);
-
-    vt_fixations_.push_back(56);
-    vt_fixations_.back().position(t.x_px, t.y_px);
+    et_areas_.circle(t.x_px, t.y_px, RADIUS);
+    dt_areas_.circle(t.x_px, t.y_px, RADIUS);
+    td_areas_.circle(t.x_px, t.y_px, RADIUS);
+    vt_areas_.circle(t.x_px, t.y_px, RADIUS);
   }
 }
 
 FixationTest::~FixationTest()
 {
-  write_fixations(data_log_, et_fixations_, "ET");
-  write_fixations(data_log_, dt_fixations_, "DT");
-  write_fixations(data_log_, vt_fixations_, "VT");
+  write_fixations(data_log_, et_areas_, "ET");
+  write_fixations(data_log_, dt_areas_, "DT");
+  write_fixations(data_log_, td_areas_, "DT (time)");
+  write_fixations(data_log_, vt_areas_, "VT");
+  if (!record_) { return; }
+
+  // Sweep DT and VT parameters around those used above
+  sweep_.dispersion({DTN - 1, DTN, DTN + 2, DTN + 4},
+                    {DTD - 10, DTD, DTD + 15});
+  sweep_.velocity({VTD - 2, VTD, VTD + 3});
+  auto results = sweep_.run();
+  std::cout <<'\n'<< "fixation parameter sweep:" <<'\n'<< results <<'\n';
+
+  utl::file::csv_writer(data_log_)
+    <<'\n'<< "fixation parameter sweep"
+    <<'\n'<< "method,points,dmax"             // configuration
+          << "agreement,fixations"            // with eye tracker flag
+          << "average duration (ms)"
+          << "per target: count of fixations,sum duration (ms),interval (ms)"
+    <<'\n';
+  for (auto const& r : results)
+  {
+    bool dt = (r.config.method == eye::FixationSweep::Method::dt);
+    utl::file::csv_writer csv(data_log_);
+    csv << (dt ? "DT" : "VT") << (dt ? std::to_string(r.config.pts) : "")
+        << r.config.dmax << r.agreement << r.fixations << r.duration_ms;
+    for (auto const& t : r.targets)
+    {
+      csv << t.count << t.duration_ms << t.interval_ms;
+    }
+    csv << '\n';
+  }
 }
 
 void
@@ -195,13 +227,17 @@ FixationTest::on_gaze(eye::Gaze const& gz, bool ts, eye::Target const& tg)
   // Count of null gaze point coordinate data?  Use for blink duration threshold?
   //###############################################################################
 
+  if (record_) { sweep_.add(gz, tg); }
+
   bool dt_fixation = false;
+  bool td_fixation = false;
   bool vt_fixation = false;
 
   // Reject gaze point (0, 0) as potential blink
   if ((gz.avg_px.x != 0) && (gz.avg_px.y != 0))
   {
     dt_fixation = dt_.fixation(gz.avg_px.x, gz.avg_px.y);
+    td_fixation = td_.fixation(gz.time_ms, gz.avg_px.x, gz.avg_px.y);
     vt_fixation = vt_.fixation(gz.avg_px.x, gz.avg_px.y);
   }
 
@@ -229,35 +265,24 @@ FixationTest::on_gaze(eye::Gaze const& gz, bool ts, eye::Target const& tg)
   // If target is active
   if (tg.active)
   {
-    //for (std::size_t i = 0; i != fixations_.size(); ++i)
-    std::size_t i = 0;
-    for (auto& f : et_fixations_)
-    {
-      f.gaze(gz.time_ms, gz.avg_px, gz.fixation);
-
-      // If target is fixated
-      if (f.is_fixated())
-      {
-        utl::file::csv_writer(data_log_)
-          //<<(tg.active ? std::to_string(target_error) : "")
-          << i                                // Target ID
-          << fixation_error(tg, gz.avg_px)    // Target error
-          << f.count()      // Count of fixations on target object
-          << f.duration()   // Sum total duration of fixations on target object
-          <<(f.count() ? std::to_string(f.duration() / f.count()) : "") // Avg
-          << f.interval()   // Time duration between fixations on target
-          << ""; // Keep log line open
-      }
-      ++i;
-    }
-    for (auto& f : dt_fixations_)
-    {
-      f.gaze(gz.time_ms, gz.avg_px, dt_fixation);
-    }
-    for (auto& f : vt_fixations_)
+    et_areas_.gaze(gz.time_ms, gz.avg_px, gz.fixation);
+
+    // Fixated targets
+    for (auto i : et_areas_.fixated())
     {
-      f.gaze(gz.time_ms, gz.avg_px, vt_fixation);
+      utl::file::csv_writer(data_log_)
+        << i                                // Target ID
+        << fixation_error(tg, gz.avg_px)    // Target error
+        << et_areas_.count(i)     // Count of fixations on target object
+        << et_areas_.duration(i)  // Sum total duration of fixations on target
+        <<(et_areas_.count(i) ?   // Average duration
+           std::to_string(et_areas_.duration(i) / et_areas_.count(i)) : "")
+        << et_areas_.interval(i)  // Time duration between fixations on target
+        << ""; // Keep log line open
     }
+    dt_areas_.gaze(gz.time_ms, gz.avg_px, dt_fixation);
+    td_areas_.gaze(gz.time_ms, gz.avg_px, td_fixation);
+    vt_areas_.gaze(gz.time_ms, gz.avg_px, vt_fixation);
   }
 
   utl::file::csv_writer(data_log_) << '\n';  // End line
@@ -266,7 +291,7 @@ FixationTest::on_gaze(eye::Gaze const& gz, bool ts, eye::Target const& tg)
 //---------------------------------------------------------------------------
 
 void
-fixation(unsigned screen_index)
+fixation(unsigned screen_index, bool sweep)
 {
   std::cout <<'\n'<< "eyelib: Test fixation algorithms" <<'\n';
 
@@ -288,7 +313,8 @@ fixation(unsigned screen_index)
   auto targets  = eye::target_array(scr, 3, 3);
 
   // Create object to process gaze data
-  eye::test::FixationTest fixation_test(targets, time_basic, time_extended);
+  eye::test::FixationTest fixation_test(scr, targets, time_basic,
+                                       time_extended, sweep);
 
   //-----------------------------------------------------------
   try
@@ -323,5 +349,37 @@ fixation(unsigned screen_index)
   //-----------------------------------------------------------
 }
 
+//---------------------------------------------------------------------------
+
+void
+fixation_sweep()
+{
+  eye::gaze::debug::sweep_benchmark();
+}
+
+void
+fixation_window()
+{
+  eye::gaze::debug::dispersion_benchmark();
+}
+
+void
+fixation_ring()
+{
+  eye::gaze::debug::ring_benchmark();
+}
+
+void
+fixation_aoi()
+{
+  eye::gaze::debug::aoi_benchmark();
+}
+
+void
+fixation_angle()
+{
+  eye::gaze::debug::angle_benchmark();
+}
+
 } } // eye::test
 //===========================================================================//
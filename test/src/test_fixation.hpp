@@ -43,10 +43,12 @@ namespace eye { namespace test {
 class FixationTest
 {
 public:
-  /// Constructor.
-  FixationTest(eye::Targets const& targets,
+  /// Constructor.  If @a sweep, the session is recorded, and DT and VT
+  /// parameters are swept over it on destruction.
+  FixationTest(eye::Screen const& scr, eye::Targets const& targets,
                std::string const& datetime_basic,
-               std::string const& datetime_extended);
+               std::string const& datetime_extended,
+               bool sweep = false);
 
   /// Destructor.
   ~FixationTest();
@@ -61,26 +63,54 @@ private:
   static constexpr unsigned DTN = 4;      // Number of points in moving window
   static constexpr float    DTD = 30.0;   // Maximum dispersion in pixels
                                           // of fixation points
+  static constexpr unsigned DTT = 50;     // Minimum duration in milliseconds
+                                          // (DTN points at 60 Hz)
   // Velocity threshold parameter
   static constexpr float    VTD = 7.0;    // Maximum displacement in pixels
                                           // between fixation points
   // Fixation detection algorithms
   eye::DispersionThreshold  dt_{DTN, DTD};  // Dispersion threshold
+  eye::TimedDispersionThreshold td_{DTT, DTD};  // Timed dispersion threshold
   eye::VelocityThreshold    vt_{VTD};       // Velocity threshold
 
   // Fixation metrics
   static constexpr int        RADIUS = 56;
-//  std::vector<eye::Fixation>  fixations_; // Fixation on objects of interest
-  std::vector<eye::Fixation>  et_fixations_; // Fixation on objects of interest
-  std::vector<eye::Fixation>  dt_fixations_; // Fixation on objects of interest
-  std::vector<eye::Fixation>  vt_fixations_; // Fixation on objects of interest
+  eye::AreasOfInterest        et_areas_;  // Fixation on objects of interest
+  eye::AreasOfInterest        dt_areas_;
+  eye::AreasOfInterest        td_areas_;
+  eye::AreasOfInterest        vt_areas_;
+
+  // Recorded session, for DT and VT parameter sweep if enabled
+  bool                        record_;
+  eye::FixationSweep          sweep_;
 };
 
 //-----------------------------------------------------------
 
-/// Test fixation detection algorithms.
+/// Test fixation detection algorithms, then sweep their parameters over
+/// the session if @a sweep.
 void
-fixation(unsigned screen_index);
+fixation(unsigned screen_index, bool sweep = false);
+
+/// Benchmark fixation detection parameter sweep.
+void
+fixation_sweep();
+
+/// Benchmark dispersion threshold point window.
+void
+fixation_window();
+
+/// Benchmark point ring buffer.
+void
+fixation_ring();
+
+/// Benchmark areas of interest.
+void
+fixation_aoi();
+
+/// Benchmark visual angle conversion.
+void
+fixation_angle();
 
 /// @}
 //---------------------------------------------------------------------------
@@ -35,8 +35,25 @@ SOFTWARE.
 #include <chrono>     // std::chrono::steady_clock
 #include <iostream>   // std::cout
 #include <exception>  // std::exception
+#include <string>     // std::string
 
 namespace {   //-------------------------------------------------------------
+
+// Write a row of session quantiles to the log, and print it
+void
+write_quantiles(utl::file::file_writer& log_file,
+                std::string const& name,
+                eye::QuantileSketch const& q)
+{
+  utl::file::csv_writer(log_file)
+    << name << q.count() << q.min() << q.median() << q.quantile(0.9)
+    << q.quantile(0.99) << q.max() <<'\n';
+
+  std::cout << name << ": " << q.count() << " values, median "
+            << q.median() << ", p90 " << q.quantile(0.9) << ", p99 "
+            << q.quantile(0.99) << '\n';
+}
+
 } // anonymous --------------------------------------------------------------
 
 namespace eye { namespace test {
@@ -74,54 +91,98 @@ GazeMetrics::GazeMetrics()
 
     // Row 4-6:  Data header
     // Eye property type header
-    <<'\n'<<  ",blink,,,,,,"            // detection, duration, and interval
-          <<  "target,,,"               // gaze target point
-          <<  "fixation,,,,,,,,,,,,,,"  // detection, duration, and interval
+    <<'\n'<<  ",blink,,,,,,"              // detection, duration, and interval
+          <<  "target,,,"                 // gaze target point
+          <<  "fixation,,,,,,,,,,,,,,,,"  // detection, duration, and interval
           <<  "saccade,,"               // distance squared
-          <<  "pupillometry"            // pupil size
+          <<  "pupillometry,,,,"        // pupil size
+          <<  "rolling"                 // 1 s, 10 s, 60 s, 10 min windows
     // Eye property header
     <<'\n'<< ",flag"                        // blink flag
           << "duration,," << "interval,,"   // blink metrics
           << "sequence" << "point,,"        // target
-          << "flag" << "detection,,,,,,,"   // fixation detection
+          << "flag" << "detection,,,,,,,,," // fixation detection
           << "duration,," << "interval,,"   // fixation metrics
           << "distance_sq,,"                // saccade
-          << "pupil_size," << "metrics"     // pupillometry
+          << "pupil_size," << "metrics,,"   // pupillometry
+          << "blink_rate,,,"                // rolling windows
+          << "fixation_duration,,,"
+          << "pupil_size,,,"
     // Data value header
     <<'\n'<< "time_ms"              // timestamp in milliseconds
-          << "eyes_closed"          // blink flag (true or false)
+          << "blink"                // blink flag (true or false)
           << "mean,max,sum"         // blink duration
           << "mean,max,sum"         // blink interval
           << "started,x,y,active"   // target
           << "fixation"             // fixation flag (true or false)
-          << "raw_x,raw_y,dt,vt"    // fixation detection, raw gaze point
-          << "avg_x,avg_y,dt,vt"    // fixation detection, smoothed gaze point
+          << "raw_x,raw_y,dt,vt,event"  // event detection, raw gaze point
+          << "avg_x,avg_y,dt,vt,event"  // event detection, smoothed gaze point
           << "mean,max,sum"         // fixation duration
           << "mean,max,sum"         // fixation interval
           << "mean,max,sum"         // saccade distance squared
           << "left_pupil_size"      // pupil size <float>
           << "right_pupil_size"     // pupil size <float>
           << "mean,max,sum"         // pupil size metrics
+          << "1s,10s,60s,10min"     // blink rate (blinks/min)
+          << "1s,10s,60s,10min"     // fixation duration mean (ms)
+          << "1s,10s,60s,10min"     // pupil size mean
     <<'\n';
 }
 
+GazeMetrics::~GazeMetrics()
+{
+  // Session distributions, over all events
+  utl::file::csv_writer(log_file_)
+    <<'\n'<< "session" << "count" << "min" << "p50" << "p90" << "p99"
+          << "max" <<'\n';
+
+  std::cout <<'\n'<< "session metrics:" <<'\n';
+  write_quantiles(log_file_, "blink duration (ms)",
+                  blink.duration_quantiles());
+  write_quantiles(log_file_, "blink interval (ms)",
+                  blink.interval_quantiles());
+  write_quantiles(log_file_, "fixation duration (ms)",
+                  fixation.duration_quantiles());
+  write_quantiles(log_file_, "fixation interval (ms)",
+                  fixation.interval_quantiles());
+  write_quantiles(log_file_, "saccade amplitude (px)",
+                  saccade.amplitude_quantiles());
+  write_quantiles(log_file_, "pupil size",
+                  pupil.pupil_size_quantiles());
+}
+
 void
 GazeMetrics::on_gaze(eye::Gaze const& gz, bool ts, eye::Target const& tg)
 {
-  bool eyes_closed = !gz.tracking.eyes;             // Not tracking both eyes
-  //bool eyes_closed = (gz.tracking.bits == 0x04);  // Tracking face or an eye
+  // Classify the raw and smoothed gaze points once per sample; metrics
+  // follow the events of the smoothed point
+  events.update(gz);
+  auto const& raw = events.sample(eye::EventClassifier::raw);
+  auto const& avg = events.sample(eye::EventClassifier::avg);
+  bool const blinked = (avg.event == eye::GazeEvent::blink);
+  bool const tracked = (avg.event == eye::GazeEvent::fixation)
+                    || (avg.event == eye::GazeEvent::saccade);
+
+  blink.update(gz.time_ms, blinked);
+  fixation.update(gz.time_ms, avg.event == eye::GazeEvent::fixation);
+  saccade.update(gz.avg_px, avg.event == eye::GazeEvent::saccade);
+  if (tracked)    // Pupil sizes are not measured during blinks and gaps
+  {
+    pupil.update(gz.time_ms, gz.pupil_left.size, gz.pupil_right.size);
+  }
 
-  blink.update(gz.time_ms, eyes_closed);
-  fixation.update(gz.time_ms, gz.fixation);
-  saccade.update(gz.avg_px, !gz.fixation);
-  pupil.update(gz.pupil_left.size, gz.pupil_right.size);
+  // 1 s, 10 s, 60 s and 10 min windows
+  using Window = eye::RollingStats::Window;
+  auto const& blink_r     = blink.duration_rolling();
+  auto const& fixation_r  = fixation.duration_rolling();
+  auto const& pupil_r     = pupil.pupil_size_rolling();
 
   // csv_writer accumulates values in comma separated value (CSV)
   // format and writes all values to log_file_ upon destruction
   utl::file::csv_writer(log_file_)
     << gz.time_ms                       // timestamp in milliseconds (ms)
 
-    << (eyes_closed ? "true":"false")   // possible blink
+    << (blinked ? "true":"false")       // blink
     << blink.duration().mean()          // blink duration (ms)
     << blink.duration().max()
     << blink.duration().sum()
@@ -132,13 +193,15 @@ GazeMetrics::on_gaze(eye::Gaze const& gz, bool ts, eye::Target const& tg)
     << (ts ? "true":"false")                                // target sequence
     << tg.x_px << tg.y_px << (tg.active ? "true":"false")   // target point
 
-    <<(gz.fixation ? "true":"false")                           // fixation flag
-    << gz.raw_px.x << gz.raw_px.y                              // raw gaze
-    <<(dt.fixation(gz.raw_px.x, gz.raw_px.y) ? "true":"false") // DT algorithm
-    <<(vt.fixation(gz.raw_px.x, gz.raw_px.y) ? "true":"false") // VT algorithm
-    << gz.avg_px.x << gz.avg_px.y                              // smoothed gaze
-    <<(dt.fixation(gz.avg_px.x, gz.avg_px.y) ? "true":"false") // DT algorithm
-    <<(vt.fixation(gz.avg_px.x, gz.avg_px.y) ? "true":"false") // VT algorithm
+    << (gz.fixation ? "true":"false")   // fixation flag
+    << gz.raw_px.x << gz.raw_px.y       // raw gaze
+    << (raw.dt ? "true":"false")        // DT algorithm
+    << (raw.vt ? "true":"false")        // VT algorithm
+    << to_string(raw.event)             // event
+    << gz.avg_px.x << gz.avg_px.y       // smoothed gaze
+    << (avg.dt ? "true":"false")        // DT algorithm
+    << (avg.vt ? "true":"false")        // VT algorithm
+    << to_string(avg.event)             // event
 
     << fixation.duration().mean()       // fixation duration (ms)
     << fixation.duration().max()
@@ -156,6 +219,19 @@ GazeMetrics::on_gaze(eye::Gaze const& gz, bool ts, eye::Target const& tg)
     << pupil.pupil_size().mean()        // pupil size metrics
     << pupil.pupil_size().max()
     << pupil.pupil_size().sum()
+
+    << blink_r.stats(Window::s1).rate()         // blink rate (blinks/min)
+    << blink_r.stats(Window::s10).rate()
+    << blink_r.stats(Window::s60).rate()
+    << blink_r.stats(Window::min10).rate()
+    << fixation_r.stats(Window::s1).mean()      // fixation duration (ms)
+    << fixation_r.stats(Window::s10).mean()
+    << fixation_r.stats(Window::s60).mean()
+    << fixation_r.stats(Window::min10).mean()
+    << pupil_r.stats(Window::s1).mean()         // pupil size
+    << pupil_r.stats(Window::s10).mean()
+    << pupil_r.stats(Window::s60).mean()
+    << pupil_r.stats(Window::min10).mean()
     <<'\n';
 }
 
@@ -190,5 +266,25 @@ metrics(unsigned screen_index)
   }
 }
 
+//----------------------------------------------------------------------------
+
+void
+metrics_benchmark()
+{
+  eye::gaze::debug::classifier_benchmark();
+}
+
+void
+metrics_window()
+{
+  eye::gaze::debug::window_benchmark();
+}
+
+void
+metrics_quantile()
+{
+  eye::gaze::debug::quantile_benchmark();
+}
+
 } } // eye::test
 //===========================================================================//
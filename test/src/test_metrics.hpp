@@ -44,6 +44,9 @@ public:
   /// Constructor.
   GazeMetrics();
 
+  /// Destructor.
+  ~GazeMetrics();
+
   /// Process eye gaze data.
   void on_gaze(eye::Gaze const& gz, bool ts, eye::Target const& tg);
 
@@ -57,9 +60,8 @@ private:
   // Velocity threshold parameter
   static constexpr float    VTD = 10.0;   // Max displacement between points
 
-  // Fixation detection algorithms
-  eye::DispersionThreshold  dt{DTN, DTD};
-  eye::VelocityThreshold    vt{VTD};
+  // Fixation, saccade, blink and gap detection, raw and smoothed
+  eye::EventClassifier      events{DTN, DTD, VTD};
 
   /*
     Anticipated average blink rate between 4.5 and 32.5 blinks/min  (??)
@@ -81,6 +83,18 @@ private:
 void
 metrics(unsigned screen_index);
 
+/// Benchmark gaze event classification.
+void
+metrics_benchmark();
+
+/// Benchmark gaze metrics moving window statistics.
+void
+metrics_window();
+
+/// Benchmark gaze metrics quantile sketch.
+void
+metrics_quantile();
+
 /// @}
 //---------------------------------------------------------------------------
 } } // eye::test
@@ -30,6 +30,7 @@ SOFTWARE.
 
 #include <utl/app.hpp>      // utl::app::key_wait()
 
+#include <atomic>     // std::atomic
 #include <chrono>     // std::chrono::milliseconds
 #include <thread>     // std::thread
 #include <exception>  // std::exception
@@ -51,8 +52,13 @@ app_instruct()
   std::cout << eye::test::line
     << '\n' << "Eyelib"
     << '\n' << "Press 'c' to open calibration window."
+    << '\n' << "Press 'a' to calibrate with adaptive point durations."
+    << '\n' << "Press 'r' to recalibrate only poor points."
+    << '\n' << "Press 'v' to open validation window."
     << '\n' << "Press 'g' to open gaze point window."
     << '\n' << "Press 't' to open target sequence window."
+    << '\n' << "Press 's' to open a session window.  While it is open,"
+    << '\n' << "  'c', 'g', 't' and 'v' switch its mode instead."
     << '\n' << "Press Esc to exit."
     << '\n' << eye::test::line << '\n';
 }
@@ -95,13 +101,25 @@ tracker(unsigned screen_index)
   {
     eye::Tracker tracker("127.0.0.1", "6555", scr);
     //tracker.register_handler(tracker_gaze);
+    if (tracker.participant("test"))    // Stored in working directory
+    {
+      std::cout << "loaded stored calibration" << '\n';
+    }
     std::cout << "start..." << '\n';
     tracker.start();
 
     std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    std::cout << (tracker.calibration_stored()
+                  ? "stored calibration in use: validation suffices"
+                  : "calibration required") << '\n'
+              << tracker.store_timing() << '\n';
     app_instruct();
 
-    std::thread loop_thread([&tracker, points, durations_ms]{
+    using Mode = eye::Tracker::Mode;
+    std::thread session_thread;
+    std::atomic<bool> session_done{false};  // true once the session closes
+    std::thread loop_thread([&tracker, &session_thread, &session_done,
+                             points, durations_ms]{
         int key = 0;
         while (key != 27)   // Loop until Esc key
         {
@@ -109,13 +127,54 @@ tracker(unsigned screen_index)
           switch (static_cast<char>(key))
           {
             case 'c':   // Calibrate
+              if (!tracker.set_mode(Mode::calibration, points, durations_ms))
+              {
+                tracker.calibrate(points, durations_ms);
+              }
+              break;
+            case 'a':   // Calibrate, ending points once gaze is stable
+              tracker.adaptive_calibration({400, 1000, 300, 40.f});
               tracker.calibrate(points, durations_ms);
+              tracker.adaptive_calibration({0, 0, 0, 0.f});
+              std::cout << tracker.calibration_timing() << '\n';
+              break;
+            case 'r':   // Recalibrate poor points
+              if (!tracker.recalibrate(durations_ms))
+              {
+                std::cout << "no points need recalibration" << '\n';
+              }
+              break;
+            case 'v':   // Validation window
+              if (!tracker.set_mode(Mode::validation, points, durations_ms))
+              {
+                tracker.validate(points, durations_ms);   // Prints results
+              }
               break;
             case 'g':   // Gaze window
-              tracker.window();
+              if (!tracker.set_mode(Mode::free_view))
+              {
+                tracker.window();
+              }
               break;
             case 't':   // Target window
-              tracker.window(points, durations_ms);
+              if (!tracker.set_mode(Mode::targets, points, durations_ms))
+              {
+                tracker.window(points, durations_ms);
+              }
+              break;
+            case 's':   // Session window, in its own thread
+              if (session_thread.joinable() && session_done)
+              {
+                session_thread.join();    // Reap the closed session
+              }
+              if (!session_thread.joinable())
+              {
+                session_done = false;
+                session_thread = std::thread([&tracker, &session_done]{
+                    tracker.session();
+                    session_done = true;
+                  });
+              }
               break;
             default:
               break;
@@ -123,6 +182,11 @@ tracker(unsigned screen_index)
         }
       });
     loop_thread.join();   // Block until thread finishes
+    if (session_thread.joinable())
+    {
+      std::cout << "close session window..." << '\n';
+      session_thread.join();
+    }
 
     std::cout << "exit" << std::endl;
   }
@@ -0,0 +1,58 @@
+//===========================================================================//
+/*  MIT License
+
+Copyright (c) 2019 Nathan Lucas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+//===========================================================================//
+/// @file
+/// @brief    Test eye tracker window.
+/// @author   Nathan Lucas
+//===========================================================================//
+#ifndef EYELIB_TEST_WINDOW_HPP
+#define EYELIB_TEST_WINDOW_HPP
+
+namespace eye { namespace test {
+//---------------------------------------------------------------------------
+/// @addtogroup eyelib_test
+/// @{
+
+/// Benchmark window drawing.
+void
+window_draw();
+
+/// Test window state handoff between threads.
+void
+window_handoff();
+
+/// Benchmark drawing and hit-testing of many targets.
+void
+window_targets();
+
+/// Benchmark drawing into memory without a display.
+void
+window_headless();
+
+/// @}
+//---------------------------------------------------------------------------
+} } // eye::test
+
+#endif // EYELIB_TEST_WINDOW_HPP
+//===========================================================================//